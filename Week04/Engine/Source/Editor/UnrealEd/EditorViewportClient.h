@@ -91,6 +91,9 @@ struct Frustum
 {
     Plane planes[6]; //좌우 상하 near far
 
+    /** 평면과의 거리가 이 값보다 작으면 바깥으로 판정 */
+    static constexpr float CullMargin = 0.2f;
+
     void CreatePlane(FViewportCameraTransform& camera, float fov, float nearZ, float farZ, float aspectRatio);
 
     void CreatePlaneWithMatrix(const FMatrix& ViewProjection);
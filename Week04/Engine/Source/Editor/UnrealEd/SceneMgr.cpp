@@ -74,12 +74,9 @@ SceneData FSceneMgr::ParseSceneData(const FString& jsonStr)
             if (value.contains("ObjStaticMeshAsset"))
             {
                 FString MeshPath = value["ObjStaticMeshAsset"].get<std::string>();
-                FManagerOBJ::CreateStaticMesh(MeshPath);
 
-                int32 LastDirectoryIndex = MeshPath.Find(FString("/"), ESearchCase::CaseSensitive, ESearchDir::FromEnd, -1);
-                FString MeshFileName = MeshPath.SubStr(LastDirectoryIndex + 1);
-
-                (Cast<UStaticMeshComponent>(obj))->SetStaticMesh(FManagerOBJ::GetStaticMesh(MeshFileName.ToWideString()));
+                // 메시는 로딩 스레드에서 읽고, 도착할 때까지는 대체 메시를 그림
+                (Cast<UStaticMeshComponent>(obj))->SetStaticMeshAsync(MeshPath);
             }
             if (value.contains("Location")) sceneComp->SetLocation(FVector(value["Location"].get<std::vector<float>>()[0],
                 value["Location"].get<std::vector<float>>()[1],
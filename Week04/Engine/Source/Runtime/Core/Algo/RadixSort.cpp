@@ -0,0 +1,85 @@
+#include "RadixSort.h"
+
+#include <cstring>
+
+#include "Core/Async/JobSystem.h"
+
+void FRadixSort::Sort(TArray<uint64>& Keys, TArray<uint64>& Scratch)
+{
+    const uint32 Num = Keys.Num();
+    if (Num < 2)
+    {
+        return;
+    }
+    Scratch.SetNum(Num);
+
+    const uint32 NumBlocks = Num >= ParallelThreshold ? FMath::Min(FJobSystem::GetNumThreads(), MaxBlocks) : 1;
+    const uint32 BlockSize = (Num + NumBlocks - 1) / NumBlocks;
+
+    // [블록][자릿값] 개수, 누적 후에는 각 블록이 쓸 위치
+    uint32 Histograms[MaxBlocks][NumBuckets];
+
+    uint64* Src = Keys.GetData();
+    uint64* Dst = Scratch.GetData();
+    bool bResultInScratch = false;
+
+    for (uint32 Shift = 0; Shift < 64; Shift += RadixBits)
+    {
+        FJobSystem::ParallelFor(static_cast<int32>(NumBlocks), [&](int32 Block)
+        {
+            uint32* Histogram = Histograms[Block];
+            std::memset(Histogram, 0, sizeof(Histograms[Block]));
+
+            const uint32 Start = Block * BlockSize;
+            const uint32 End = FMath::Min(Start + BlockSize, Num);
+            for (uint32 i = Start; i < End; ++i)
+            {
+                ++Histogram[(Src[i] >> Shift) & (NumBuckets - 1)];
+            }
+        });
+
+        // 모든 키가 이 자리에서 같은 값이면 순서가 바뀌지 않으므로 건너뜀
+        const uint32 FirstDigit = (Src[0] >> Shift) & (NumBuckets - 1);
+        uint32 FirstDigitCount = 0;
+        for (uint32 Block = 0; Block < NumBlocks; ++Block)
+        {
+            FirstDigitCount += Histograms[Block][FirstDigit];
+        }
+        if (FirstDigitCount == Num)
+        {
+            continue;
+        }
+
+        // 자릿값 순서, 같은 자릿값 안에서는 블록 순서로 위치를 정해야 안정 정렬이 됨
+        uint32 Offset = 0;
+        for (uint32 Digit = 0; Digit < NumBuckets; ++Digit)
+        {
+            for (uint32 Block = 0; Block < NumBlocks; ++Block)
+            {
+                const uint32 Count = Histograms[Block][Digit];
+                Histograms[Block][Digit] = Offset;
+                Offset += Count;
+            }
+        }
+
+        FJobSystem::ParallelFor(static_cast<int32>(NumBlocks), [&](int32 Block)
+        {
+            uint32* Histogram = Histograms[Block];
+            const uint32 Start = Block * BlockSize;
+            const uint32 End = FMath::Min(Start + BlockSize, Num);
+            for (uint32 i = Start; i < End; ++i)
+            {
+                Dst[Histogram[(Src[i] >> Shift) & (NumBuckets - 1)]++] = Src[i];
+            }
+        });
+
+        std::swap(Src, Dst);
+        bResultInScratch = !bResultInScratch;
+    }
+
+    // 버퍼만 맞바꿔서 복사 없이 결과를 Keys로 옮김
+    if (bResultInScratch)
+    {
+        std::swap(Keys, Scratch);
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "Core/Container/Array.h"
+#include "Core/HAL/PlatformType.h"
+
+/** 64비트 정수 키를 위한 LSD 기수 정렬 */
+class FRadixSort
+{
+public:
+    /**
+     * Keys를 오름차순으로 정렬합니다. 안정 정렬입니다.
+     * 원소가 많으면 블록을 나눠 히스토그램과 분배를 잡 시스템에서 병렬로 처리하고,
+     * 모든 키의 자릿값이 같은 자리는 건너뜁니다.
+     * @param Scratch 임시 버퍼. Keys와 같은 크기로 맞춰지며, 멤버로 들고 재사용하면 매번 할당하지 않음
+     */
+    static void Sort(TArray<uint64>& Keys, TArray<uint64>& Scratch);
+
+    static constexpr uint32 RadixBits = 8;
+    static constexpr uint32 NumBuckets = 1 << RadixBits;
+
+    /** 이보다 적으면 한 스레드에서 정렬 */
+    static constexpr uint32 ParallelThreshold = 16384;
+
+    /** 히스토그램을 스택에 두기 위한 최대 블록 수 */
+    static constexpr uint32 MaxBlocks = 32;
+};
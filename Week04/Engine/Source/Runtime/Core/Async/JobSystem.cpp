@@ -0,0 +1,274 @@
+#include "JobSystem.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <thread>
+
+namespace
+{
+    struct FWorkerQueue
+    {
+        std::mutex Mutex;
+        std::deque<FJob> Jobs;
+    };
+
+    /** 0번 큐는 Initialize를 호출한 스레드, 1번부터 워커 스레드의 큐 */
+    TArray<std::unique_ptr<FWorkerQueue>> Queues;
+    TArray<std::thread> Workers;
+
+    /** 큐에 들어있는 작업 수. 워커를 재울지 판단할 때 사용 */
+    std::atomic<int32> NumQueuedJobs = 0;
+
+    /** 워커가 아닌 스레드가 작업을 넣을 큐를 돌아가며 고름 */
+    std::atomic<uint32> NextExternalQueue = 0;
+
+    std::mutex WakeMutex;
+    std::condition_variable WakeCondition;
+    bool bStopping = false;
+
+    /** 현재 스레드의 큐 인덱스. 큐가 없는 스레드는 -1 */
+    thread_local int32 GQueueIndex = -1;
+
+    bool PopJob(FWorkerQueue& Queue, FJob& OutJob, bool bFromBack)
+    {
+        std::lock_guard Lock(Queue.Mutex);
+        if (Queue.Jobs.empty())
+        {
+            return false;
+        }
+
+        if (bFromBack)
+        {
+            OutJob = std::move(Queue.Jobs.back());
+            Queue.Jobs.pop_back();
+        }
+        else
+        {
+            OutJob = std::move(Queue.Jobs.front());
+            Queue.Jobs.pop_front();
+        }
+        NumQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool ShouldWake()
+    {
+        return bStopping || NumQueuedJobs.load(std::memory_order_relaxed) > 0;
+    }
+}
+
+void FJobSystem::Initialize(uint32 NumWorkers)
+{
+    if (!Queues.IsEmpty())
+    {
+        return;
+    }
+
+    if (NumWorkers == 0)
+    {
+        const uint32 NumCores = std::thread::hardware_concurrency();
+        NumWorkers = NumCores > 1 ? NumCores - 1 : 1;
+    }
+
+    bStopping = false;
+    for (uint32 i = 0; i < NumWorkers + 1; ++i)
+    {
+        Queues.Add(std::make_unique<FWorkerQueue>());
+    }
+    GQueueIndex = 0;
+
+    for (uint32 i = 1; i <= NumWorkers; ++i)
+    {
+        Workers.Add(std::thread([i]()
+        {
+            GQueueIndex = static_cast<int32>(i);
+            while (true)
+            {
+                if (TryRunOneJob())
+                {
+                    continue;
+                }
+
+                std::unique_lock Lock(WakeMutex);
+                WakeCondition.wait(Lock, ShouldWake);
+                if (bStopping && NumQueuedJobs.load(std::memory_order_relaxed) == 0)
+                {
+                    return;
+                }
+            }
+        }));
+    }
+}
+
+void FJobSystem::Shutdown()
+{
+    if (Queues.IsEmpty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard Lock(WakeMutex);
+        bStopping = true;
+    }
+    WakeCondition.notify_all();
+
+    for (std::thread& Worker : Workers)
+    {
+        Worker.join();
+    }
+    Workers.Empty();
+    Queues.Empty();
+    GQueueIndex = -1;
+}
+
+uint32 FJobSystem::GetNumWorkers()
+{
+    return Workers.Num();
+}
+
+int32 FJobSystem::GetThreadIndex()
+{
+    return GQueueIndex >= 0 ? GQueueIndex : 0;
+}
+
+void FJobSystem::Run(std::function<void()> Function, FJobCounter* Counter)
+{
+    if (Counter)
+    {
+        Counter->Value.fetch_add(1, std::memory_order_relaxed);
+    }
+    Submit(FJob{ std::move(Function), Counter });
+}
+
+void FJobSystem::RunAfter(FJobCounter& Dependency, std::function<void()> Function, FJobCounter* Counter)
+{
+    if (Counter)
+    {
+        Counter->Value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    FJob Job{ std::move(Function), Counter };
+    {
+        // Dependency가 0이 되는 쪽도 같은 락을 잡고 후속 작업을 꺼내므로 놓치지 않음
+        std::lock_guard Lock(Dependency.ContinuationMutex);
+        if (!Dependency.IsDone())
+        {
+            Dependency.Continuations.Add(std::move(Job));
+            return;
+        }
+    }
+    Submit(std::move(Job));
+}
+
+void FJobSystem::Wait(const FJobCounter& Counter)
+{
+    // 큐가 없는 스레드는 GetThreadIndex가 0번 스레드와 겹치므로 다른 작업을 대신 처리하지 않고 0이 될 때까지 잠듦
+    if (GQueueIndex < 0)
+    {
+        int32 Value;
+        while ((Value = Counter.Value.load(std::memory_order_acquire)) != 0)
+        {
+            Counter.Value.wait(Value, std::memory_order_acquire);
+        }
+    }
+    else
+    {
+        while (!Counter.IsDone())
+        {
+            if (!TryRunOneJob())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // 마지막 작업을 끝낸 스레드가 락을 놓을 때까지 기다려야 Counter를 지워도 안전함
+    std::lock_guard Lock(Counter.ContinuationMutex);
+}
+
+bool FJobSystem::TryRunOneJob()
+{
+    const int32 NumQueues = Queues.Num();
+    if (NumQueues == 0 || NumQueuedJobs.load(std::memory_order_relaxed) == 0)
+    {
+        return false;
+    }
+
+    FJob Job;
+    const int32 OwnIndex = GQueueIndex;
+    bool bFound = OwnIndex >= 0 && PopJob(*Queues[OwnIndex], Job, true);
+
+    // 자기 큐가 비었으면 다음 큐부터 돌면서 가장 오래된 작업을 훔쳐옴
+    const int32 StartIndex = OwnIndex >= 0 ? OwnIndex + 1 : 0;
+    for (int32 i = 0; !bFound && i < NumQueues; ++i)
+    {
+        const int32 VictimIndex = (StartIndex + i) % NumQueues;
+        if (VictimIndex != OwnIndex)
+        {
+            bFound = PopJob(*Queues[VictimIndex], Job, false);
+        }
+    }
+
+    if (bFound)
+    {
+        Execute(Job);
+    }
+    return bFound;
+}
+
+void FJobSystem::Execute(FJob& Job)
+{
+    Job.Function();
+
+    FJobCounter* Counter = Job.Counter;
+    if (!Counter)
+    {
+        return;
+    }
+
+    // 기다리던 쪽이 0을 보고 카운터를 지울 수 있으므로, 락을 푼 뒤에는 Counter를 건드리지 않음
+    TArray<FJob> Continuations;
+    {
+        std::lock_guard Lock(Counter->ContinuationMutex);
+        if (Counter->Value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            Continuations = std::move(Counter->Continuations);
+            Counter->Continuations.Empty();
+
+            // 락을 잡고 있는 동안은 깨어난 쪽이 Counter를 지우지 못하므로 여기서 깨움
+            Counter->Value.notify_all();
+        }
+    }
+    for (FJob& Continuation : Continuations)
+    {
+        Submit(std::move(Continuation));
+    }
+}
+
+void FJobSystem::Submit(FJob&& Job)
+{
+    // 초기화 전이거나 종료 후에는 바로 실행
+    if (Queues.IsEmpty())
+    {
+        Execute(Job);
+        return;
+    }
+
+    const int32 QueueIndex = GQueueIndex >= 0
+        ? GQueueIndex
+        : static_cast<int32>(NextExternalQueue.fetch_add(1, std::memory_order_relaxed) % Queues.Num());
+    {
+        FWorkerQueue& Queue = *Queues[QueueIndex];
+        std::lock_guard Lock(Queue.Mutex);
+        Queue.Jobs.push_back(std::move(Job));
+    }
+    NumQueuedJobs.fetch_add(1, std::memory_order_relaxed);
+
+    // 워커가 조건을 확인하고 잠들기 직전에 알림을 놓치지 않도록 락을 한 번 거침
+    {
+        std::lock_guard Lock(WakeMutex);
+    }
+    WakeCondition.notify_one();
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+#include "Core/Container/Array.h"
+#include "Core/HAL/PlatformType.h"
+#include "Core/Math/MathUtility.h"
+
+class FJobCounter;
+
+struct FJob
+{
+    std::function<void()> Function;
+
+    /** 작업이 끝나면 1 감소시킬 카운터. 없으면 nullptr */
+    FJobCounter* Counter = nullptr;
+};
+
+/**
+ * 작업 완료를 기다리기 위한 카운터.
+ * 작업을 넣을 때 1 증가하고 작업이 끝나면 1 감소합니다. 0이 되면 걸어둔 후속 작업이 실행됩니다.
+ */
+class FJobCounter
+{
+public:
+    FJobCounter() = default;
+    FJobCounter(const FJobCounter&) = delete;
+    FJobCounter& operator=(const FJobCounter&) = delete;
+
+    bool IsDone() const { return Value.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class FJobSystem;
+
+    std::atomic<int32> Value = 0;
+
+    mutable std::mutex ContinuationMutex;
+    TArray<FJob> Continuations;
+};
+
+/**
+ * 엔진 전체에서 공유하는 작업 스케줄러.
+ * 워커 스레드는 Initialize에서 한 번만 만들고, 워커마다 작업 큐를 가집니다.
+ * 자기 큐는 뒤에서(LIFO) 꺼내고, 비면 다른 워커의 큐 앞에서(FIFO) 훔쳐옵니다.
+ *
+ * @note Initialize 전에는 모든 작업을 호출한 스레드에서 바로 실행합니다.
+ */
+class FJobSystem
+{
+public:
+    /**
+     * 워커 스레드를 만듭니다. Initialize를 호출한 스레드도 Wait 중에 작업을 처리합니다.
+     * @param NumWorkers 0이면 논리 코어 수 - 1
+     */
+    static void Initialize(uint32 NumWorkers = 0);
+
+    /** 남은 작업을 모두 처리한 뒤 워커 스레드를 종료합니다. */
+    static void Shutdown();
+
+    static uint32 GetNumWorkers();
+
+    /** 작업을 처리할 수 있는 스레드 수 (워커 + 호출 스레드) */
+    static uint32 GetNumThreads() { return GetNumWorkers() + 1; }
+
+    /**
+     * 현재 스레드의 인덱스 [0, GetNumThreads()). 스레드별 버퍼를 고를 때 사용합니다.
+     * Initialize를 호출한 스레드는 0이고, 워커가 아닌 다른 스레드도 0을 돌려주므로 주의해야 합니다.
+     */
+    static int32 GetThreadIndex();
+
+    /** Function을 비동기로 실행합니다. Counter가 있으면 끝날 때까지 Wait로 기다릴 수 있습니다. */
+    static void Run(std::function<void()> Function, FJobCounter* Counter = nullptr);
+
+    /** Dependency의 작업이 모두 끝난 뒤 Function을 실행합니다. */
+    static void RunAfter(FJobCounter& Dependency, std::function<void()> Function, FJobCounter* Counter = nullptr);
+
+    /**
+     * Counter가 0이 될 때까지 다른 작업을 대신 처리하면서 기다립니다.
+     * 워커도 Initialize를 호출한 스레드도 아닌 스레드(에셋 로딩 스레드 등)는 작업을 처리하지 않고 잠들어서 기다립니다.
+     */
+    static void Wait(const FJobCounter& Counter);
+
+    /**
+     * Body(Index)를 [0, Num) 범위에 대해 병렬로 실행하고 모두 끝날 때까지 기다립니다.
+     * 호출한 스레드도 함께 처리하며, 인덱스는 MinBatchSize개씩 먼저 가져가는 스레드가 처리합니다.
+     */
+    template <typename FuncType>
+    static void ParallelFor(int32 Num, const FuncType& Body, int32 MinBatchSize = 1);
+
+private:
+    /** 큐에서 작업 하나를 꺼내 실행합니다. @return 실행했으면 true */
+    static bool TryRunOneJob();
+
+    static void Execute(FJob& Job);
+
+    static void Submit(FJob&& Job);
+};
+
+template <typename FuncType>
+void FJobSystem::ParallelFor(int32 Num, const FuncType& Body, int32 MinBatchSize)
+{
+    if (Num <= 0)
+    {
+        return;
+    }
+
+    const int32 BatchSize = FMath::Max(MinBatchSize, 1);
+    const int32 NumBatches = (Num + BatchSize - 1) / BatchSize;
+    const int32 NumHelpers = FMath::Min(NumBatches, static_cast<int32>(GetNumThreads())) - 1;
+
+    // 배치를 미리 나누지 않고 먼저 끝난 스레드가 다음 배치를 가져가게 해서 부하를 맞춤
+    std::atomic<int32> NextIndex = 0;
+    auto ProcessBatches = [&]()
+    {
+        int32 Start;
+        while ((Start = NextIndex.fetch_add(BatchSize, std::memory_order_relaxed)) < Num)
+        {
+            const int32 End = FMath::Min(Start + BatchSize, Num);
+            for (int32 Index = Start; Index < End; ++Index)
+            {
+                Body(Index);
+            }
+        }
+    };
+
+    FJobCounter Counter;
+    for (int32 i = 0; i < NumHelpers; ++i)
+    {
+        Run(ProcessBatches, &Counter);
+    }
+    ProcessBatches();
+    Wait(Counter);
+}
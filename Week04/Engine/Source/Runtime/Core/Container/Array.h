@@ -75,6 +75,12 @@ public:
 	/** 특정 위치에 있는 요소를 제거합니다. */
     void RemoveAt(SizeType Index);
 
+	/** 특정 위치의 요소를 마지막 요소와 바꾼 뒤 제거합니다. 순서를 유지하지 않는 대신 O(1) 입니다. */
+    void RemoveAtSwap(SizeType Index);
+
+	/** 왼쪽부터 Item과 일치하는 요소를 1개 찾아 RemoveAtSwap으로 제거합니다. */
+    bool RemoveSingleSwap(const T& Item);
+
 	/** Predicate에 부합하는 모든 요소를 제거합니다. */
     template <typename Predicate>
         requires std::is_invocable_r_v<bool, Predicate, const T&>
@@ -264,6 +270,31 @@ void TArray<T, Allocator>::RemoveAt(SizeType Index)
     }
 }
 
+template <typename T, typename Allocator>
+void TArray<T, Allocator>::RemoveAtSwap(SizeType Index)
+{
+    if (Index >= 0 && static_cast<SizeType>(Index) < ContainerPrivate.size())
+    {
+        if (static_cast<SizeType>(Index) != ContainerPrivate.size() - 1)
+        {
+            ContainerPrivate[Index] = std::move(ContainerPrivate.back());
+        }
+        ContainerPrivate.pop_back();
+    }
+}
+
+template <typename T, typename Allocator>
+bool TArray<T, Allocator>::RemoveSingleSwap(const T& Item)
+{
+    auto it = std::find(ContainerPrivate.begin(), ContainerPrivate.end(), Item);
+    if (it != ContainerPrivate.end())
+    {
+        RemoveAtSwap(static_cast<SizeType>(std::distance(ContainerPrivate.begin(), it)));
+        return true;
+    }
+    return false;
+}
+
 template <typename T, typename Allocator>
 template <typename Predicate>
     requires std::is_invocable_r_v<bool, Predicate, const T&>
@@ -352,3 +383,6 @@ void TArray<T, Allocator>::Sort(const Compare& CompFn)
 }
 
 template <typename T, typename Allocator = FDefaultAllocator<T>> class TArray;
+
+/** 한 프레임 안에서만 쓰는 임시 배열. FFrameAllocator 참고 */
+template <typename T> using TFrameArray = TArray<T, FFrameContainerAllocator<T>>;
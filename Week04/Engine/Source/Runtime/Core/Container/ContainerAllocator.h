@@ -3,6 +3,7 @@
 
 #include "Core/HAL/PlatformType.h"
 #include "Core/HAL/PlatformMemory.h"
+#include "Core/HAL/FrameAllocator.h"
 
 
 /**
@@ -94,3 +95,51 @@ constexpr void TContainerAllocator<T, IndexSize>::deallocate(T* p, size_type n)
 
 template <typename T> using FDefaultAllocator = TContainerAllocator<T, 32>;
 template <typename T> using FDefaultAllocator64 = TContainerAllocator<T, 64>;
+
+
+/**
+ * 현재 스레드의 FFrameAllocator에서 메모리를 받는 Allocator. 해제는 프레임 끝에 한꺼번에 되므로 컨테이너가 커질 때 힙을 거치지 않음
+ * @note 이 Allocator를 쓰는 컨테이너는 프레임을 넘겨서 들고 있으면 안 됩니다.
+ */
+template <typename T, int IndexSize>
+struct TFrameAllocator
+{
+public:
+    using SizeType = typename TBitsToSizeType<IndexSize>::Type;
+
+    //~ std::allocator_traits 관련 타입
+    using value_type = T;
+    using size_type = std::make_unsigned_t<SizeType>;
+    using difference_type = std::make_signed_t<SizeType>;
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = TFrameAllocator<U, IndexSize>;
+    };
+    //~ std::allocator_traits 관련 타입
+
+public:
+    constexpr TFrameAllocator() noexcept = default;
+
+    template <class U>
+    constexpr TFrameAllocator(const TFrameAllocator<U, IndexSize>&) noexcept {}
+
+public:
+    T* allocate(size_type n) noexcept
+    {
+        return static_cast<T*>(FFrameAllocator::Get().Allocate(sizeof(T) * n, alignof(T)));
+    }
+
+    void deallocate(T* p, size_type n) noexcept
+    {
+        FFrameAllocator::Get().Free(p, sizeof(T) * n);
+    }
+
+    template <class U>
+    constexpr bool operator==(const TFrameAllocator<U, IndexSize>&) const noexcept { return true; }
+};
+
+template <typename T> using FFrameContainerAllocator = TFrameAllocator<T, 32>;
@@ -0,0 +1,151 @@
+#include "FrameAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <malloc.h>
+#include <mutex>
+
+namespace
+{
+    /** 청크 시작 정렬. 캐시 라인 단위로 맞춤 */
+    constexpr size_t ChunkAlignment = 64;
+
+    /** EndFrame이 비울 할당자들. 스레드가 끝나면 할당자 소멸자에서 빠짐 */
+    std::mutex RegistryMutex;
+    std::vector<FFrameAllocator*> Registry;
+
+    uint64 LastFrameBytes = 0;
+
+    uint8* AlignUp(uint8* Ptr, size_t Alignment)
+    {
+        const uintptr_t Address = reinterpret_cast<uintptr_t>(Ptr);
+        return reinterpret_cast<uint8*>((Address + Alignment - 1) & ~(static_cast<uintptr_t>(Alignment) - 1));
+    }
+}
+
+FFrameAllocator& FFrameAllocator::Get()
+{
+    struct FThreadAllocator
+    {
+        FFrameAllocator Allocator;
+
+        FThreadAllocator()
+        {
+            std::lock_guard Lock(RegistryMutex);
+            Registry.push_back(&Allocator);
+        }
+
+        ~FThreadAllocator()
+        {
+            std::lock_guard Lock(RegistryMutex);
+            Registry.erase(std::find(Registry.begin(), Registry.end(), &Allocator));
+        }
+    };
+
+    thread_local FThreadAllocator ThreadAllocator;
+    return ThreadAllocator.Allocator;
+}
+
+FFrameAllocator::~FFrameAllocator()
+{
+    for (const FChunk& Chunk : Chunks)
+    {
+        _aligned_free(Chunk.Data);
+    }
+}
+
+void* FFrameAllocator::Allocate(size_t Size, size_t Alignment)
+{
+    uint8* Result = AlignUp(Cursor, Alignment);
+    if (!Cursor || Result + Size > End)
+    {
+        NextChunk(Size, Alignment);
+        Result = AlignUp(Cursor, Alignment);
+    }
+
+    Cursor = Result + Size;
+    return Result;
+}
+
+void FFrameAllocator::Free(void* Ptr, size_t Size)
+{
+    if (static_cast<uint8*>(Ptr) + Size == Cursor)
+    {
+        Cursor = static_cast<uint8*>(Ptr);
+    }
+}
+
+void FFrameAllocator::NextChunk(size_t Size, size_t Alignment)
+{
+    if (Cursor)
+    {
+        UsedBytes += Cursor - Chunks[CurrentChunk].Data;
+        ++CurrentChunk;
+    }
+
+    // 남은 청크 중 들어가는 것을 찾음. 작은 청크는 건너뛰고 다음 프레임에 다시 씀
+    const size_t Required = Size + (Alignment > ChunkAlignment ? Alignment : 0);
+    while (CurrentChunk < Chunks.size() && Chunks[CurrentChunk].Size < Required)
+    {
+        ++CurrentChunk;
+    }
+
+    if (CurrentChunk == Chunks.size())
+    {
+        const size_t NewSize = std::max(ChunkSize, Required);
+        uint8* Data = static_cast<uint8*>(_aligned_malloc(NewSize, ChunkAlignment));
+        assert(Data);
+        Chunks.push_back({Data, NewSize});
+    }
+
+    Cursor = Chunks[CurrentChunk].Data;
+    End = Cursor + Chunks[CurrentChunk].Size;
+}
+
+uint64 FFrameAllocator::Reset()
+{
+    uint64 FrameBytes = UsedBytes;
+    if (Cursor)
+    {
+        FrameBytes += Cursor - Chunks[CurrentChunk].Data;
+    }
+
+    CurrentChunk = 0;
+    UsedBytes = 0;
+    Cursor = Chunks.empty() ? nullptr : Chunks[0].Data;
+    End = Chunks.empty() ? nullptr : Cursor + Chunks[0].Size;
+    return FrameBytes;
+}
+
+void FFrameAllocator::EndFrame()
+{
+    std::lock_guard Lock(RegistryMutex);
+
+    uint64 FrameBytes = 0;
+    for (FFrameAllocator* Allocator : Registry)
+    {
+        FrameBytes += Allocator->Reset();
+    }
+    LastFrameBytes = FrameBytes;
+}
+
+uint64 FFrameAllocator::GetLastFrameBytes()
+{
+    std::lock_guard Lock(RegistryMutex);
+    return LastFrameBytes;
+}
+
+uint64 FFrameAllocator::GetReservedBytes()
+{
+    std::lock_guard Lock(RegistryMutex);
+
+    uint64 Reserved = 0;
+    for (const FFrameAllocator* Allocator : Registry)
+    {
+        for (const FChunk& Chunk : Allocator->Chunks)
+        {
+            Reserved += Chunk.Size;
+        }
+    }
+    return Reserved;
+}
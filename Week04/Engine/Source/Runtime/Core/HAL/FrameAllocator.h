@@ -0,0 +1,63 @@
+#pragma once
+#include <vector>
+
+#include "Core/HAL/PlatformType.h"
+
+/**
+ * 한 프레임 동안만 쓰는 임시 메모리를 앞에서부터 잘라 주는 선형(bump) 할당자. 스레드마다 하나씩 있습니다.
+ * 해제는 하지 않고 프레임 끝(EndFrame)에 모든 스레드의 커서를 처음으로 되돌리며, 청크는 다음 프레임에 그대로 재사용하므로
+ * 한 번 필요한 크기까지 커진 뒤에는 힙 할당이 없습니다.
+ *
+ * @note 메인 스레드와 FJobSystem 워커에서 프레임 안에서만 씁니다. 다음 프레임까지 남는 데이터나 로딩 스레드에는 쓰지 않음
+ */
+class FFrameAllocator
+{
+public:
+    /** 호출한 스레드의 할당자. 처음 호출할 때 만들어서 EndFrame 대상에 등록됩니다. */
+    static FFrameAllocator& Get();
+
+    void* Allocate(size_t Size, size_t Alignment);
+
+    /** Ptr이 이 스레드의 마지막 할당이면 되돌려서 배열이 커질 때 이전 버퍼 자리를 다시 씀. 아니면 아무것도 하지 않음 */
+    void Free(void* Ptr, size_t Size);
+
+    /** 모든 스레드의 할당자를 비웁니다. 다른 스레드가 프레임 메모리를 쓰지 않는 프레임 끝에 메인 스레드에서 호출 */
+    static void EndFrame();
+
+    /** 직전 프레임에 모든 스레드가 쓴 바이트 수 */
+    static uint64 GetLastFrameBytes();
+
+    /** 모든 스레드가 잡아 둔 청크의 바이트 수 */
+    static uint64 GetReservedBytes();
+
+    /** 청크 하나의 기본 크기. 더 큰 할당은 그 크기의 청크를 따로 잡음 */
+    static constexpr size_t ChunkSize = 256 * 1024;
+
+    FFrameAllocator() = default;
+    ~FFrameAllocator();
+
+    FFrameAllocator(const FFrameAllocator&) = delete;
+    FFrameAllocator& operator=(const FFrameAllocator&) = delete;
+
+private:
+    struct FChunk
+    {
+        uint8* Data;
+        size_t Size;
+    };
+
+    /** 커서를 처음으로 되돌리고 이번 프레임에 쓴 바이트 수를 돌려줍니다. */
+    uint64 Reset();
+
+    /** 다음 청크로 넘어가거나, Size가 들어가는 청크가 없으면 새로 잡습니다. */
+    void NextChunk(size_t Size, size_t Alignment);
+
+    // 할당자 자신이 쓰는 배열이므로 TArray(EAT_Container 통계) 대신 std::vector
+    std::vector<FChunk> Chunks;
+    size_t CurrentChunk = 0;
+    uint8* Cursor = nullptr;
+    uint8* End = nullptr;
+
+    /** 지난 청크까지 쓴 바이트 수. 현재 청크는 Cursor로 셈 */
+    uint64 UsedBytes = 0;
+};
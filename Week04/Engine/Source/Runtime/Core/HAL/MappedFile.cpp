@@ -0,0 +1,61 @@
+#include "MappedFile.h"
+
+FMappedFile::~FMappedFile()
+{
+    Close();
+}
+
+bool FMappedFile::Open(const FWString& FilePath)
+{
+    Close();
+
+    FileHandle = CreateFileW(FilePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (FileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER FileSize;
+    if (!GetFileSizeEx(FileHandle, &FileSize) || FileSize.QuadPart == 0)
+    {
+        Close();
+        return false;
+    }
+
+    MappingHandle = CreateFileMappingW(FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (MappingHandle == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    Data = static_cast<const uint8*>(MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (Data == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    Size = static_cast<uint64>(FileSize.QuadPart);
+    return true;
+}
+
+void FMappedFile::Close()
+{
+    if (Data != nullptr)
+    {
+        UnmapViewOfFile(Data);
+        Data = nullptr;
+    }
+    if (MappingHandle != nullptr)
+    {
+        CloseHandle(MappingHandle);
+        MappingHandle = nullptr;
+    }
+    if (FileHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(FileHandle);
+        FileHandle = INVALID_HANDLE_VALUE;
+    }
+    Size = 0;
+}
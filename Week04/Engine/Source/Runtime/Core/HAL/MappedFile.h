@@ -0,0 +1,33 @@
+#pragma once
+#include "Core/HAL/PlatformType.h"
+
+/**
+ * 읽기 전용으로 메모리에 매핑한 파일.
+ * 파일 내용을 복사하지 않고 GetData()로 바로 접근하며, 객체가 사라질 때 매핑을 해제합니다.
+ */
+class FMappedFile
+{
+public:
+    FMappedFile() = default;
+    ~FMappedFile();
+
+    FMappedFile(const FMappedFile&) = delete;
+    FMappedFile& operator=(const FMappedFile&) = delete;
+
+    /** FilePath를 매핑합니다. 이미 열려 있으면 먼저 닫습니다. 빈 파일은 매핑할 수 없으므로 실패합니다. */
+    bool Open(const FWString& FilePath);
+
+    void Close();
+
+    bool IsOpen() const { return Data != nullptr; }
+
+    /** 매핑된 파일의 시작 주소. 할당 단위(64KB)로 정렬되어 있습니다. */
+    const uint8* GetData() const { return Data; }
+    uint64 GetSize() const { return Size; }
+
+private:
+    HANDLE FileHandle = INVALID_HANDLE_VALUE;
+    HANDLE MappingHandle = nullptr;
+    const uint8* Data = nullptr;
+    uint64 Size = 0;
+};
@@ -23,13 +23,14 @@ private:
     static std::atomic<uint64> ContainerAllocationBytes;
     static std::atomic<uint64> ContainerAllocationCount;
 
+public:
+    /** 풀처럼 미리 잡아 둔 메모리를 나눠 주는 할당자가 블록 하나를 통계에 더하거나 뺄 때 씁니다. */
     template <EAllocationType AllocType>
     static void IncrementStats(size_t Size);
 
     template <EAllocationType AllocType>
     static void DecrementStats(size_t Size);
 
-public:
     template <EAllocationType AllocType>
     static void* Malloc(size_t Size);
 
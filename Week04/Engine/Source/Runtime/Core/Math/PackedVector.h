@@ -0,0 +1,155 @@
+#pragma once
+#include <cmath>
+#include <cstring>
+
+#include "HAL/PlatformType.h"
+#include "Math/Vector.h"
+
+/**
+ * IEEE 754 binary16 변환. 비트 배치가 DXGI_FORMAT_R16_FLOAT와 같아서 셰이더가 float로 바로 읽습니다.
+ * Encode는 가장 가까운 짝수로 반올림하고, 범위를 넘으면 무한대가 됩니다.
+ */
+namespace FFloat16
+{
+    inline uint16 Encode(float Value)
+    {
+        uint32 Bits;
+        std::memcpy(&Bits, &Value, sizeof(Bits));
+
+        const uint32 Sign = (Bits >> 16) & 0x8000;
+        const uint32 Abs = Bits & 0x7FFFFFFF;
+
+        if (Abs >= 0x7F800000) // Inf, NaN
+        {
+            return static_cast<uint16>(Sign | 0x7C00 | (Abs > 0x7F800000 ? 0x200 : 0));
+        }
+        if (Abs >= 0x477FF000) // 65520 이상은 반올림하면 무한대
+        {
+            return static_cast<uint16>(Sign | 0x7C00);
+        }
+        if (Abs < 0x38800000) // half의 비정규 수 범위 (2^-14 미만)
+        {
+            if (Abs < 0x33000000)
+            {
+                return static_cast<uint16>(Sign);
+            }
+            const uint32 Exponent = Abs >> 23;
+            const uint32 Mantissa = (Abs & 0x7FFFFF) | 0x800000;
+            const uint32 Shift = 126 - Exponent;
+            uint32 Half = Mantissa >> Shift;
+            const uint32 Remainder = Mantissa & ((1u << Shift) - 1);
+            const uint32 HalfWay = 1u << (Shift - 1);
+            if (Remainder > HalfWay || (Remainder == HalfWay && (Half & 1)))
+            {
+                ++Half;
+            }
+            return static_cast<uint16>(Sign | Half);
+        }
+
+        // 지수 바이어스 127 -> 15. 가수 반올림이 넘치면 지수로 올라감
+        uint32 Half = (Abs - 0x38000000) >> 13;
+        const uint32 Remainder = Abs & 0x1FFF;
+        if (Remainder > 0x1000 || (Remainder == 0x1000 && (Half & 1)))
+        {
+            ++Half;
+        }
+        return static_cast<uint16>(Sign | Half);
+    }
+
+    inline float Decode(uint16 Value)
+    {
+        const uint32 Sign = static_cast<uint32>(Value & 0x8000) << 16;
+        const uint32 Exponent = (Value >> 10) & 0x1F;
+        const uint32 Mantissa = Value & 0x3FF;
+
+        uint32 Bits;
+        if (Exponent == 0x1F)
+        {
+            Bits = Sign | 0x7F800000 | (Mantissa << 13);
+        }
+        else if (Exponent != 0)
+        {
+            Bits = Sign | ((Exponent + 112) << 23) | (Mantissa << 13);
+        }
+        else
+        {
+            const float Denormal = static_cast<float>(Mantissa) * (1.f / 16777216.f); // 2^-24
+            return Sign ? -Denormal : Denormal;
+        }
+
+        float Result;
+        std::memcpy(&Result, &Bits, sizeof(Result));
+        return Result;
+    }
+}
+
+/**
+ * 단위 벡터의 팔면체(octahedral) 인코딩. 8비트 snorm 두 개를 하위 바이트 x, 상위 바이트 y로 담습니다.
+ * 각도 오차가 1도 이내라 조명용 법선에 충분합니다.
+ */
+namespace FOctahedralNormal
+{
+    inline uint16 Encode(const FVector& Normal)
+    {
+        const float L1 = std::fabs(Normal.x) + std::fabs(Normal.y) + std::fabs(Normal.z);
+        if (L1 <= 0.f)
+        {
+            return 0;
+        }
+
+        float U = Normal.x / L1;
+        float V = Normal.y / L1;
+        if (Normal.z < 0.f)
+        {
+            // 아래쪽 반구는 대각선을 기준으로 접어서 바깥 삼각형에 둠
+            const float FoldedU = (1.f - std::fabs(V)) * (U >= 0.f ? 1.f : -1.f);
+            const float FoldedV = (1.f - std::fabs(U)) * (V >= 0.f ? 1.f : -1.f);
+            U = FoldedU;
+            V = FoldedV;
+        }
+
+        const auto Quantize = [](float X) -> uint8
+        {
+            const float Clamped = X < -1.f ? -1.f : (X > 1.f ? 1.f : X);
+            return static_cast<uint8>(static_cast<int8>(std::lround(Clamped * 127.f)));
+        };
+        return static_cast<uint16>(Quantize(U) | (Quantize(V) << 8));
+    }
+
+    inline FVector Decode(uint16 Packed)
+    {
+        const float U = std::fmax(static_cast<int8>(Packed & 0xFF) / 127.f, -1.f);
+        const float V = std::fmax(static_cast<int8>(Packed >> 8) / 127.f, -1.f);
+
+        FVector Result(U, V, 1.f - std::fabs(U) - std::fabs(V));
+        if (Result.z < 0.f)
+        {
+            Result.x = (1.f - std::fabs(V)) * (U >= 0.f ? 1.f : -1.f);
+            Result.y = (1.f - std::fabs(U)) * (V >= 0.f ? 1.f : -1.f);
+        }
+        return Result.Normalize();
+    }
+}
+
+/** 바운딩 박스 안의 좌표를 축마다 16비트 UNORM으로 양자화합니다. 크기가 0인 축은 항상 0 */
+namespace FQuantizedPosition
+{
+    static constexpr float MaxValue = 65535.f;
+
+    inline uint16 Encode(float Value, float Min, float Extent)
+    {
+        if (Extent <= 0.f)
+        {
+            return 0;
+        }
+        const float Normalized = (Value - Min) / Extent;
+        const float Clamped = Normalized < 0.f ? 0.f : (Normalized > 1.f ? 1.f : Normalized);
+        return static_cast<uint16>(std::lround(Clamped * MaxValue));
+    }
+
+    /** 셰이더의 역양자화 행렬과 같은 식(q * Extent / 65535 + Min)으로 계산해서 CPU와 GPU 결과가 같음 */
+    inline float Decode(uint16 Value, float Min, float Extent)
+    {
+        return static_cast<float>(Value) * (Extent / MaxValue) + Min;
+    }
+}
@@ -12,12 +12,22 @@ UClass* UObject::StaticClass()
 
 UObject::UObject()
     : UUID(0)
-    // TODO: Object를 생성할 때 직접 설정하기
+    // FObjectFactory가 GUObjectArray에 넣으면서 설정
     , InternalIndex(std::numeric_limits<uint32>::max())
     , NamePrivate("None")
 {
 }
 
+void* UObject::operator new(size_t Size)
+{
+    return StaticClass()->AllocateObject(Size);
+}
+
+void UObject::operator delete(void* Ptr, size_t Size)
+{
+    StaticClass()->FreeObject(Ptr, Size);
+}
+
 bool UObject::IsA(const UClass* SomeBase) const
 {
     const UClass* ThisClass = GetClass();
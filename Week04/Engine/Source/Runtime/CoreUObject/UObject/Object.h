@@ -26,9 +26,10 @@ private:
     friend class FObjectFactory;
     friend class FSceneMgr;
     friend class UClass;
+    friend class FUObjectArray;
 
     uint32 UUID;
-    uint32 InternalIndex; // Index of GUObjectArray
+    uint32 InternalIndex; // Index of GUObjectArray. 배열에 넣기 전에는 uint32 최댓값
 
     FName NamePrivate;
     UClass* ClassPrivate = nullptr;
@@ -67,25 +68,12 @@ public:
     }
 
 public:
-    void* operator new(size_t size)
-    {
-        UE_LOG(LogLevel::Display, "UObject Created : %d", size);
-
-        void* RawMemory = FPlatformMemory::Malloc<EAT_Object>(size);
-        UE_LOG(
-            LogLevel::Display,
-            "TotalAllocationBytes : %d, TotalAllocationCount : %d",
-            FPlatformMemory::GetAllocationBytes<EAT_Object>(),
-            FPlatformMemory::GetAllocationCount<EAT_Object>()
-        );
-        return RawMemory;
-    }
-
-    void operator delete(void* ptr, size_t size)
-    {
-        UE_LOG(LogLevel::Display, "UObject Deleted : %d", size);
-        FPlatformMemory::Free<EAT_Object>(ptr, size);
-    }
+    /**
+     * 클래스마다 StaticClass()의 풀에서 할당합니다. 자식 클래스는 DECLARE_CLASS가 같은 연산자를 다시 선언합니다.
+     * 소멸자가 virtual이라 delete는 실제 타입의 operator delete를 부르므로 할당한 풀로 돌아감
+     */
+    void* operator new(size_t Size);
+    void operator delete(void* Ptr, size_t Size);
 
     FVector4 EncodeUUID() const {
         FVector4 result;
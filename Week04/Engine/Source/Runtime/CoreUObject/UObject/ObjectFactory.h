@@ -11,17 +11,25 @@ public:
         requires std::derived_from<T, UObject>
     static T* ConstructObject()
     {
-        uint32 id = UEngineStatics::GenUUID();
-        FString Name = T::StaticClass()->GetName() + "_" + std::to_string(id);
+        T* Obj = ConstructUnnamedObject<T>();
 
-        T* Obj = new T;  // TODO: FPlatformMemory::Malloc으로 변경, placement new 사용시 Free방법 생각하기
-        Obj->ClassPrivate = T::StaticClass();
+        FString Name = T::StaticClass()->GetName() + "_" + std::to_string(Obj->UUID);
         Obj->NamePrivate = Name;
-        Obj->UUID = id;
-
-        GUObjectArray.AddObject(Obj);
 
         UE_LOG(LogLevel::Display, "Created New Object : %s", *Name);
         return Obj;
     }
+
+    /** 이름("None")과 로그 없이 만듭니다. 벤치마크처럼 한꺼번에 많이 만들 때 FName 풀과 콘솔이 불어나지 않도록 씀 */
+    template<typename T>
+        requires std::derived_from<T, UObject>
+    static T* ConstructUnnamedObject()
+    {
+        T* Obj = new T;  // T::operator new가 T 전용 풀에서 할당
+        Obj->ClassPrivate = T::StaticClass();
+        Obj->UUID = UEngineStatics::GenUUID();
+
+        GUObjectArray.AddObject(Obj);
+        return Obj;
+    }
 };
@@ -19,7 +19,9 @@ public: \
     static UClass* StaticClass() { \
         static UClass ClassInfo{ TEXT(#TClass), static_cast<uint32>(sizeof(TClass)), static_cast<uint32>(alignof(TClass)), TSuperClass::StaticClass() }; \
         return &ClassInfo; \
-    }
+    } \
+    void* operator new(size_t Size) { return StaticClass()->AllocateObject(Size); } \
+    void operator delete(void* Ptr, size_t Size) { StaticClass()->FreeObject(Ptr, Size); }
 
 
 // #define PROPERTY(Type, VarName, DefaultValue) \
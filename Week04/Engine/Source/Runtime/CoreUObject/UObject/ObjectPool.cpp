@@ -0,0 +1,126 @@
+#include "ObjectPool.h"
+
+#include <cassert>
+
+#include "Define.h"
+#include "FWindowsPlatformTime.h"
+#include "Core/HAL/PlatformMemory.h"
+#include "Math/MathUtility.h"
+
+FObjectPool::FObjectPool(uint32 InBlockSize, uint32 InBlockAlignment)
+{
+    // 빈 블록에 다음 블록 포인터를 쓰므로 포인터보다 작을 수 없음
+    BlockAlignment = FMath::Max<uint32>(InBlockAlignment, alignof(FFreeBlock));
+    BlockSize = FMath::Max<uint32>(InBlockSize, sizeof(FFreeBlock));
+    BlockSize = (BlockSize + BlockAlignment - 1) / BlockAlignment * BlockAlignment;
+    SlabSize = FMath::Max(MinSlabSize, BlockSize * MinBlocksPerSlab);
+}
+
+FObjectPool::~FObjectPool()
+{
+    // 종료 시점에 아직 살아 있는 객체가 있으면 나중에 해제될 수 있으므로 슬랩을 남겨 둠
+    if (NumAllocated > 0)
+    {
+        return;
+    }
+
+    for (void* Slab : Slabs)
+    {
+        _aligned_free(Slab);
+    }
+    Slabs.Empty();
+}
+
+void* FObjectPool::Allocate()
+{
+    void* Block;
+    if (FreeList)
+    {
+        Block = FreeList;
+        FreeList = FreeList->Next;
+    }
+    else
+    {
+        if (SlabCursor == SlabEnd)
+        {
+            AllocateSlab();
+        }
+        Block = SlabCursor;
+        SlabCursor += BlockSize;
+    }
+
+    ++NumAllocated;
+    FPlatformMemory::IncrementStats<EAT_Object>(BlockSize);
+    return Block;
+}
+
+void FObjectPool::Free(void* Block)
+{
+    if (!Block)
+    {
+        return;
+    }
+
+    assert(NumAllocated > 0);
+    FFreeBlock* FreeBlock = static_cast<FFreeBlock*>(Block);
+    FreeBlock->Next = FreeList;
+    FreeList = FreeBlock;
+
+    --NumAllocated;
+    FPlatformMemory::DecrementStats<EAT_Object>(BlockSize);
+}
+
+void FObjectPool::AllocateSlab()
+{
+    uint8* Slab = static_cast<uint8*>(_aligned_malloc(SlabSize, BlockAlignment));
+    assert(Slab);
+    Slabs.Add(Slab);
+
+    SlabCursor = Slab;
+    SlabEnd = Slab + SlabSize / BlockSize * BlockSize;
+}
+
+void FObjectPool::RunBenchmark(uint32 BlockSize, uint32 NumBlocks)
+{
+    TArray<void*> Blocks;
+    Blocks.SetNum(NumBlocks);
+
+    // 전부 할당 -> 절반을 건너뛰며 해제 -> 다시 할당 -> 전부 해제. 월드 로드 후 액터를 지우고 다시 스폰하는 경우
+    const auto Run = [&Blocks, NumBlocks](auto&& Allocate, auto&& Free)
+    {
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        for (uint32 i = 0; i < NumBlocks; ++i)
+        {
+            Blocks[i] = Allocate();
+        }
+        for (uint32 i = 0; i < NumBlocks; i += 2)
+        {
+            Free(Blocks[i]);
+        }
+        for (uint32 i = 0; i < NumBlocks; i += 2)
+        {
+            Blocks[i] = Allocate();
+        }
+        for (uint32 i = 0; i < NumBlocks; ++i)
+        {
+            Free(Blocks[i]);
+        }
+        return FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+    };
+
+    const double HeapMs = Run(
+        [BlockSize] { return FPlatformMemory::Malloc<EAT_Object>(BlockSize); },
+        [BlockSize](void* Block) { FPlatformMemory::Free<EAT_Object>(Block, BlockSize); }
+    );
+
+    FObjectPool Pool(BlockSize, 16);
+    const double PoolMs = Run(
+        [&Pool] { return Pool.Allocate(); },
+        [&Pool](void* Block) { Pool.Free(Block); }
+    );
+
+    UE_LOG(LogLevel::Display, "Object allocation benchmark: %u blocks of %u bytes", NumBlocks, BlockSize);
+    UE_LOG(LogLevel::Display, " - heap: %.2f ms", HeapMs);
+    UE_LOG(LogLevel::Display, " - pool: %.2f ms (%.1fx), %u slabs, %.1f MB reserved", PoolMs, PoolMs > 0.0 ? HeapMs / PoolMs : 0.0,
+        Pool.GetNumSlabs(), Pool.GetReservedSize() / (1024.0 * 1024.0));
+}
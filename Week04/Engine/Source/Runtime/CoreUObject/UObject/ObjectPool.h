@@ -0,0 +1,60 @@
+#pragma once
+#include "Core/HAL/PlatformType.h"
+#include "Container/Array.h"
+
+/**
+ * 크기가 같은 블록을 나눠 주는 슬랩 할당자. UClass마다 하나씩 있어서 같은 타입의 객체가 슬랩 안에 연속으로 놓입니다.
+ * 해제한 블록은 프리 리스트에 넣었다가 먼저 재사용하고, 없으면 마지막 슬랩에서 잘라 주므로 할당과 해제 모두 O(1)입니다.
+ * 슬랩은 풀이 없어질 때까지 돌려주지 않습니다.
+ *
+ * @note 잠그지 않으므로 UObject처럼 메인 스레드에서만 생성/삭제하는 객체에 씁니다.
+ */
+class FObjectPool
+{
+public:
+    FObjectPool(uint32 InBlockSize, uint32 InBlockAlignment);
+    ~FObjectPool();
+
+    FObjectPool(const FObjectPool&) = delete;
+    FObjectPool& operator=(const FObjectPool&) = delete;
+
+    void* Allocate();
+
+    /** 이 풀에서 Allocate한 블록만 넘겨야 합니다. */
+    void Free(void* Block);
+
+    uint32 GetBlockSize() const { return BlockSize; }
+    uint32 GetNumAllocated() const { return NumAllocated; }
+    uint32 GetNumSlabs() const { return Slabs.Num(); }
+
+    /** 슬랩이 차지하는 바이트 수 */
+    uint64 GetReservedSize() const { return static_cast<uint64>(Slabs.Num()) * SlabSize; }
+
+    /** 같은 크기의 블록을 힙(FPlatformMemory)과 풀에서 할당/해제하는 시간을 비교합니다. */
+    static void RunBenchmark(uint32 BlockSize, uint32 NumBlocks = 500000);
+
+    /** 슬랩 하나의 최소 크기. 블록이 크면 슬랩당 MinBlocksPerSlab개가 들어가도록 늘림 */
+    static constexpr uint32 MinSlabSize = 64 * 1024;
+    static constexpr uint32 MinBlocksPerSlab = 16;
+
+private:
+    struct FFreeBlock
+    {
+        FFreeBlock* Next;
+    };
+
+    void AllocateSlab();
+
+    uint32 BlockSize;
+    uint32 BlockAlignment;
+    uint32 SlabSize;
+
+    uint32 NumAllocated = 0;
+    FFreeBlock* FreeList = nullptr;
+
+    /** 마지막 슬랩에서 아직 한 번도 나눠 주지 않은 구간 */
+    uint8* SlabCursor = nullptr;
+    uint8* SlabEnd = nullptr;
+
+    TArray<void*> Slabs;
+};
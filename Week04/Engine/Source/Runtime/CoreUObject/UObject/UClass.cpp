@@ -1,16 +1,78 @@
 #include "UClass.h"
 #include <cassert>
+#include <mutex>
+
+#include "Define.h"
+#include "FWindowsPlatformTime.h"
+
+namespace
+{
+    /** StaticClass()는 워커에서 처음 불릴 수도 있으므로 등록과 번호 매기기는 잠금 안에서 함 */
+    std::mutex& GetClassTreeMutex()
+    {
+        static std::mutex Mutex;
+        return Mutex;
+    }
+
+    /** 부모가 없는 클래스들 */
+    TArray<UClass*>& GetRootClasses()
+    {
+        static TArray<UClass*> RootClasses;
+        return RootClasses;
+    }
+}
+
+std::atomic<uint32> UClass::ClassTreeVersion = 0;
 
 
 UClass::UClass(const char* InClassName, uint32 InClassSize, uint32 InAlignment, UClass* InSuperClass)
     : ClassSize(InClassSize)
     , ClassAlignment(InAlignment)
     , SuperClass(InSuperClass)
+    , ObjectPool(InClassSize, InAlignment)
 {
     NamePrivate = InClassName;
+    LinkIntoClassTree();
+}
+
+void UClass::LinkIntoClassTree()
+{
+    std::lock_guard Lock(GetClassTreeMutex());
+
+    // 부모는 생성자 인자로 먼저 만들어지므로 항상 등록되어 있음
+    if (SuperClass)
+    {
+        SuperClass->ChildClasses.Add(this);
+    }
+    else
+    {
+        GetRootClasses().Add(this);
+    }
+
+    // 읽는 쪽이 홀수를 보면 번호 대신 부모를 따라가도록 알림
+    const uint32 Version = ClassTreeVersion.load(std::memory_order_relaxed);
+    ClassTreeVersion.store(Version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint32 NextIndex = 0;
+    const auto Visit = [&NextIndex](auto& Self, UClass* Class) -> void
+    {
+        Class->ClassTreePreIndex.store(NextIndex++, std::memory_order_relaxed);
+        for (UClass* Child : Class->ChildClasses)
+        {
+            Self(Self, Child);
+        }
+        Class->ClassTreePostIndex.store(NextIndex - 1, std::memory_order_relaxed);
+    };
+    for (UClass* Root : GetRootClasses())
+    {
+        Visit(Visit, Root);
+    }
+
+    ClassTreeVersion.store(Version + 2, std::memory_order_release);
 }
 
-bool UClass::IsChildOf(const UClass* SomeBase) const
+bool UClass::IsChildOfBySuperChain(const UClass* SomeBase) const
 {
     assert(this);
     if (!SomeBase) return false;
@@ -26,6 +88,25 @@ bool UClass::IsChildOf(const UClass* SomeBase) const
     return false;
 }
 
+void* UClass::AllocateObject(size_t Size)
+{
+    if (Size != ClassSize)
+    {
+        return FPlatformMemory::Malloc<EAT_Object>(Size);
+    }
+    return ObjectPool.Allocate();
+}
+
+void UClass::FreeObject(void* Object, size_t Size)
+{
+    if (Size != ClassSize)
+    {
+        FPlatformMemory::Free<EAT_Object>(Object, Size);
+        return;
+    }
+    ObjectPool.Free(Object);
+}
+
 UObject* UClass::CreateDefaultObject()
 {
     if (!ClassDefaultObject)
@@ -36,3 +117,37 @@ UObject* UClass::CreateDefaultObject()
 
     return ClassDefaultObject;
 }
+
+void UClass::RunCastBenchmark(const TArray<UObject*>& Objects, const TArray<UClass*>& Classes, int32 NumPasses)
+{
+    // 결과가 최적화로 사라지지 않도록 맞은 수를 셈
+    const auto Run = [&](auto&& IsChildOfFunc, uint64& OutMatches)
+    {
+        OutMatches = 0;
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+        {
+            for (const UObject* Object : Objects)
+            {
+                const UClass* ObjectClass = Object->GetClass();
+                for (const UClass* Class : Classes)
+                {
+                    OutMatches += IsChildOfFunc(ObjectClass, Class);
+                }
+            }
+        }
+        return FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+    };
+
+    uint64 ChainMatches;
+    uint64 IntervalMatches;
+    const double ChainMs = Run([](const UClass* Class, const UClass* Base) { return Class->IsChildOfBySuperChain(Base); }, ChainMatches);
+    const double IntervalMs = Run([](const UClass* Class, const UClass* Base) { return Class->IsChildOf(Base); }, IntervalMatches);
+
+    const uint64 NumChecks = static_cast<uint64>(Objects.Num()) * Classes.Num() * NumPasses;
+    UE_LOG(LogLevel::Display, "Cast benchmark: %u objects x %u classes x %d passes (%s)",
+        Objects.Num(), Classes.Num(), NumPasses, ChainMatches == IntervalMatches ? "match" : "MISMATCH");
+    UE_LOG(LogLevel::Display, " - super chain: %.2f ms (%.1f ns per check)", ChainMs, NumChecks > 0 ? ChainMs * 1e6 / NumChecks : 0.0);
+    UE_LOG(LogLevel::Display, " - interval: %.2f ms (%.1f ns per check, %.1fx)", IntervalMs, NumChecks > 0 ? IntervalMs * 1e6 / NumChecks : 0.0,
+        IntervalMs > 0.0 ? ChainMs / IntervalMs : 0.0);
+}
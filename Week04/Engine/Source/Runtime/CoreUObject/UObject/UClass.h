@@ -1,6 +1,8 @@
 #pragma once
+#include <atomic>
 #include <concepts>
 #include "Object.h"
+#include "ObjectPool.h"
 
 /**
  * UObject의 RTTI를 가지고 있는 클래스
@@ -20,9 +22,29 @@ public:
     uint32 GetClassSize() const { return ClassSize; }
     uint32 GetClassAlignment() const { return ClassAlignment; }
 
-    /** SomeBase의 자식 클래스인지 확인합니다. */
+    /**
+     * 이 클래스 객체의 메모리를 클래스 전용 풀에서 할당합니다. DECLARE_CLASS의 operator new가 호출합니다.
+     * Size가 ClassSize와 다르면(DECLARE_CLASS 없이 상속한 클래스) 힙에서 할당합니다.
+     */
+    void* AllocateObject(size_t Size);
+
+    /** AllocateObject로 받은 메모리를 돌려줍니다. Size는 AllocateObject에 넘긴 값과 같아야 함 */
+    void FreeObject(void* Object, size_t Size);
+
+    const FObjectPool& GetObjectPool() const { return ObjectPool; }
+
+    /**
+     * SomeBase의 자식 클래스인지 확인합니다.
+     * 클래스 트리의 DFS 번호로 비교하므로 상속 깊이와 상관없이 정수 비교 두 번입니다.
+     */
     bool IsChildOf(const UClass* SomeBase) const;
 
+    /** 부모를 따라 올라가며 확인합니다. 번호를 다시 매기는 중에 쓰며, 벤치마크의 비교 대상 */
+    bool IsChildOfBySuperChain(const UClass* SomeBase) const;
+
+    /** Objects의 각 객체가 Classes의 각 클래스인지 NumPasses번 확인하면서 부모를 따라가는 방식과 DFS 번호 방식의 시간을 비교합니다. */
+    static void RunCastBenchmark(const TArray<UObject*>& Objects, const TArray<UClass*>& Classes, int32 NumPasses = 100);
+
     template <typename T>
         requires std::derived_from<T, UObject>
     bool IsChildOf() const
@@ -62,4 +84,43 @@ private:
     UClass* SuperClass = nullptr;
 
     UObject* ClassDefaultObject = nullptr;
+
+    /** 클래스 트리에 연결하고 모든 클래스의 번호를 다시 매깁니다. 생성자에서 호출 */
+    void LinkIntoClassTree();
+
+    /** 번호를 다시 매길 때 쓰는 자식 목록. 등록 잠금 안에서만 바뀜 */
+    TArray<UClass*> ChildClasses;
+
+    /**
+     * 클래스 트리의 DFS 번호. PreIndex는 들어갈 때 매기고, PostIndex는 나올 때 서브트리에서 가장 큰 PreIndex로 정함.
+     * 자손의 PreIndex는 [PreIndex, PostIndex] 안에 들어감
+     */
+    std::atomic<uint32> ClassTreePreIndex = 0;
+    std::atomic<uint32> ClassTreePostIndex = 0;
+
+    /** 번호를 다시 매길 때마다 2씩 올라감. 홀수면 매기는 중 */
+    static std::atomic<uint32> ClassTreeVersion;
+
+    FObjectPool ObjectPool;
 };
+
+inline bool UClass::IsChildOf(const UClass* SomeBase) const
+{
+    if (!SomeBase) return false;
+
+    // 다른 스레드가 번호를 다시 매기는 중이었으면 번호가 섞였을 수 있으므로 부모를 따라가서 확인
+    const uint32 Version = ClassTreeVersion.load(std::memory_order_acquire);
+    if ((Version & 1) == 0)
+    {
+        const uint32 Index = ClassTreePreIndex.load(std::memory_order_relaxed);
+        const bool bResult = SomeBase->ClassTreePreIndex.load(std::memory_order_relaxed) <= Index
+            && Index <= SomeBase->ClassTreePostIndex.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (ClassTreeVersion.load(std::memory_order_relaxed) == Version)
+        {
+            return bResult;
+        }
+    }
+    return IsChildOfBySuperChain(SomeBase);
+}
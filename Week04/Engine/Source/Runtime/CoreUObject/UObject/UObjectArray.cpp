@@ -1,28 +1,85 @@
 ﻿#include "UObjectArray.h"
+#include <cassert>
 #include "Object.h"
 #include "UObjectHash.h"
 
 
+FUObjectArray::~FUObjectArray()
+{
+    for (FUObjectItem* Chunk : Chunks)
+    {
+        delete[] Chunk;
+    }
+}
+
 void FUObjectArray::AddObject(UObject* Object)
 {
-    ObjObjects.Add(Object);
+    int32 Index;
+    if (FreeIndices.Num() > 0)
+    {
+        Index = FreeIndices[FreeIndices.Num() - 1];
+        FreeIndices.RemoveAt(FreeIndices.Num() - 1);
+    }
+    else
+    {
+        Index = NumElements++;
+        if (Index / ChunkSize == Chunks.Num())
+        {
+            Chunks.Add(new FUObjectItem[ChunkSize]);
+        }
+    }
+
+    FUObjectItem* Item = IndexToObject(Index);
+    Item->Object = Object;
+    Item->bPendingKill = false;
+    Object->InternalIndex = Index;
+
     AddToClassMap(Object);
 }
 
 void FUObjectArray::MarkRemoveObject(UObject* Object)
 {
-    ObjObjects.Remove(Object);
+    // 배열에 넣지 않은 객체이거나 이미 표시한 객체
+    FUObjectItem* Item = IndexToObject(static_cast<int32>(Object->InternalIndex));
+    if (!Item || Item->Object != Object || Item->bPendingKill)
+    {
+        return;
+    }
+
+    Item->bPendingKill = true;
     RemoveFromClassMap(Object);  // UObjectHashTable에서 Object를 제외
-    PendingDestroyObjects.AddUnique(Object);
+    PendingDestroyObjects.Add(Object);
 }
 
 void FUObjectArray::ProcessPendingDestroyObjects()
 {
-    for (UObject* Object : PendingDestroyObjects)
+    // 소멸자에서 다른 객체를 제거 표시할 수 있으므로 인덱스로 순회
+    for (int32 i = 0; i < PendingDestroyObjects.Num(); ++i)
     {
+        UObject* Object = PendingDestroyObjects[i];
+        const int32 Index = static_cast<int32>(Object->InternalIndex);
+
+        FUObjectItem* Item = IndexToObject(Index);
+        assert(Item && Item->Object == Object);
+        Item->Object = nullptr;
+        Item->bPendingKill = false;
+        ++Item->SerialNumber;
+        FreeIndices.Add(Index);
+
         delete Object;
     }
     PendingDestroyObjects.Empty();
 }
 
+bool FUObjectArray::IsValid(const UObject* Object) const
+{
+    if (!Object)
+    {
+        return false;
+    }
+
+    const FUObjectItem* Item = IndexToObject(static_cast<int32>(Object->GetInternalIndex()));
+    return Item && Item->Object == Object && !Item->bPendingKill;
+}
+
 FUObjectArray GUObjectArray;
@@ -1,31 +1,83 @@
 ﻿#pragma once
 #include "Container/Array.h"
-#include "Container/Set.h"
+#include "Core/HAL/PlatformType.h"
 
 class UClass;
 class UObject;
 
 
+/** GUObjectArray의 슬롯 하나 */
+struct FUObjectItem
+{
+    UObject* Object = nullptr;
+
+    /** 슬롯을 비울 때마다 올라가는 세대 번호. 약한 참조가 같은 자리에 새로 들어온 객체를 구분하는 데 씀 */
+    int32 SerialNumber = 0;
+
+    /** 클래스별 객체 목록(FClassObjects::Objects)에서의 위치. 목록에서 지울 때 씀 */
+    int32 ClassHashIndex = -1;
+
+    /** MarkRemoveObject 후 ProcessPendingDestroyObjects 전. 아직 메모리는 있지만 살아 있는 객체로 치지 않음 */
+    bool bPendingKill = false;
+
+    bool IsLive() const { return Object && !bPendingKill; }
+};
+
+
+/**
+ * 모든 UObject를 담는 슬롯 맵. 객체는 생성될 때 슬롯 하나를 받고 그 인덱스가 InternalIndex가 됩니다.
+ * 슬롯은 ChunkSize개씩 청크로 잡아서 주소가 바뀌지 않고, 지운 객체의 슬롯은 세대 번호를 올린 뒤 재사용합니다.
+ * 인덱스로 바로 찾으므로 추가, 제거 표시, 유효성 확인 모두 O(1)이고, 순회는 청크를 앞에서부터 읽음
+ */
 class FUObjectArray
 {
 public:
+    FUObjectArray() = default;
+    ~FUObjectArray();
+
+    FUObjectArray(const FUObjectArray&) = delete;
+    FUObjectArray& operator=(const FUObjectArray&) = delete;
+
+    /** 빈 슬롯에 Object를 넣고 InternalIndex를 정합니다. */
     void AddObject(UObject* Object);
+
+    /** 다음 ProcessPendingDestroyObjects에서 지우도록 표시합니다. 이미 표시한 객체는 무시 */
     void MarkRemoveObject(UObject* Object);
 
     void ProcessPendingDestroyObjects();
 
-    TSet<UObject*>& GetObjectItemArrayUnsafe()
+    /**
+     * Object가 이 배열에 있고 제거 표시가 없는지 확인합니다.
+     * @note Object의 InternalIndex를 읽으므로 이미 delete된 포인터에는 쓸 수 없음. 그런 경우는 FWeakObjectPtr 사용
+     */
+    bool IsValid(const UObject* Object) const;
+
+    /** 한 번이라도 쓴 슬롯 수. 인덱스는 이보다 작음 */
+    int32 GetObjectArrayNum() const { return NumElements; }
+
+    /** 살아 있거나 제거를 기다리는 객체 수 */
+    int32 GetObjectArrayNumMinusAvailable() const { return NumElements - FreeIndices.Num(); }
+
+    FUObjectItem* IndexToObject(int32 Index)
     {
-        return ObjObjects;
+        return Index >= 0 && Index < NumElements ? &Chunks[Index / ChunkSize][Index % ChunkSize] : nullptr;
     }
 
-    const TSet<UObject*>& GetObjectItemArrayUnsafe() const
+    const FUObjectItem* IndexToObject(int32 Index) const
     {
-        return ObjObjects;
+        return Index >= 0 && Index < NumElements ? &Chunks[Index / ChunkSize][Index % ChunkSize] : nullptr;
     }
 
+    /** 청크 하나의 슬롯 수. 슬롯이 24바이트라 청크 하나가 1.5MB */
+    static constexpr int32 ChunkSize = 64 * 1024;
+
 private:
-    TSet<UObject*> ObjObjects;
+    TArray<FUObjectItem*> Chunks;
+    int32 NumElements = 0;
+
+    /** 비어 있는 슬롯 인덱스. 마지막에 비운 슬롯부터 재사용 */
+    TArray<int32> FreeIndices;
+
     TArray<UObject*> PendingDestroyObjects;
 };
 
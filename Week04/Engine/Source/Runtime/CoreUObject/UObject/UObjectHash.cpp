@@ -2,8 +2,11 @@
 #include <cassert>
 #include "Object.h"
 #include "UClass.h"
+#include "UObjectArray.h"
+#include "ObjectFactory.h"
+#include "UObjectIterator.h"
+#include "FWindowsPlatformTime.h"
 #include "Container/Map.h"
-#include "Container/Set.h"
 
 /**
  * 모든 UObject의 정보를 담고 있는 HashTable
@@ -16,96 +19,122 @@ struct FUObjectHashTables
         return Singleton;
     }
 
-    TMap<UClass*, TSet<UClass*>> ClassToChildListMap;
-    TMap<UClass*, TSet<UObject*>> ClassToObjectListMap;
+    /** 노드 기반 맵이라 값의 주소가 바뀌지 않으므로 DerivedClassObjects에 포인터로 넣음 */
+    TMap<const UClass*, FClassObjects> ClassToObjectListMap;
 };
 
-/** Helper function that returns all the children of the specified class recursively */
-template <typename ClassType, typename ArrayAllocator>
-static void RecursivelyPopulateDerivedClasses(FUObjectHashTables& ThreadHash, const UClass* ParentClass, TArray<ClassType, ArrayAllocator>& OutAllDerivedClass)
+FClassObjects& GetClassObjects(const UClass* Class)
 {
-    // Start search with the parent class at virtual index Num-1, then continue searching from index Num as things are added
-    int32 SearchIndex = OutAllDerivedClass.Num() - 1;
-    const UClass* SearchClass = ParentClass;
+    assert(Class);
+    FUObjectHashTables& HashTable = FUObjectHashTables::Get();
 
-    while (true)
+    if (FClassObjects* ClassObjects = HashTable.ClassToObjectListMap.Find(Class))
     {
-        if (TSet<UClass*>* ChildSet = ThreadHash.ClassToChildListMap.Find(const_cast<UClass*>(SearchClass)))
-        {
-            OutAllDerivedClass.Reserve(OutAllDerivedClass.Num() + ChildSet->Num());
-            for (UClass* ChildClass : *ChildSet)
-            {
-                OutAllDerivedClass.Add(ChildClass);
-            }
-        }
+        return *ClassObjects;
+    }
 
-        // Now search at next index, if it has been filled in by code above
-        ++SearchIndex;
+    FClassObjects& NewClassObjects = HashTable.ClassToObjectListMap.FindOrAdd(Class);
+    NewClassObjects.DerivedClassObjects.Add(&NewClassObjects);
 
-        if (SearchIndex < OutAllDerivedClass.Num())
-        {
-            SearchClass = OutAllDerivedClass[SearchIndex];			
-        }
-        else
-        {
-            return;
-        }
+    // 조상의 목록도 없으면 재귀로 만들어지므로, 조상마다 한 번씩만 추가됨
+    for (const UClass* SuperClass = Class->GetSuperClass(); SuperClass; SuperClass = SuperClass->GetSuperClass())
+    {
+        GetClassObjects(SuperClass).DerivedClassObjects.Add(&NewClassObjects);
     }
+    return NewClassObjects;
 }
 
 void AddToClassMap(UObject* Object)
 {
     assert(Object->GetClass());
-    FUObjectHashTables& HashTable = FUObjectHashTables::Get();
+    FUObjectItem* Item = GUObjectArray.IndexToObject(static_cast<int32>(Object->GetInternalIndex()));
+    assert(Item && Item->Object == Object);
 
-    UClass* Class = Object->GetClass();
-    HashTable.ClassToObjectListMap.FindOrAdd(Class).Add(Object);
-
-    for (UClass* SuperClass = Class->GetSuperClass(); SuperClass;)
-    {
-        HashTable.ClassToChildListMap.FindOrAdd(SuperClass).Add(Class);
-    
-        Class = SuperClass;
-        SuperClass = SuperClass->GetSuperClass();
-    }
+    Item->ClassHashIndex = GetClassObjects(Object->GetClass()).Objects.Add(Object);
 }
 
 void RemoveFromClassMap(UObject* Object)
 {
     assert(Object->GetClass());
-    FUObjectHashTables& HashTable = FUObjectHashTables::Get();
+    FUObjectItem* Item = GUObjectArray.IndexToObject(static_cast<int32>(Object->GetInternalIndex()));
+    assert(Item && Item->Object == Object);
 
-    TSet<UObject*>& ObjectSet = HashTable.ClassToObjectListMap.FindOrAdd(Object->GetClass());
-    int32 NumRemoved = ObjectSet.Remove(Object);
+    TArray<UObject*>& Objects = GetClassObjects(Object->GetClass()).Objects;
+    const int32 Index = Item->ClassHashIndex;
+    assert(Objects[Index] == Object);
 
-    if (NumRemoved == 0)
+    // 마지막 객체를 빈자리로 옮기고 그 객체의 역참조를 고침
+    Objects.RemoveAtSwap(Index);
+    if (Index < static_cast<int32>(Objects.Num()))
     {
-        HashTable.ClassToObjectListMap.Remove(Object->GetClass());
+        GUObjectArray.IndexToObject(static_cast<int32>(Objects[Index]->GetInternalIndex()))->ClassHashIndex = Index;
     }
+    Item->ClassHashIndex = -1;
 }
 
 void GetObjectsOfClass(const UClass* ClassToLookFor, TArray<UObject*>& Results, bool bIncludeDerivedClasses)
 {
-    // Most classes searched for have around 10 subclasses, some have hundreds
-    TArray<const UClass*> ClassesToSearch;
-    ClassesToSearch.Add(ClassToLookFor);
+    const TArray<FClassObjects*>& ClassesToSearch = GetClassObjects(ClassToLookFor).DerivedClassObjects;
+    const uint32 NumClasses = bIncludeDerivedClasses ? ClassesToSearch.Num() : 1;
+
+    for (uint32 i = 0; i < NumClasses; ++i)
+    {
+        for (UObject* Object : ClassesToSearch[i]->Objects)
+        {
+            Results.Add(Object);
+        }
+    }
+}
+
+void BenchmarkObjectIteration(uint32 NumObjects)
+{
+    constexpr int32 NumIterations = 10;
 
-    FUObjectHashTables& ThreadHash = FUObjectHashTables::Get();
+    TArray<UObject*> Objects;
+    Objects.Reserve(NumObjects);
 
-    if (bIncludeDerivedClasses)
+    uint64 StartCycles = FPlatformTime::Cycles64();
+    for (uint32 i = 0; i < NumObjects; ++i)
     {
-        RecursivelyPopulateDerivedClasses(ThreadHash, ClassToLookFor, ClassesToSearch);
+        Objects.Add(FObjectFactory::ConstructUnnamedObject<UObject>());
     }
+    const double AddMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
 
+    // 예전 TObjectIterator처럼 매번 배열에 복사한 뒤 순회
+    uint64 Checksum = 0;
+    StartCycles = FPlatformTime::Cycles64();
+    for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+    {
+        TArray<UObject*> Results;
+        GetObjectsOfClass(UObject::StaticClass(), Results, true);
+        for (UObject* Object : Results)
+        {
+            Checksum += Object->GetInternalIndex();
+        }
+    }
+    const double CopyMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles) / NumIterations;
 
-    for (const UClass* SearchClass : ClassesToSearch)
+    StartCycles = FPlatformTime::Cycles64();
+    for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
     {
-        if (TSet<UObject*>* List = ThreadHash.ClassToObjectListMap.Find(const_cast<UClass*>(SearchClass)))
+        for (UObject* Object : TObjectRange<UObject>())
         {
-            for (const auto& Object : *List)
-            {
-                Results.Add(Object);
-            }
+            Checksum -= Object->GetInternalIndex();
         }
     }
+    const double RangeMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles) / NumIterations;
+
+    // 빈자리가 생길 때마다 옮기도록 앞에서부터 지움
+    StartCycles = FPlatformTime::Cycles64();
+    for (UObject* Object : Objects)
+    {
+        GUObjectArray.MarkRemoveObject(Object);
+    }
+    GUObjectArray.ProcessPendingDestroyObjects();
+    const double RemoveMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+    UE_LOG(LogLevel::Display, "Object iteration benchmark: %u objects (%s)", NumObjects, Checksum == 0 ? "match" : "MISMATCH");
+    UE_LOG(LogLevel::Display, " - add: %.2f ms, remove: %.2f ms", AddMs, RemoveMs);
+    UE_LOG(LogLevel::Display, " - GetObjectsOfClass copy: %.3f ms per pass", CopyMs);
+    UE_LOG(LogLevel::Display, " - TObjectRange in place: %.3f ms per pass (%.1fx)", RangeMs, RangeMs > 0.0 ? CopyMs / RangeMs : 0.0);
 }
@@ -4,6 +4,22 @@
 class UObject;
 class UClass;
 
+/** 한 클래스의 객체 목록. 파생 클래스의 객체는 그 클래스의 목록에 있음 */
+struct FClassObjects
+{
+    /** 순서 없이 빽빽하게 모은 객체. 지울 때 마지막 객체를 그 자리로 옮김 */
+    TArray<UObject*> Objects;
+
+    /** 자신과 모든 파생 클래스의 목록. 자신이 맨 앞이고, 새 클래스의 객체가 처음 생길 때 조상들의 목록에 추가됨 */
+    TArray<FClassObjects*> DerivedClassObjects;
+};
+
+/**
+ * Class의 객체 목록을 반환합니다. 없으면 만들어서 조상 클래스들의 목록에 연결합니다.
+ * 반환한 참조는 프로그램이 끝날 때까지 유효합니다.
+ */
+FClassObjects& GetClassObjects(const UClass* Class);
+
 /**
  * ClassToLookFor와 일치하는 UObject를 반환합니다.
  * @param ClassToLookFor 반환할 Object의 Class정보
@@ -17,3 +33,6 @@ void AddToClassMap(UObject* Object);
 
 /** FUObjectHashTables에 저장된 Object정보를 제거합니다. */
 void RemoveFromClassMap(UObject* Object);
+
+/** NumObjects개의 UObject를 만들어서 추가, 복사 순회(GetObjectsOfClass), 제자리 순회(TObjectRange), 제거 시간을 잽니다. */
+void BenchmarkObjectIteration(uint32 NumObjects = 1000000);
@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "Object.h"
 #include "UObjectHash.h"
+#include "UObjectArray.h"
 #include "Container/Array.h"
 
 #undef GetObject // Windows.h 이름 겹침
@@ -8,8 +9,10 @@
 
 /**
  * 특정 타입의 UObject 인스턴스를 순회하기 위한 반복자 클래스입니다.
+ * 클래스별 객체 목록(FClassObjects)을 복사하지 않고 그 자리에서 차례로 읽습니다.
  * 
  * @tparam T 순회할 UObject 타입 또는 그 파생 클래스
+ * @note 순회 중에 T 타입 객체를 지우면 마지막 객체가 그 자리로 옮겨져서 건너뛸 수 있음
  */
 template <typename T>
     requires std::derived_from<T, UObject>
@@ -23,15 +26,20 @@ public:
 
     /** Begin 생성자 */
     explicit TObjectIterator(bool bIncludeDerivedClasses = true)
-        : Index(-1)
+        : ClassesToSearch(&GetClassObjects(T::StaticClass()).DerivedClassObjects)
+        , NumClasses(bIncludeDerivedClasses ? ClassesToSearch->Num() : 1)
+        , ClassIndex(0)
+        , Index(-1)
     {
-        GetObjectsOfClass(T::StaticClass(), ObjectArray, bIncludeDerivedClasses);
         Advance();
     }
 
     /** End 생성자 */
     TObjectIterator(EEndTagType, const TObjectIterator& Begin)
-        : Index(Begin.ObjectArray.Num())
+        : ClassesToSearch(Begin.ClassesToSearch)
+        , NumClasses(Begin.NumClasses)
+        , ClassIndex(Begin.NumClasses)
+        , Index(-1)
     {
     }
 
@@ -50,30 +58,34 @@ public:
         return (T*)GetObject();
     }
 
-    FORCEINLINE bool operator==(const TObjectIterator& Rhs) const { return Index == Rhs.Index; }
-    FORCEINLINE bool operator!=(const TObjectIterator& Rhs) const { return Index != Rhs.Index; }
+    FORCEINLINE bool operator==(const TObjectIterator& Rhs) const { return ClassIndex == Rhs.ClassIndex && Index == Rhs.Index; }
+    FORCEINLINE bool operator!=(const TObjectIterator& Rhs) const { return !(*this == Rhs); }
 
 protected:
     UObject* GetObject() const 
     { 
-        return ObjectArray[Index];
+        return (*ClassesToSearch)[ClassIndex]->Objects[Index];
     }
 
     bool Advance()
     {
-        while(++Index < ObjectArray.Num())
+        while (ClassIndex < NumClasses)
         {
-            if (GetObject())
+            if (++Index < static_cast<int32>((*ClassesToSearch)[ClassIndex]->Objects.Num()))
             {
                 return true;
             }
+            ++ClassIndex;
+            Index = -1;
         }
         return false;
     }
 
 protected:
-    /** Results from the GetObjectsOfClass query */
-    TArray<UObject*> ObjectArray;
+    /** T와 파생 클래스의 객체 목록. T의 목록이 맨 앞 */
+    const TArray<FClassObjects*>* ClassesToSearch;
+    int32 NumClasses;
+    int32 ClassIndex;
     int32 Index;
 };
 
@@ -98,3 +110,52 @@ struct TObjectRange
 
     TObjectIterator<T> Begin;
 };
+
+
+/**
+ * GUObjectArray의 슬롯을 앞에서부터 읽으며 살아 있는 모든 UObject를 순회합니다. 클래스를 가리지 않고 할당도 하지 않음
+ * @note 순회 중에 객체를 만들면 새 객체는 보일 수도, 안 보일 수도 있음
+ */
+class FRawObjectIterator
+{
+public:
+    FRawObjectIterator()
+        : Index(-1)
+    {
+        Advance();
+    }
+
+    FORCEINLINE void operator++()
+    {
+        Advance();
+    }
+
+    FORCEINLINE UObject* operator* () const
+    {
+        return GUObjectArray.IndexToObject(Index)->Object;
+    }
+
+    FORCEINLINE UObject* operator-> () const
+    {
+        return GUObjectArray.IndexToObject(Index)->Object;
+    }
+
+    FORCEINLINE explicit operator bool() const { return Index < GUObjectArray.GetObjectArrayNum(); }
+
+protected:
+    void Advance()
+    {
+        const int32 Num = GUObjectArray.GetObjectArrayNum();
+        while (++Index < Num)
+        {
+            // 청크 단위로 이어진 슬롯을 읽으므로 대부분 같은 캐시 라인 안에서 넘어감
+            if (GUObjectArray.IndexToObject(Index)->IsLive())
+            {
+                return;
+            }
+        }
+    }
+
+protected:
+    int32 Index;
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include <concepts>
+#include "Object.h"
+#include "UObjectArray.h"
+
+
+/**
+ * UObject를 GUObjectArray의 인덱스와 세대 번호로 가리키는 약한 참조.
+ * 객체가 지워지거나 제거 표시되면 Get이 nullptr을 돌려주고, 같은 슬롯에 다른 객체가 들어와도 세대 번호가 달라서 구분됩니다.
+ */
+struct FWeakObjectPtr
+{
+    FWeakObjectPtr() = default;
+
+    FWeakObjectPtr(const UObject* Object)
+    {
+        *this = Object;
+    }
+
+    FWeakObjectPtr& operator=(const UObject* Object)
+    {
+        const FUObjectItem* Item = Object ? GUObjectArray.IndexToObject(static_cast<int32>(Object->GetInternalIndex())) : nullptr;
+        if (Item && Item->Object == Object)
+        {
+            ObjectIndex = static_cast<int32>(Object->GetInternalIndex());
+            ObjectSerialNumber = Item->SerialNumber;
+        }
+        else
+        {
+            Reset();
+        }
+        return *this;
+    }
+
+    void Reset()
+    {
+        ObjectIndex = -1;
+        ObjectSerialNumber = 0;
+    }
+
+    UObject* Get() const
+    {
+        const FUObjectItem* Item = GUObjectArray.IndexToObject(ObjectIndex);
+        return Item && Item->SerialNumber == ObjectSerialNumber && Item->IsLive() ? Item->Object : nullptr;
+    }
+
+    bool IsValid() const { return Get() != nullptr; }
+
+    /** 한 번이라도 객체를 가리켰는데 지금은 없음 */
+    bool IsStale() const { return ObjectIndex >= 0 && !IsValid(); }
+
+    bool operator==(const FWeakObjectPtr& Other) const = default;
+
+private:
+    int32 ObjectIndex = -1;
+    int32 ObjectSerialNumber = 0;
+};
+
+
+template <typename T>
+    requires std::derived_from<T, UObject>
+struct TWeakObjectPtr : public FWeakObjectPtr
+{
+    TWeakObjectPtr() = default;
+
+    TWeakObjectPtr(const T* Object)
+        : FWeakObjectPtr(Object)
+    {
+    }
+
+    T* Get() const
+    {
+        return static_cast<T*>(FWeakObjectPtr::Get());
+    }
+
+    T* operator->() const { return Get(); }
+    explicit operator bool() const { return IsValid(); }
+};
@@ -208,13 +208,12 @@ void AEditorPlayer::PickActor(const FVector& pickPosition)
     float minDistance = FLT_MAX;
     TArray<UPrimitiveComponent*> Components;
     Frustum Frustum = GetEngine().GetLevelEditor()->GetActiveViewportClient()->GetFrustum();
-    FOctreeNode* Octree = GetWorld()->GetOctree();
     FMatrix ViewMatrix = GEngineLoop.GetLevelEditor()->GetActiveViewportClient()->GetViewMatrix();
     FMatrix InverseView = FMatrix::Inverse(ViewMatrix);
     FVector WorldPickPosition = InverseView.TransformPosition(pickPosition);
     FVector RayOrigin = GetEngine().GetLevelEditor()->GetActiveViewportClient()->ViewTransformPerspective.GetLocation();
     float nearValue = GetEngine().GetLevelEditor()->GetActiveViewportClient()->nearPlane;
-    Octree->QueryByRay(WorldPickPosition, RayOrigin, Components);
+    GetWorld()->QueryByRay(WorldPickPosition, RayOrigin, Components);
     for (const auto& comp : Components)
     {
         float dis = FLT_MAX;
@@ -1,4 +1,5 @@
 #include "StaticMesh.h"
+#include "Engine/DerivedDataCache.h"
 #include "Engine/FLoaderOBJ.h"
 #include "UObject/ObjectFactory.h"
 
@@ -43,20 +44,23 @@ void UStaticMesh::GetUsedMaterials(TArray<UMaterial*>& Out) const
 bool UStaticMesh::CheckRayIntersect(const FVector& PickPosition, const FVector& rayOrigin, float& HitDistance) const
 {
     const FVector rayDir = PickPosition - rayOrigin;
-    return MeshBVHNode->RayIntersectsBVH(rayOrigin, rayDir.Normalize(), HitDistance);
+    return MeshBVH.RayIntersects(rayOrigin, rayDir.Normalize(), HitDistance);
 }
 
 void UStaticMesh::SetData(OBJ::FStaticMeshRenderData* renderData)
 {
     staticMeshRenderData = renderData;
 
-    uint32 verticeNum = staticMeshRenderData->Vertices.Num();
+    // 쿡 파일에서 읽은 메시는 매핑된 메모리에서 바로 GPU 버퍼로 올라감. 압축 정점도 그대로 올리고 셰이더에서 풂
+    uint32 verticeNum = staticMeshRenderData->GetNumVertices();
     if (verticeNum <= 0) return;
-    staticMeshRenderData->VertexBuffer = GetEngine().Renderer.CreateVertexBuffer(staticMeshRenderData->Vertices, verticeNum * sizeof(FVertexSimple));
+    staticMeshRenderData->VertexBuffer = GetEngine().Renderer.CreateVertexBuffer(staticMeshRenderData->GetVertexBufferData(), verticeNum * staticMeshRenderData->GetVertexStride());
 
-    uint32 indexNum = staticMeshRenderData->Indices.Num();
-    if (indexNum > 0)
-        staticMeshRenderData->IndexBuffer = GetEngine().Renderer.CreateIndexBuffer(staticMeshRenderData->Indices, indexNum * sizeof(uint32));
+    // 인덱스 버퍼에는 LOD 인덱스까지 모두 올리고, BVH는 LOD0만 씀
+    const uint32 totalIndexNum = staticMeshRenderData->GetNumIndices();
+    if (totalIndexNum > 0)
+        staticMeshRenderData->IndexBuffer = GetEngine().Renderer.CreateIndexBuffer(staticMeshRenderData->GetIndexData(), totalIndexNum * sizeof(uint32));
+    uint32 indexNum = staticMeshRenderData->GetNumBaseIndices();
 
     for (int materialIndex = 0; materialIndex < staticMeshRenderData->Materials.Num(); materialIndex++) {
         FStaticMaterial* newMaterialSlot = new FStaticMaterial();
@@ -68,6 +72,34 @@ void UStaticMesh::SetData(OBJ::FStaticMeshRenderData* renderData)
         materials.Add(newMaterialSlot);
     }
 
-    MeshBVHNode = new FBVHNode(staticMeshRenderData->BoundingBoxMin, staticMeshRenderData->BoundingBoxMax);
-    MeshBVHNode->CreateVertexBVH(renderData->Vertices, 0, 20);
+    // DDC를 거친 메시는 BVH도 쿡 결과의 키로 찾아서 빌드를 건너뜀
+    FContentHash BVHKey;
+    if (!staticMeshRenderData->DerivedDataKey.IsZero())
+    {
+        BVHKey = FDerivedDataCache::MakeKey(EDerivedDataType::MeshBVH, FTriangleBVH::CookVersion, staticMeshRenderData->DerivedDataKey);
+        TArray<uint8> CachedBVH;
+        if (FDerivedDataCache::Get(EDerivedDataType::MeshBVH, BVHKey, CachedBVH) && MeshBVH.Deserialize(CachedBVH.GetData(), CachedBVH.Num()))
+        {
+            return;
+        }
+    }
+
+    if (staticMeshRenderData->IsCompact())
+    {
+        // BVH는 삼각형 정점을 따로 복사해 두므로 풀어 놓은 정점은 빌드가 끝나면 버림
+        TArray<FVertexSimple> DecodedVertices;
+        staticMeshRenderData->DecodeVertices(DecodedVertices);
+        MeshBVH.Build(DecodedVertices.GetData(), verticeNum, staticMeshRenderData->GetIndexData(), indexNum);
+    }
+    else
+    {
+        MeshBVH.Build(staticMeshRenderData->GetVertexData(), verticeNum, staticMeshRenderData->GetIndexData(), indexNum);
+    }
+
+    if (!BVHKey.IsZero())
+    {
+        TArray<uint8> CachedBVH;
+        MeshBVH.Serialize(CachedBVH);
+        FDerivedDataCache::Put(EDerivedDataType::MeshBVH, BVHKey, CachedBVH.GetData(), CachedBVH.Num());
+    }
 }
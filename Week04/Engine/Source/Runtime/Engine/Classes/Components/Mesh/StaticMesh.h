@@ -17,11 +17,21 @@ public:
     void GetUsedMaterials(TArray<UMaterial*>& Out) const;
     OBJ::FStaticMeshRenderData* GetRenderData() const { return staticMeshRenderData; }
 
+    /** 메시 로컬 공간의 레이로 삼각형 BVH를 검사합니다. HitDistance는 rayOrigin에서 가장 가까운 삼각형까지의 거리 */
     bool CheckRayIntersect(const FVector& PickPosition, const FVector& rayOrigin, float& HitDistance) const;
 
+    const FTriangleBVH& GetBVH() const { return MeshBVH; }
+
     void SetData(OBJ::FStaticMeshRenderData* renderData);
+
+    /** FRenderer가 정렬 키에 쓰는 메시 ID. 음수면 아직 등록 전 */
+    int32 DrawMeshId = -1;
+
+    /** 서브메시(MaterialSubsets)마다 FRenderer가 정렬 키에 쓰는 머티리얼 ID */
+    TArray<uint32> DrawMaterialIds;
+
 private:
     OBJ::FStaticMeshRenderData* staticMeshRenderData = nullptr;
     TArray<FStaticMaterial*> materials;
-    FBVHNode* MeshBVHNode;
+    FTriangleBVH MeshBVH;
 };
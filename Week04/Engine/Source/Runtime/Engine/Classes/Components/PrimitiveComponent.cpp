@@ -1,5 +1,7 @@
 #include "PrimitiveComponent.h"
 #include "Core/Math/MathUtility.h"
+#include "World.h"
+#include "OctreeNode.h"
 
 UPrimitiveComponent::UPrimitiveComponent()
 {
@@ -157,3 +159,13 @@ FBoundingBox UPrimitiveComponent::GetWorldBoundingBox()
     bIsWorldBoundBoxInitialized = true;
     return WorldAABB;
 }
+
+void UPrimitiveComponent::MarkBoundsDirty()
+{
+    bIsWorldBoundBoxInitialized = false;
+
+    if (UWorld* World = GetWorld())
+    {
+        World->MarkOctreeDirty(this);
+    }
+}
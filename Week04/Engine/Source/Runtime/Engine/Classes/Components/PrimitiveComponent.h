@@ -1,6 +1,8 @@
 #pragma once
 #include "Engine/Source/Runtime/Engine/Classes/Components/SceneComponent.h"
 
+struct FOctreeNode;
+
 class UPrimitiveComponent : public USceneComponent
 {
     DECLARE_CLASS(UPrimitiveComponent, USceneComponent)
@@ -19,6 +21,9 @@ public:
     FBoundingBox LocalAABB;
     FBoundingBox WorldAABB;
 
+    /** 이 컴포넌트가 들어있는 옥트리 리프 노드들. FOctreeNode가 Insert/Remove 시 관리합니다. */
+    TArray<FOctreeNode*> OctreeNodes;
+
 private:
     FString m_Type;
     bool bIsWorldBoundBoxInitialized;
@@ -34,5 +39,8 @@ public:
     FBoundingBox GetBoundingBox();
 
     FBoundingBox GetWorldBoundingBox();
+
+    /** 트랜스폼이나 메시가 바뀌었을 때 호출. 월드 AABB 캐시를 비우고 World의 옥트리 갱신 대기열에 등록합니다. */
+    void MarkBoundsDirty();
 };
 
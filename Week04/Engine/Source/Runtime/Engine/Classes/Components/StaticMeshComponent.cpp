@@ -1,9 +1,11 @@
 #include "Components/StaticMeshComponent.h"
 
 #include "World.h"
+#include "Engine/FLoaderOBJ.h"
 #include "Launch/EngineLoop.h"
 #include "Math/JungleMath.h"
 #include "UObject/ObjectFactory.h"
+#include "UObject/WeakObjectPtr.h"
 #include "UnrealEd/PrimitiveBatch.h"
 
 
@@ -12,6 +14,7 @@ void UStaticMeshComponent::SetLocation(FVector _newLoc)
     UMeshComponent::SetLocation(_newLoc);
 
     W04WorldMatrix = JungleMath::CreateModelMatrix(GetWorldLocation(), GetWorldRotation(), GetWorldScale());
+    MarkBoundsDirty();
 }
 
 void UStaticMeshComponent::SetRotation(FVector _newRot)
@@ -19,6 +22,7 @@ void UStaticMeshComponent::SetRotation(FVector _newRot)
     UMeshComponent::SetRotation(_newRot);
 
     W04WorldMatrix = JungleMath::CreateModelMatrix(GetWorldLocation(), GetWorldRotation(), GetWorldScale());
+    MarkBoundsDirty();
 }
 
 void UStaticMeshComponent::SetRotation(FQuat _newRot)
@@ -26,6 +30,7 @@ void UStaticMeshComponent::SetRotation(FQuat _newRot)
     UMeshComponent::SetRotation(_newRot);
 
     W04WorldMatrix = JungleMath::CreateModelMatrix(GetWorldLocation(), GetWorldRotation(), GetWorldScale());
+    MarkBoundsDirty();
 }
 
 void UStaticMeshComponent::SetScale(FVector _newScale)
@@ -33,6 +38,30 @@ void UStaticMeshComponent::SetScale(FVector _newScale)
     UMeshComponent::SetScale(_newScale);
 
     W04WorldMatrix = JungleMath::CreateModelMatrix(GetWorldLocation(), GetWorldRotation(), GetWorldScale());
+    MarkBoundsDirty();
+}
+
+void UStaticMeshComponent::SetStaticMeshAsync(const FString& Path, EAsyncLoadPriority Priority)
+{
+    SetStaticMesh(FManagerOBJ::GetPlaceholderStaticMesh());
+
+    // 콜백이 올 때 이 컴포넌트가 지워졌을 수 있으므로 포인터 대신 약한 참조와 순번으로 확인
+    const uint32 RequestSerial = MeshLoadSerial;
+    const TWeakObjectPtr<UStaticMeshComponent> WeakThis(this);
+    FOnStaticMeshLoaded OnLoaded;
+    OnLoaded.BindLambda([WeakThis, RequestSerial](UStaticMesh* LoadedMesh)
+    {
+        UStaticMeshComponent* This = WeakThis.Get();
+        if (LoadedMesh == nullptr || This == nullptr)
+        {
+            return;
+        }
+        if (This->MeshLoadSerial == RequestSerial)
+        {
+            This->SetStaticMesh(LoadedMesh);
+        }
+    });
+    FManagerOBJ::CreateStaticMeshAsync(Path, Priority, OnLoaded);
 }
 
 uint32 UStaticMeshComponent::GetNumMaterials() const
@@ -100,13 +129,11 @@ int UStaticMeshComponent::CheckRayIntersection(FVector& rayOrigin, FVector& rayD
 
     OBJ::FStaticMeshRenderData* renderData = staticMesh->GetRenderData();
 
-    FVertexSimple* vertices = renderData->Vertices.GetData();
-    int vCount = renderData->Vertices.Num();
-    UINT* indices = renderData->Indices.GetData();
-    int iCount = renderData->Indices.Num();
+    int vCount = renderData->GetNumVertices();
+    const UINT* indices = renderData->GetIndexData();
+    int iCount = renderData->GetNumBaseIndices();
 
-    if (!vertices) return 0;
-    BYTE* pbPositions = reinterpret_cast<BYTE*>(renderData->Vertices.GetData());
+    if (vCount == 0) return 0;
 
     int nPrimitives = (!indices) ? (vCount / 3) : (iCount / 3);
     float fNearHitDistance = FLT_MAX;
@@ -123,11 +150,10 @@ int UStaticMeshComponent::CheckRayIntersection(FVector& rayOrigin, FVector& rayD
             idx1 = indices[i * 3 + 2];
         }
 
-        // 각 삼각형의 버텍스 위치를 FVector로 불러옵니다.
-        uint32 stride = sizeof(FVertexSimple);
-        FVector v0 = *reinterpret_cast<FVector*>(pbPositions + idx0 * stride);
-        FVector v1 = *reinterpret_cast<FVector*>(pbPositions + idx1 * stride);
-        FVector v2 = *reinterpret_cast<FVector*>(pbPositions + idx2 * stride);
+        // 각 삼각형의 버텍스 위치를 FVector로 불러옵니다. 압축 정점이면 풀어서 가져옵니다.
+        FVector v0 = renderData->GetVertexPosition(idx0);
+        FVector v1 = renderData->GetVertexPosition(idx1);
+        FVector v2 = renderData->GetVertexPosition(idx2);
 
         float fHitDistance;
         if (IntersectRayTriangle(rayOrigin, rayDirection, v0, v1, v2, fHitDistance)) {
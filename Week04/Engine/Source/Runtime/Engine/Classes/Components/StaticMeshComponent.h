@@ -1,6 +1,7 @@
 #pragma once
 #include "Components/MeshComponent.h"
 #include "Mesh/StaticMesh.h"
+#include "Engine/AsyncLoader.h"
 
 class UStaticMeshComponent : public UMeshComponent
 {
@@ -28,17 +29,33 @@ public:
     UStaticMesh* GetStaticMesh() const { return staticMesh; }
     void SetStaticMesh(UStaticMesh* value)
     { 
+        // 아직 도착하지 않은 SetStaticMeshAsync 결과는 버림
+        ++MeshLoadSerial;
         staticMesh = value;
+        LODIndex = 0;
         OverrideMaterials.SetNum(value->GetMaterials().Num());
         LocalAABB = FBoundingBox(staticMesh->GetRenderData()->BoundingBoxMin, staticMesh->GetRenderData()->BoundingBoxMax);
+        MarkBoundsDirty();
     }
 
+    /**
+     * Path의 메시를 FAsyncLoader로 읽습니다. 다 읽을 때까지는 FManagerOBJ::GetPlaceholderStaticMesh를 그리다가 도착하면 바꿉니다.
+     * 그 사이에 SetStaticMesh나 SetStaticMeshAsync를 다시 호출했거나 컴포넌트가 지워졌으면 결과를 버립니다.
+     */
+    void SetStaticMeshAsync(const FString& Path, EAsyncLoadPriority Priority = EAsyncLoadPriority::Normal);
+
     FMatrix GetWorldMatrix() const { return W04WorldMatrix; }
     void SetWorldMatrix(const FMatrix& value) { W04WorldMatrix = value; }
 
+    /** [렌더러] 직전 프레임에 그린 LOD. FRenderer가 컬링 중에 쓰고 LOD 히스테리시스에 사용 */
+    uint8 LODIndex = 0;
+
 protected:
     UStaticMesh* staticMesh = nullptr;
     int selectedSubMeshIndex = -1;
 
+    /** SetStaticMesh마다 1씩 늘어남. 비동기 로딩 콜백이 자기 요청이 마지막인지 확인할 때 사용 */
+    uint32 MeshLoadSerial = 0;
+
     FMatrix W04WorldMatrix;
 };
\ No newline at end of file
@@ -0,0 +1,407 @@
+#include "AsyncLoader.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "FWindowsPlatformTime.h"
+#include "Math/MathUtility.h"
+#include "Engine/FLoaderOBJ.h"
+#include "Engine/ResourceMgr.h"
+#include "Launch/EngineLoop.h"
+
+namespace
+{
+    enum class EAsyncLoadType : uint8
+    {
+        StaticMesh,
+        Texture,
+    };
+
+    struct FAsyncLoadRequest
+    {
+        uint32 RequestId = 0;
+        EAsyncLoadType Type = EAsyncLoadType::StaticMesh;
+        FString MeshPath;
+        FWString TexturePath;
+
+        /** QueueMutex를 잡고 읽고 씀 */
+        EAsyncLoadPriority Priority = EAsyncLoadPriority::Normal;
+
+        /** 같은 우선순위에서 먼저 들어온 요청을 먼저 꺼내기 위한 순번 */
+        uint64 Sequence = 0;
+
+        /** 로딩 스레드가 채우는 결과. bLoaded가 true가 된 뒤에만 메인 스레드에서 읽음 */
+        bool bSucceeded = false;
+        std::unique_ptr<OBJ::FStaticMeshRenderData> RenderData;
+        FDecodedImage Image;
+        double LoadMilliseconds = 0.0;
+
+        /** QueueMutex를 잡고 읽고 씀 */
+        bool bLoaded = false;
+
+        /** 메인 스레드에서만 접근 */
+        TArray<FOnStaticMeshLoaded> MeshCallbacks;
+        TArray<FOnTextureLoaded> TextureCallbacks;
+    };
+
+    using FRequestPtr = std::shared_ptr<FAsyncLoadRequest>;
+
+    TArray<std::thread> LoaderThreads;
+
+    /** QueuedRequests, CompletedRequests, bStopping과 요청의 Priority, bLoaded를 보호 */
+    std::mutex QueueMutex;
+    std::condition_variable QueueCondition;
+    std::condition_variable CompletedCondition;
+    TArray<FRequestPtr> QueuedRequests;
+    TArray<FRequestPtr> CompletedRequests;
+    bool bStopping = false;
+
+    // 아래는 메인 스레드 전용
+
+    /** 완료 콜백이 호출되기 전까지의 요청. 경로 맵은 중복 요청을 합칠 때 사용 */
+    TMap<uint32, FRequestPtr> PendingRequests;
+    TMap<FString, uint32> PendingMeshPaths;
+    TMap<FWString, uint32> PendingTexturePaths;
+    uint32 NextRequestId = 1;
+    uint64 NextSequence = 0;
+
+    /** 대기열이 비어 있다가 요청이 들어온 시점부터 다시 빌 때까지를 한 묶음으로 보고 로그를 남김 */
+    uint64 BatchStartCycles = 0;
+    uint32 BatchNumRequests = 0;
+
+    /** 로딩 스레드에서 걸린 시간의 합. 묶음 전체 시간보다 크면 그만큼 겹쳐서 읽은 것 */
+    double BatchLoadMilliseconds = 0.0;
+
+    /** 우선순위가 가장 높고 가장 먼저 들어온 요청을 꺼냅니다. 대기열이 짧으므로 힙 대신 선형 탐색 */
+    FRequestPtr PopNextRequest()
+    {
+        int32 BestIndex = 0;
+        for (int32 i = 1; i < QueuedRequests.Num(); ++i)
+        {
+            const FAsyncLoadRequest& Candidate = *QueuedRequests[i];
+            const FAsyncLoadRequest& Best = *QueuedRequests[BestIndex];
+            if (Candidate.Priority > Best.Priority || (Candidate.Priority == Best.Priority && Candidate.Sequence < Best.Sequence))
+            {
+                BestIndex = i;
+            }
+        }
+
+        FRequestPtr Request = std::move(QueuedRequests[BestIndex]);
+        QueuedRequests.RemoveAtSwap(BestIndex);
+        return Request;
+    }
+
+    /** 엔진 상태를 건드리지 않는 부분만 실행하므로 로딩 스레드에서 호출합니다. */
+    void LoadRequest(FAsyncLoadRequest& Request)
+    {
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        if (Request.Type == EAsyncLoadType::StaticMesh)
+        {
+            Request.RenderData = std::make_unique<OBJ::FStaticMeshRenderData>();
+            Request.bSucceeded = FManagerOBJ::BuildStaticMeshRenderData(Request.MeshPath, *Request.RenderData, false);
+        }
+        else
+        {
+            Request.bSucceeded = SUCCEEDED(FResourceMgr::LoadImageFromFile(Request.TexturePath.c_str(), Request.Image));
+        }
+        Request.LoadMilliseconds = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+    }
+
+    void LoaderThreadMain()
+    {
+        while (true)
+        {
+            FRequestPtr Request;
+            {
+                std::unique_lock Lock(QueueMutex);
+                QueueCondition.wait(Lock, []() { return bStopping || !QueuedRequests.IsEmpty(); });
+                if (bStopping)
+                {
+                    return;
+                }
+                Request = PopNextRequest();
+            }
+
+            LoadRequest(*Request);
+
+            {
+                std::lock_guard Lock(QueueMutex);
+                Request->bLoaded = true;
+                CompletedRequests.Add(std::move(Request));
+            }
+            CompletedCondition.notify_all();
+        }
+    }
+
+    /** 메인 스레드에서 결과를 엔진에 등록하고 콜백을 호출합니다. */
+    void FinishRequest(FAsyncLoadRequest& Request)
+    {
+        // 콜백 안에서 같은 경로를 다시 요청할 수 있도록 먼저 지움
+        PendingRequests.Remove(Request.RequestId);
+        BatchLoadMilliseconds += Request.LoadMilliseconds;
+        if (Request.Type == EAsyncLoadType::StaticMesh)
+        {
+            PendingMeshPaths.Remove(Request.MeshPath);
+
+            UStaticMesh* StaticMesh = nullptr;
+            if (Request.bSucceeded)
+            {
+                StaticMesh = FManagerOBJ::CreateStaticMeshFromRenderData(Request.MeshPath, Request.RenderData.release(), true);
+            }
+            else
+            {
+                UE_LOG(LogLevel::Error, "Async load failed: %s", *Request.MeshPath);
+            }
+
+            for (const FOnStaticMeshLoaded& Callback : Request.MeshCallbacks)
+            {
+                Callback.ExecuteIfBound(StaticMesh);
+            }
+        }
+        else
+        {
+            PendingTexturePaths.Remove(Request.TexturePath);
+
+            if (Request.bSucceeded && FEngineLoop::ResourceManager.GetTexture(Request.TexturePath) == nullptr)
+            {
+                Request.bSucceeded = SUCCEEDED(FEngineLoop::ResourceManager.CreateTextureFromImage(
+                    FEngineLoop::GraphicDevice.Device, Request.TexturePath.c_str(), Request.Image));
+            }
+            if (!Request.bSucceeded)
+            {
+                UE_LOG(LogLevel::Error, "Async load failed: %ls", Request.TexturePath.c_str());
+            }
+
+            for (const FOnTextureLoaded& Callback : Request.TextureCallbacks)
+            {
+                Callback.ExecuteIfBound(Request.bSucceeded);
+            }
+        }
+
+        if (PendingRequests.IsEmpty() && BatchNumRequests > 0)
+        {
+            UE_LOG(LogLevel::Display, "Async load: %u requests finished in %.2f ms (%.2f ms of loading work)",
+                BatchNumRequests, FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - BatchStartCycles), BatchLoadMilliseconds);
+            BatchNumRequests = 0;
+            BatchLoadMilliseconds = 0.0;
+        }
+    }
+
+    /** 새 요청을 대기열에 넣습니다. 로딩 스레드가 없으면 바로 읽고 끝냄 */
+    FAsyncLoadHandle SubmitRequest(const FRequestPtr& Request, EAsyncLoadPriority Priority)
+    {
+        Request->RequestId = NextRequestId++;
+        if (NextRequestId == 0)
+        {
+            NextRequestId = 1;
+        }
+        Request->Priority = Priority;
+        Request->Sequence = NextSequence++;
+
+        if (PendingRequests.IsEmpty())
+        {
+            BatchStartCycles = FPlatformTime::Cycles64();
+        }
+        ++BatchNumRequests;
+        PendingRequests.Add(Request->RequestId, Request);
+
+        if (LoaderThreads.IsEmpty())
+        {
+            LoadRequest(*Request);
+            Request->bLoaded = true;
+            FinishRequest(*Request);
+            return FAsyncLoadHandle{};
+        }
+
+        {
+            std::lock_guard Lock(QueueMutex);
+            QueuedRequests.Add(Request);
+        }
+        QueueCondition.notify_one();
+        return FAsyncLoadHandle{ Request->RequestId };
+    }
+
+    void RaisePriority(FAsyncLoadRequest& Request, EAsyncLoadPriority Priority)
+    {
+        std::lock_guard Lock(QueueMutex);
+        if (Priority > Request.Priority)
+        {
+            Request.Priority = Priority;
+        }
+    }
+}
+
+void FAsyncLoader::Initialize(uint32 NumThreads)
+{
+    if (!LoaderThreads.IsEmpty())
+    {
+        return;
+    }
+
+    bStopping = false;
+    for (uint32 i = 0; i < FMath::Max(NumThreads, 1u); ++i)
+    {
+        LoaderThreads.Add(std::thread(LoaderThreadMain));
+    }
+}
+
+void FAsyncLoader::Shutdown()
+{
+    if (LoaderThreads.IsEmpty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard Lock(QueueMutex);
+        bStopping = true;
+        QueuedRequests.Empty();
+    }
+    QueueCondition.notify_all();
+
+    for (std::thread& Thread : LoaderThreads)
+    {
+        Thread.join();
+    }
+    LoaderThreads.Empty();
+
+    CompletedRequests.Empty();
+    PendingRequests.Empty();
+    PendingMeshPaths.Empty();
+    PendingTexturePaths.Empty();
+    BatchNumRequests = 0;
+    BatchLoadMilliseconds = 0.0;
+}
+
+FAsyncLoadHandle FAsyncLoader::RequestStaticMesh(const FString& Path, EAsyncLoadPriority Priority, const FOnStaticMeshLoaded& OnLoaded)
+{
+    if (const uint32* RequestId = PendingMeshPaths.Find(Path))
+    {
+        FAsyncLoadRequest& Request = *PendingRequests[*RequestId];
+        Request.MeshCallbacks.Add(OnLoaded);
+        RaisePriority(Request, Priority);
+        return FAsyncLoadHandle{ *RequestId };
+    }
+
+    const FRequestPtr Request = std::make_shared<FAsyncLoadRequest>();
+    Request->Type = EAsyncLoadType::StaticMesh;
+    Request->MeshPath = Path;
+    Request->MeshCallbacks.Add(OnLoaded);
+
+    const FAsyncLoadHandle Handle = SubmitRequest(Request, Priority);
+    if (Handle.IsValid())
+    {
+        PendingMeshPaths.Add(Path, Handle.RequestId);
+    }
+    return Handle;
+}
+
+FAsyncLoadHandle FAsyncLoader::RequestTexture(const FWString& Path, EAsyncLoadPriority Priority, const FOnTextureLoaded& OnLoaded)
+{
+    if (const uint32* RequestId = PendingTexturePaths.Find(Path))
+    {
+        FAsyncLoadRequest& Request = *PendingRequests[*RequestId];
+        Request.TextureCallbacks.Add(OnLoaded);
+        RaisePriority(Request, Priority);
+        return FAsyncLoadHandle{ *RequestId };
+    }
+
+    const FRequestPtr Request = std::make_shared<FAsyncLoadRequest>();
+    Request->Type = EAsyncLoadType::Texture;
+    Request->TexturePath = Path;
+    Request->TextureCallbacks.Add(OnLoaded);
+
+    const FAsyncLoadHandle Handle = SubmitRequest(Request, Priority);
+    if (Handle.IsValid())
+    {
+        PendingTexturePaths.Add(Path, Handle.RequestId);
+    }
+    return Handle;
+}
+
+FAsyncLoadHandle FAsyncLoader::FindStaticMeshRequest(const FString& Path)
+{
+    const uint32* RequestId = PendingMeshPaths.Find(Path);
+    return RequestId ? FAsyncLoadHandle{ *RequestId } : FAsyncLoadHandle{};
+}
+
+bool FAsyncLoader::IsPending(FAsyncLoadHandle Handle)
+{
+    return Handle.IsValid() && PendingRequests.Contains(Handle.RequestId);
+}
+
+void FAsyncLoader::SetPriority(FAsyncLoadHandle Handle, EAsyncLoadPriority Priority)
+{
+    if (FRequestPtr* Request = PendingRequests.Find(Handle.RequestId))
+    {
+        std::lock_guard Lock(QueueMutex);
+        (*Request)->Priority = Priority;
+    }
+}
+
+void FAsyncLoader::Wait(FAsyncLoadHandle Handle)
+{
+    const FRequestPtr* Found = Handle.IsValid() ? PendingRequests.Find(Handle.RequestId) : nullptr;
+    if (Found == nullptr)
+    {
+        return;
+    }
+
+    // FinishRequest가 PendingRequests에서 지우므로 복사해 둠
+    const FRequestPtr Request = *Found;
+    {
+        std::unique_lock Lock(QueueMutex);
+        Request->Priority = EAsyncLoadPriority::High;
+        CompletedCondition.wait(Lock, [&Request]() { return Request->bLoaded; });
+        CompletedRequests.RemoveSingle(Request);
+    }
+    FinishRequest(*Request);
+}
+
+void FAsyncLoader::Flush()
+{
+    // Wait와 달리 우선순위를 올리지 않고 끝나는 순서대로 처리함. 콜백에서 새로 요청해도 모두 끝날 때까지 반복
+    while (!PendingRequests.IsEmpty())
+    {
+        {
+            std::unique_lock Lock(QueueMutex);
+            CompletedCondition.wait(Lock, []() { return !CompletedRequests.IsEmpty(); });
+        }
+        ProcessCompletions();
+    }
+}
+
+uint32 FAsyncLoader::ProcessCompletions(double TimeBudgetMs)
+{
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    uint32 NumProcessed = 0;
+    while (true)
+    {
+        FRequestPtr Request;
+        {
+            std::lock_guard Lock(QueueMutex);
+            if (CompletedRequests.IsEmpty())
+            {
+                break;
+            }
+            Request = std::move(CompletedRequests[0]);
+            CompletedRequests.RemoveAt(0);
+        }
+
+        FinishRequest(*Request);
+        ++NumProcessed;
+
+        if (TimeBudgetMs > 0.0 && FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles) >= TimeBudgetMs)
+        {
+            break;
+        }
+    }
+    return NumProcessed;
+}
+
+uint32 FAsyncLoader::GetNumPending()
+{
+    return PendingRequests.Num();
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "Define.h"
+#include "Delegates/DelegateCombination.h"
+
+class UStaticMesh;
+
+enum class EAsyncLoadPriority : uint8
+{
+    Low,
+    Normal,
+    High,
+};
+
+/** 비동기 로딩 요청 하나를 가리키는 핸들. 같은 파일을 읽는 중에 다시 요청하면 같은 핸들을 돌려받습니다. */
+struct FAsyncLoadHandle
+{
+    uint32 RequestId = 0;
+
+    bool IsValid() const { return RequestId != 0; }
+
+    bool operator==(const FAsyncLoadHandle& Other) const { return RequestId == Other.RequestId; }
+    bool operator!=(const FAsyncLoadHandle& Other) const { return RequestId != Other.RequestId; }
+};
+
+/** 메인 스레드에서 호출됩니다. 실패하면 nullptr */
+DECLARE_DELEGATE_OneParam(FOnStaticMeshLoaded, UStaticMesh*)
+
+/** 메인 스레드에서 호출됩니다. 텍스처는 경로로 FResourceMgr::GetTexture에서 찾을 수 있습니다. */
+DECLARE_DELEGATE_OneParam(FOnTextureLoaded, bool /*bSucceeded*/)
+
+/**
+ * 에셋 파일을 전용 로딩 스레드에서 읽는 서비스.
+ * 로딩 스레드는 파일 읽기, 파싱, 쿡, 이미지 디코딩처럼 엔진 상태를 건드리지 않는 일만 하고,
+ * GPU 버퍼 생성과 UObject 생성, 완료 콜백은 메인 스레드의 ProcessCompletions에서 처리합니다.
+ * 대기열에서는 우선순위가 높은 요청부터, 같은 우선순위는 먼저 들어온 요청부터 꺼냅니다.
+ *
+ * @note 로딩 스레드는 FJobSystem 워커와 따로 두어서, 파일을 기다리는 동안 프레임 작업을 막지 않습니다.
+ *       Initialize 전에는 요청한 스레드에서 바로 읽고 콜백까지 호출합니다.
+ */
+class FAsyncLoader
+{
+public:
+    /** @param NumThreads 로딩 스레드 수. 대부분 디스크를 기다리므로 코어 수와 상관없이 적게 둠 */
+    static void Initialize(uint32 NumThreads = DefaultNumThreads);
+
+    /** 대기 중인 요청은 버리고, 읽는 중인 요청이 끝나면 로딩 스레드를 종료합니다. 콜백은 호출되지 않습니다. */
+    static void Shutdown();
+
+    /** .obj 파일을 읽어 UStaticMesh를 만듭니다. 이미 읽는 중인 경로면 콜백만 추가하고 우선순위를 올립니다. */
+    static FAsyncLoadHandle RequestStaticMesh(const FString& Path, EAsyncLoadPriority Priority, const FOnStaticMeshLoaded& OnLoaded);
+
+    /** 이미지 파일을 읽어 FResourceMgr에 텍스처로 등록합니다. 이미 읽는 중인 경로면 콜백만 추가합니다. */
+    static FAsyncLoadHandle RequestTexture(const FWString& Path, EAsyncLoadPriority Priority, const FOnTextureLoaded& OnLoaded);
+
+    /** Path를 읽는 중이면 그 요청의 핸들. 아니면 빈 핸들 */
+    static FAsyncLoadHandle FindStaticMeshRequest(const FString& Path);
+
+    /** 완료 콜백이 아직 호출되지 않았으면 true */
+    static bool IsPending(FAsyncLoadHandle Handle);
+
+    /** 아직 대기열에 있는 요청의 우선순위를 바꿉니다. */
+    static void SetPriority(FAsyncLoadHandle Handle, EAsyncLoadPriority Priority);
+
+    /** 요청이 끝날 때까지 메인 스레드를 멈추고 기다린 뒤, 그 요청의 완료 처리와 콜백을 바로 실행합니다. */
+    static void Wait(FAsyncLoadHandle Handle);
+
+    /** 남은 요청을 모두 기다려서 완료 처리합니다. */
+    static void Flush();
+
+    /**
+     * 로딩 스레드가 끝낸 요청을 메인 스레드에서 마무리하고 콜백을 호출합니다. 매 프레임 호출합니다.
+     * @param TimeBudgetMs 0보다 크면 이 시간을 넘긴 뒤에는 다음 프레임으로 미룸. 최소 1개는 처리
+     * @return 처리한 요청 수
+     */
+    static uint32 ProcessCompletions(double TimeBudgetMs = 0.0);
+
+    /** 완료 콜백을 기다리는 요청 수 */
+    static uint32 GetNumPending();
+
+    static constexpr uint32 DefaultNumThreads = 2;
+
+    /** FEngineLoop::Tick에서 한 프레임에 완료 처리에 쓰는 시간 */
+    static constexpr double FrameTimeBudgetMs = 4.0;
+};
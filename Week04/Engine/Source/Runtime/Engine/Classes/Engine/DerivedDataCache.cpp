@@ -0,0 +1,462 @@
+#include "DerivedDataCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+#include "Core/HAL/MappedFile.h"
+#include "Container/Map.h"
+#include "Math/MathUtility.h"
+#include "Serialization/Serializer.h"
+
+namespace
+{
+    constexpr uint32 NumTypes = static_cast<uint32>(EDerivedDataType::Count);
+    constexpr const wchar_t* TypeDirectories[NumTypes] = { L"StaticMesh", L"MeshBVH", L"Texture" };
+    constexpr const char* TypeNames[NumTypes] = { "StaticMesh", "MeshBVH", "Texture" };
+    constexpr const wchar_t* EntryExtension = L".ddc";
+
+    /** 원본 해시 목록 파일 */
+    constexpr const wchar_t* SourceHashFileName = L"SourceHashes.bin";
+    constexpr uint32 SourceHashMagic = 0x48534443; // "CDSH"
+    constexpr uint32 SourceHashVersion = 1;
+
+    struct FSourceHashEntry
+    {
+        uint64 Size = 0;
+        int64 WriteTime = 0;
+        FContentHash Hash;
+    };
+
+    /** Directory와 MaxBytes는 Initialize에서만 바뀌고, 로딩 스레드는 그 뒤에 시작하므로 잠그지 않고 읽음 */
+    std::filesystem::path Directory;
+    uint64 MaxBytes = FDerivedDataCache::DefaultMaxBytes;
+    std::atomic<bool> bInitialized = false;
+
+    /** TotalBytes, SourceHashes, bSourceHashesDirty와 정리 작업을 보호 */
+    std::mutex CacheMutex;
+    uint64 TotalBytes = 0;
+    TMap<FWString, FSourceHashEntry> SourceHashes;
+    bool bSourceHashesDirty = false;
+
+    std::atomic<uint32> Hits[NumTypes];
+    std::atomic<uint32> Misses[NumTypes];
+    std::atomic<uint64> BytesRead[NumTypes];
+    std::atomic<uint64> BytesWritten[NumTypes];
+
+    /** 같은 항목을 여러 스레드가 동시에 써도 임시 파일이 겹치지 않도록 붙이는 번호 */
+    std::atomic<uint32> NextTempId = 0;
+
+    std::filesystem::path GetEntryPath(EDerivedDataType Type, const FContentHash& Key)
+    {
+        return Directory / TypeDirectories[static_cast<uint32>(Type)] / (Key.ToString().ToWideString() + EntryExtension);
+    }
+
+    std::filesystem::path GetTempPath(const std::filesystem::path& EntryPath)
+    {
+        std::filesystem::path TempPath = EntryPath;
+        TempPath += L".tmp" + std::to_wstring(NextTempId.fetch_add(1));
+        return TempPath;
+    }
+
+    /** 마지막 사용 시각을 지금으로. 실패해도 순서가 조금 틀릴 뿐이므로 무시 */
+    void Touch(const std::filesystem::path& EntryPath)
+    {
+        std::error_code Error;
+        std::filesystem::last_write_time(EntryPath, std::filesystem::file_time_type::clock::now(), Error);
+    }
+
+    /**
+     * 항목을 모두 훑어서 TotalBytes를 다시 세고, 한도를 넘었으면 오래 쓰지 않은 것부터 지웁니다.
+     * bRemoveTempFiles면 쓰다가 종료돼서 남은 임시 파일도 지웁니다. 다른 스레드가 쓰는 중일 수 있으므로 Initialize에서만 켬
+     * CacheMutex를 잡고 호출
+     */
+    void ScanAndEvict(uint64 TargetBytes, bool bRemoveTempFiles)
+    {
+        struct FEntry
+        {
+            std::filesystem::path Path;
+            std::filesystem::file_time_type LastUsed;
+            uint64 Size;
+        };
+        TArray<FEntry> Entries;
+        TotalBytes = 0;
+
+        for (const wchar_t* TypeDirectory : TypeDirectories)
+        {
+            std::error_code Error;
+            for (const std::filesystem::directory_entry& File : std::filesystem::directory_iterator(Directory / TypeDirectory, Error))
+            {
+                std::error_code FileError;
+                if (!File.is_regular_file(FileError))
+                {
+                    continue;
+                }
+                if (File.path().extension() != EntryExtension)
+                {
+                    if (bRemoveTempFiles)
+                    {
+                        std::filesystem::remove(File.path(), FileError);
+                    }
+                    continue;
+                }
+                const uint64 Size = File.file_size(FileError);
+                const std::filesystem::file_time_type LastUsed = File.last_write_time(FileError);
+                if (!FileError)
+                {
+                    Entries.Add({ File.path(), LastUsed, Size });
+                    TotalBytes += Size;
+                }
+            }
+        }
+
+        if (TotalBytes <= TargetBytes)
+        {
+            return;
+        }
+
+        std::sort(Entries.begin(), Entries.end(), [](const FEntry& A, const FEntry& B) { return A.LastUsed < B.LastUsed; });
+        for (const FEntry& Entry : Entries)
+        {
+            if (TotalBytes <= TargetBytes)
+            {
+                break;
+            }
+
+            // 매핑 중인 항목은 지워지지 않으므로 건너뜀
+            std::error_code Error;
+            if (std::filesystem::remove(Entry.Path, Error))
+            {
+                TotalBytes -= Entry.Size;
+            }
+        }
+    }
+
+    /** 다 쓴 임시 파일을 항목 이름으로 바꾸고 크기를 더합니다. */
+    bool Commit(EDerivedDataType Type, const std::filesystem::path& TempPath, const std::filesystem::path& EntryPath)
+    {
+        std::error_code Error;
+        const uint64 Size = std::filesystem::file_size(TempPath, Error);
+
+        // 다른 스레드가 같은 항목을 먼저 썼으면 덮어쓰므로 그 크기는 빼고 셈
+        std::error_code ExistingError;
+        const uint64 ExistingSize = std::filesystem::file_size(EntryPath, ExistingError);
+
+        if (!Error)
+        {
+            std::filesystem::rename(TempPath, EntryPath, Error);
+        }
+        if (Error)
+        {
+            std::filesystem::remove(TempPath, Error);
+            return false;
+        }
+
+        BytesWritten[static_cast<uint32>(Type)] += Size;
+
+        std::lock_guard Lock(CacheMutex);
+        TotalBytes += Size;
+        if (!ExistingError)
+        {
+            TotalBytes -= FMath::Min(ExistingSize, TotalBytes);
+        }
+        if (TotalBytes > MaxBytes)
+        {
+            ScanAndEvict(static_cast<uint64>(static_cast<double>(MaxBytes) * FDerivedDataCache::EvictionTargetRatio), false);
+        }
+        return true;
+    }
+
+    void LoadSourceHashes()
+    {
+        std::ifstream File(Directory / SourceHashFileName, std::ios::binary);
+        if (!File.is_open())
+        {
+            return;
+        }
+
+        uint32 Magic = 0;
+        uint32 Version = 0;
+        uint32 Count = 0;
+        File.read(reinterpret_cast<char*>(&Magic), sizeof(Magic));
+        File.read(reinterpret_cast<char*>(&Version), sizeof(Version));
+        File.read(reinterpret_cast<char*>(&Count), sizeof(Count));
+        if (!File.good() || Magic != SourceHashMagic || Version != SourceHashVersion)
+        {
+            return;
+        }
+
+        for (uint32 i = 0; i < Count && File.good(); ++i)
+        {
+            FWString Path;
+            FSourceHashEntry Entry;
+            Serializer::ReadFWString(File, Path);
+            File.read(reinterpret_cast<char*>(&Entry.Size), sizeof(Entry.Size));
+            File.read(reinterpret_cast<char*>(&Entry.WriteTime), sizeof(Entry.WriteTime));
+            File.read(reinterpret_cast<char*>(&Entry.Hash.A), sizeof(Entry.Hash.A));
+            File.read(reinterpret_cast<char*>(&Entry.Hash.B), sizeof(Entry.Hash.B));
+            if (File.good())
+            {
+                SourceHashes.Add(Path, Entry);
+            }
+        }
+    }
+
+    void SaveSourceHashes()
+    {
+        const std::filesystem::path Path = Directory / SourceHashFileName;
+        const std::filesystem::path TempPath = GetTempPath(Path);
+        {
+            std::ofstream File(TempPath, std::ios::binary | std::ios::trunc);
+            if (!File.is_open())
+            {
+                return;
+            }
+
+            const uint32 Count = SourceHashes.Num();
+            File.write(reinterpret_cast<const char*>(&SourceHashMagic), sizeof(SourceHashMagic));
+            File.write(reinterpret_cast<const char*>(&SourceHashVersion), sizeof(SourceHashVersion));
+            File.write(reinterpret_cast<const char*>(&Count), sizeof(Count));
+            for (const auto& Pair : SourceHashes)
+            {
+                Serializer::WriteFWString(File, Pair.Key);
+                File.write(reinterpret_cast<const char*>(&Pair.Value.Size), sizeof(Pair.Value.Size));
+                File.write(reinterpret_cast<const char*>(&Pair.Value.WriteTime), sizeof(Pair.Value.WriteTime));
+                File.write(reinterpret_cast<const char*>(&Pair.Value.Hash.A), sizeof(Pair.Value.Hash.A));
+                File.write(reinterpret_cast<const char*>(&Pair.Value.Hash.B), sizeof(Pair.Value.Hash.B));
+            }
+        }
+
+        std::error_code Error;
+        std::filesystem::rename(TempPath, Path, Error);
+        if (Error)
+        {
+            std::filesystem::remove(TempPath, Error);
+        }
+    }
+}
+
+void FDerivedDataCache::Initialize(const FWString& InDirectory, uint64 InMaxBytes)
+{
+    Directory = std::filesystem::absolute(InDirectory);
+    MaxBytes = InMaxBytes;
+
+    std::error_code Error;
+    for (const wchar_t* TypeDirectory : TypeDirectories)
+    {
+        std::filesystem::create_directories(Directory / TypeDirectory, Error);
+    }
+
+    {
+        std::lock_guard Lock(CacheMutex);
+        SourceHashes.Empty();
+        LoadSourceHashes();
+        bSourceHashesDirty = false;
+        ScanAndEvict(MaxBytes, true);
+    }
+
+    for (uint32 i = 0; i < NumTypes; ++i)
+    {
+        Hits[i] = 0;
+        Misses[i] = 0;
+        BytesRead[i] = 0;
+        BytesWritten[i] = 0;
+    }
+    bInitialized = true;
+}
+
+void FDerivedDataCache::Shutdown()
+{
+    if (!bInitialized)
+    {
+        return;
+    }
+
+    std::lock_guard Lock(CacheMutex);
+    if (bSourceHashesDirty)
+    {
+        SaveSourceHashes();
+        bSourceHashesDirty = false;
+    }
+    bInitialized = false;
+}
+
+bool FDerivedDataCache::HashSourceFile(const FWString& SourcePath, FContentHash& OutHash)
+{
+    std::error_code Error;
+    const std::filesystem::path Path = std::filesystem::absolute(SourcePath, Error).lexically_normal();
+    const uint64 Size = std::filesystem::file_size(Path, Error);
+    if (Error)
+    {
+        return false;
+    }
+    const int64 WriteTime = std::filesystem::last_write_time(Path, Error).time_since_epoch().count();
+    if (Error)
+    {
+        return false;
+    }
+
+    const FWString PathKey = Path.wstring();
+    {
+        std::lock_guard Lock(CacheMutex);
+        const FSourceHashEntry* Entry = SourceHashes.Find(PathKey);
+        if (Entry && Entry->Size == Size && Entry->WriteTime == WriteTime)
+        {
+            OutHash = Entry->Hash;
+            return true;
+        }
+    }
+
+    FSourceHashEntry NewEntry;
+    NewEntry.Size = Size;
+    NewEntry.WriteTime = WriteTime;
+    if (Size > 0)
+    {
+        FMappedFile File;
+        if (!File.Open(PathKey))
+        {
+            return false;
+        }
+        NewEntry.Hash = FContentHash::Compute(File.GetData(), File.GetSize());
+    }
+    else
+    {
+        NewEntry.Hash = FContentHash::Compute(nullptr, 0);
+    }
+
+    {
+        std::lock_guard Lock(CacheMutex);
+        SourceHashes.Add(PathKey, NewEntry);
+        bSourceHashesDirty = true;
+    }
+    OutHash = NewEntry.Hash;
+    return true;
+}
+
+bool FDerivedDataCache::IsInitialized()
+{
+    return bInitialized;
+}
+
+FContentHash FDerivedDataCache::MakeKey(EDerivedDataType Type, uint32 Version, const FContentHash& SourceHash)
+{
+    const uint32 Salt[2] = { static_cast<uint32>(Type), Version };
+    return FContentHash::Compute(Salt, sizeof(Salt), SourceHash);
+}
+
+bool FDerivedDataCache::FindFile(EDerivedDataType Type, const FContentHash& Key, FWString& OutPath)
+{
+    if (!bInitialized)
+    {
+        return false;
+    }
+
+    const std::filesystem::path EntryPath = GetEntryPath(Type, Key);
+    std::error_code Error;
+    const uint64 Size = std::filesystem::file_size(EntryPath, Error);
+    if (Error)
+    {
+        ++Misses[static_cast<uint32>(Type)];
+        return false;
+    }
+
+    Touch(EntryPath);
+    ++Hits[static_cast<uint32>(Type)];
+    BytesRead[static_cast<uint32>(Type)] += Size;
+    OutPath = EntryPath.wstring();
+    return true;
+}
+
+bool FDerivedDataCache::Get(EDerivedDataType Type, const FContentHash& Key, TArray<uint8>& OutData)
+{
+    if (!bInitialized)
+    {
+        return false;
+    }
+
+    const std::filesystem::path EntryPath = GetEntryPath(Type, Key);
+    std::ifstream File(EntryPath, std::ios::binary | std::ios::ate);
+    if (!File.is_open())
+    {
+        ++Misses[static_cast<uint32>(Type)];
+        return false;
+    }
+
+    const uint64 Size = static_cast<uint64>(File.tellg());
+    OutData.SetNum(static_cast<int32>(Size));
+    File.seekg(0);
+    File.read(reinterpret_cast<char*>(OutData.GetData()), static_cast<std::streamsize>(Size));
+    if (!File.good())
+    {
+        ++Misses[static_cast<uint32>(Type)];
+        return false;
+    }
+    File.close();
+
+    Touch(EntryPath);
+    ++Hits[static_cast<uint32>(Type)];
+    BytesRead[static_cast<uint32>(Type)] += Size;
+    return true;
+}
+
+bool FDerivedDataCache::Put(EDerivedDataType Type, const FContentHash& Key, const void* Data, uint64 Size)
+{
+    return PutFile(Type, Key, [Data, Size](const FWString& TempPath)
+    {
+        std::ofstream File(std::filesystem::path(TempPath), std::ios::binary | std::ios::trunc);
+        File.write(static_cast<const char*>(Data), static_cast<std::streamsize>(Size));
+        return File.good();
+    });
+}
+
+bool FDerivedDataCache::PutFile(EDerivedDataType Type, const FContentHash& Key, const std::function<bool(const FWString&)>& Writer)
+{
+    if (!bInitialized)
+    {
+        return false;
+    }
+
+    const std::filesystem::path EntryPath = GetEntryPath(Type, Key);
+    const std::filesystem::path TempPath = GetTempPath(EntryPath);
+    if (!Writer(TempPath.wstring()))
+    {
+        std::error_code Error;
+        std::filesystem::remove(TempPath, Error);
+        return false;
+    }
+    return Commit(Type, TempPath, EntryPath);
+}
+
+FDerivedDataStats FDerivedDataCache::GetStats(EDerivedDataType Type)
+{
+    const uint32 Index = static_cast<uint32>(Type);
+    FDerivedDataStats Stats;
+    Stats.Hits = Hits[Index];
+    Stats.Misses = Misses[Index];
+    Stats.BytesRead = BytesRead[Index];
+    Stats.BytesWritten = BytesWritten[Index];
+    return Stats;
+}
+
+uint64 FDerivedDataCache::GetTotalBytes()
+{
+    std::lock_guard Lock(CacheMutex);
+    return TotalBytes;
+}
+
+void FDerivedDataCache::LogReport()
+{
+    constexpr double MegaBytes = 1024.0 * 1024.0;
+    UE_LOG(LogLevel::Display, "Derived data cache: %ls, %.1f / %.1f MB", Directory.wstring().c_str(),
+        GetTotalBytes() / MegaBytes, MaxBytes / MegaBytes);
+    for (uint32 i = 0; i < NumTypes; ++i)
+    {
+        const FDerivedDataStats Stats = GetStats(static_cast<EDerivedDataType>(i));
+        const uint32 Requests = Stats.Hits + Stats.Misses;
+        UE_LOG(LogLevel::Display, " - %s: %u hits, %u misses (%.1f%% hit), %.2f MB read, %.2f MB written", TypeNames[i],
+            Stats.Hits, Stats.Misses, Requests > 0 ? 100.0 * Stats.Hits / Requests : 0.0, Stats.BytesRead / MegaBytes, Stats.BytesWritten / MegaBytes);
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <functional>
+
+#include "Define.h"
+#include "Misc/ContentHash.h"
+
+/** 캐시 항목의 종류. 종류마다 하위 폴더와 통계를 따로 둡니다. */
+enum class EDerivedDataType : uint8
+{
+    StaticMesh, // 쿡한 메시 (FCookedMeshHeader 형식)
+    MeshBVH,    // FTriangleBVH::Serialize 결과
+    Texture,    // 밉맵까지 만든 RGBA8 이미지
+    Count,
+};
+
+/** 종류 하나의 누적 통계 */
+struct FDerivedDataStats
+{
+    uint32 Hits = 0;
+    uint32 Misses = 0;
+    uint64 BytesRead = 0;
+    uint64 BytesWritten = 0;
+};
+
+/**
+ * 임포트한 에셋에서 만든 데이터를 원본 내용의 해시로 찾는 로컬 파생 데이터 캐시(DDC).
+ * 키는 원본 바이트의 해시에 종류와 쿠커 버전을 섞은 값이라, 원본을 옮기거나 다시 저장해도 내용이 같으면 그대로 쓰고
+ * 쿠커가 바뀌면 버전만 올려서 이전 항목을 무시합니다.
+ * 항목은 Directory/<종류>/<키>.ddc 파일 하나이고, 파일 수정 시각을 마지막 사용 시각으로 써서 MaxBytes를 넘으면 오래된 것부터 지웁니다(LRU).
+ *
+ * @note 로딩 스레드에서 호출해도 됩니다. Initialize 전에는 항목을 찾거나 쓰지 않습니다.
+ */
+class FDerivedDataCache
+{
+public:
+    /** 캐시 폴더를 만들고, 원본 해시 목록을 읽고, 한도를 넘었으면 정리합니다. */
+    static void Initialize(const FWString& InDirectory = L"DerivedDataCache", uint64 InMaxBytes = DefaultMaxBytes);
+
+    /** 원본 해시 목록을 저장합니다. */
+    static void Shutdown();
+
+    /** Initialize 뒤 Shutdown 전이면 true */
+    static bool IsInitialized();
+
+    /**
+     * 파일 내용의 해시. 경로, 크기, 수정 시각이 지난번과 같으면 파일을 읽지 않고 저장해 둔 값을 씁니다.
+     * @return 파일을 열 수 없으면 false
+     */
+    static bool HashSourceFile(const FWString& SourcePath, FContentHash& OutHash);
+
+    /** 원본 해시(또는 앞 단계의 키)에 종류와 버전을 섞은 키 */
+    static FContentHash MakeKey(EDerivedDataType Type, uint32 Version, const FContentHash& SourceHash);
+
+    /** 항목이 있으면 파일 경로를 돌려주고 hit로 셉니다. 매핑해서 읽을 항목에 씀 */
+    static bool FindFile(EDerivedDataType Type, const FContentHash& Key, FWString& OutPath);
+
+    /** 항목 전체를 OutData로 읽습니다. */
+    static bool Get(EDerivedDataType Type, const FContentHash& Key, TArray<uint8>& OutData);
+
+    /** 항목을 씁니다. 임시 파일에 다 쓴 뒤 이름을 바꾸므로 다른 스레드가 반쯤 쓴 항목을 읽지 않음 */
+    static bool Put(EDerivedDataType Type, const FContentHash& Key, const void* Data, uint64 Size);
+
+    /** Writer가 받은 임시 경로에 직접 쓰게 한 뒤 Put과 같이 등록합니다. Writer가 false를 돌려주면 버림 */
+    static bool PutFile(EDerivedDataType Type, const FContentHash& Key, const std::function<bool(const FWString&)>& Writer);
+
+    static FDerivedDataStats GetStats(EDerivedDataType Type);
+
+    /** 캐시 폴더의 항목 크기 합 */
+    static uint64 GetTotalBytes();
+
+    /** 종류별 hit/miss와 캐시 크기를 로그로 남깁니다. 메인 스레드에서만 호출 */
+    static void LogReport();
+
+    static constexpr uint64 DefaultMaxBytes = 2ull << 30;
+
+    /** 한도를 넘어서 지울 때 한도의 이 비율까지 줄임. 항목을 쓸 때마다 폴더를 훑지 않도록 여유를 둠 */
+    static constexpr float EvictionTargetRatio = 0.9f;
+};
@@ -1,7 +1,1424 @@
 #include "FLoaderOBJ.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
 #include "UObject/ObjectFactory.h"
 #include "Components/Material/Material.h"
 #include "Components/Mesh/StaticMesh.h"
+#include "FWindowsPlatformTime.h"
+#include "Core/Async/JobSystem.h"
+#include "Core/HAL/MappedFile.h"
+#include "DerivedDataCache.h"
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+    bool IsBlank(char C)
+    {
+        return C == ' ' || C == '\t' || C == '\r';
+    }
+
+    const char* SkipBlanks(const char* Cur, const char* End)
+    {
+        while (Cur < End && IsBlank(*Cur))
+        {
+            ++Cur;
+        }
+        return Cur;
+    }
+
+    /** 다음 줄의 시작. 마지막 줄이면 End */
+    const char* NextLine(const char* Cur, const char* End)
+    {
+        const char* NewLine = static_cast<const char*>(std::memchr(Cur, '\n', End - Cur));
+        return NewLine ? NewLine + 1 : End;
+    }
+
+    /** 공백 전까지를 이름으로 읽습니다. (istringstream >> std::string과 같음) */
+    const char* ParseName(const char* Cur, const char* End, std::string& OutName)
+    {
+        Cur = SkipBlanks(Cur, End);
+        const char* NameEnd = Cur;
+        while (NameEnd < End && !IsBlank(*NameEnd) && *NameEnd != '\n')
+        {
+            ++NameEnd;
+        }
+        OutName.assign(Cur, NameEnd);
+        return NameEnd;
+    }
+
+    /** 실패하면 0을 넣고 토큰을 건너뜁니다. */
+    const char* ParseFloat(const char* Cur, const char* End, float& OutValue)
+    {
+        Cur = SkipBlanks(Cur, End);
+        if (Cur < End && *Cur == '+')
+        {
+            ++Cur;
+        }
+        const auto [Ptr, Error] = std::from_chars(Cur, End, OutValue);
+        if (Ptr == Cur)
+        {
+            OutValue = 0.f;
+            while (Cur < End && !IsBlank(*Cur) && *Cur != '\n')
+            {
+                ++Cur;
+            }
+            return Cur;
+        }
+        return Ptr;
+    }
+
+    /**
+     * OBJ 인덱스 하나를 0부터 시작하는 인덱스로 바꿉니다. 음수는 지금까지 나온 개수 기준의 상대 인덱스입니다.
+     * 숫자가 없으면 UINT32_MAX
+     */
+    const char* ParseIndex(const char* Cur, const char* End, uint32 Count, uint32& OutIndex, bool& bOutRelative)
+    {
+        int32 Index = 0;
+        const auto [Ptr, Error] = std::from_chars(Cur, End, Index);
+        bOutRelative = Ptr != Cur && Index < 0;
+        if (Ptr == Cur || Index == 0)
+        {
+            OutIndex = UINT32_MAX;
+            return Ptr;
+        }
+        // 청크 파싱에서는 Count가 청크 안의 개수라 음수가 될 수 있음. 병합할 때 앞 청크들의 개수를 더하면 맞아짐
+        OutIndex = Index > 0 ? static_cast<uint32>(Index - 1) : Count + static_cast<uint32>(Index);
+        return Ptr;
+    }
+
+    bool MatchKeyword(const char* Cur, const char* End, const char* Keyword, size_t Length)
+    {
+        return static_cast<size_t>(End - Cur) > Length && std::memcmp(Cur, Keyword, Length) == 0 && IsBlank(Cur[Length]);
+    }
+
+    /** 청크를 따로 파싱할 때, 병합하면서 앞 청크들의 개수를 더해야 하는 상대 인덱스의 위치 (정점, UV, 법선 순) */
+    struct FRelativeCorners
+    {
+        TArray<uint32> Positions[3];
+    };
+
+    /** 면의 한 꼭짓점 (정점, UV, 법선 인덱스). RelativeMask는 음수 인덱스였던 성분의 비트 */
+    struct FFaceCorner
+    {
+        uint32 Indices[3];
+        uint8 RelativeMask;
+    };
+
+    void AddFaceCorner(FObjInfo& OutObjInfo, const FFaceCorner& Corner, FRelativeCorners* OutRelative)
+    {
+        if (Corner.RelativeMask != 0 && OutRelative != nullptr)
+        {
+            const uint32 Position = OutObjInfo.VertexIndices.Num();
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                if (Corner.RelativeMask & (1 << k))
+                {
+                    OutRelative->Positions[k].Add(Position);
+                }
+            }
+        }
+        OutObjInfo.VertexIndices.Add(Corner.Indices[0]);
+        OutObjInfo.TextureIndices.Add(Corner.Indices[1]);
+        OutObjInfo.NormalIndices.Add(Corner.Indices[2]);
+    }
+
+    void CloseLastSubset(FObjInfo& OutObjInfo)
+    {
+        if (!OutObjInfo.MaterialSubsets.IsEmpty())
+        {
+            FMaterialSubset& LastSubset = OutObjInfo.MaterialSubsets[OutObjInfo.MaterialSubsets.Num() - 1];
+            LastSubset.IndexCount = OutObjInfo.VertexIndices.Num() - LastSubset.IndexStart;
+        }
+    }
+
+    bool ReadWholeFile(const FWString& FilePath, TArray<char>& OutBuffer)
+    {
+        std::ifstream File(FilePath, std::ios::binary | std::ios::ate);
+        if (!File)
+        {
+            return false;
+        }
+
+        const std::streamsize Size = File.tellg();
+        File.seekg(0, std::ios::beg);
+        OutBuffer.SetNum(static_cast<uint32>(Size));
+        return Size == 0 || File.read(OutBuffer.GetData(), Size).good();
+    }
+
+    /** 꼭짓점 하나의 v/vt/vn 인덱스를 묶은 96비트 용접 키 */
+    struct FWeldKey
+    {
+        uint32 Vertex;
+        uint32 Texture;
+        uint32 Normal;
+
+        bool operator==(const FWeldKey& Other) const
+        {
+            return Vertex == Other.Vertex && Texture == Other.Texture && Normal == Other.Normal;
+        }
+    };
+
+    uint32 HashWeldKey(const FWeldKey& Key)
+    {
+        uint32 Hash = Key.Vertex * 0x9E3779B1u ^ Key.Texture * 0x85EBCA77u ^ Key.Normal * 0xC2B2AE3Du;
+        // murmur3 finalizer
+        Hash ^= Hash >> 16;
+        Hash *= 0x85EBCA6Bu;
+        Hash ^= Hash >> 13;
+        Hash *= 0xC2B2AE35u;
+        Hash ^= Hash >> 16;
+        return Hash;
+    }
+
+    /**
+     * bParallel이면 FJobSystem::ParallelFor로, 아니면 호출한 스레드에서 차례로 Body를 실행합니다.
+     * 로딩 스레드가 워커 큐(메인 스레드의 큐 포함)에 긴 작업을 넣어서 프레임의 Wait를 붙잡지 않도록 씀
+     */
+    template <typename FuncType>
+    void ParallelForIf(bool bParallel, int32 Num, const FuncType& Body, int32 MinBatchSize)
+    {
+        if (bParallel)
+        {
+            FJobSystem::ParallelFor(Num, Body, MinBatchSize);
+            return;
+        }
+        for (int32 Index = 0; Index < Num; ++Index)
+        {
+            Body(Index);
+        }
+    }
+
+    /**
+     * 꼭짓점마다 같은 키를 가진 꼭짓점 중 가장 앞선 것의 번호를 찾습니다.
+     * 슬롯에는 꼭짓점 번호 + 1을 넣고(0은 빈 슬롯), 같은 키가 이미 있으면 더 작은 번호로 바꾸므로
+     * 여러 스레드가 어떤 순서로 넣어도 결과가 같습니다. 한 번 키가 정해진 슬롯은 다른 키로 바뀌지 않습니다.
+     */
+    void FindFirstCorners(const TArray<FWeldKey>& Keys, TArray<uint32>& OutFirstCorners, int32 BatchSize, bool bAllowParallel)
+    {
+        const uint32 NumCorners = Keys.Num();
+        // 채움률 0.5 이하로 미리 잡아서 다시 할당하지 않음
+        const uint32 Capacity = std::bit_ceil(FMath::Max(NumCorners * 2, 16u));
+        const uint32 SlotMask = Capacity - 1;
+        const std::unique_ptr<std::atomic<uint32>[]> Slots(new std::atomic<uint32>[Capacity]());
+
+        ParallelForIf(bAllowParallel, static_cast<int32>(NumCorners), [&](int32 Index)
+        {
+            const FWeldKey& Key = Keys[Index];
+            const uint32 Value = static_cast<uint32>(Index) + 1;
+            for (uint32 Slot = HashWeldKey(Key) & SlotMask; ; Slot = (Slot + 1) & SlotMask)
+            {
+                uint32 Current = Slots[Slot].load(std::memory_order_relaxed);
+                while (Current == 0 && !Slots[Slot].compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+                {
+                }
+                if (Current == 0)
+                {
+                    return;
+                }
+                if (Keys[Current - 1] == Key)
+                {
+                    while (Value < Current && !Slots[Slot].compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+                    {
+                    }
+                    return;
+                }
+            }
+        }, BatchSize);
+
+        OutFirstCorners.SetNum(NumCorners);
+        ParallelForIf(bAllowParallel, static_cast<int32>(NumCorners), [&](int32 Index)
+        {
+            const FWeldKey& Key = Keys[Index];
+            for (uint32 Slot = HashWeldKey(Key) & SlotMask; ; Slot = (Slot + 1) & SlotMask)
+            {
+                const uint32 Current = Slots[Slot].load(std::memory_order_relaxed);
+                if (Keys[Current - 1] == Key)
+                {
+                    OutFirstCorners[Index] = Current - 1;
+                    return;
+                }
+            }
+        }, BatchSize);
+    }
+
+    void WriteMaterial(std::ostream& Stream, const FObjMaterialInfo& Material)
+    {
+        Serializer::WriteFString(Stream, Material.MTLName);
+        Stream.write(reinterpret_cast<const char*>(&Material.bHasTexture), sizeof(Material.bHasTexture));
+        Stream.write(reinterpret_cast<const char*>(&Material.bTransparent), sizeof(Material.bTransparent));
+        Stream.write(reinterpret_cast<const char*>(&Material.Diffuse), sizeof(Material.Diffuse));
+        Stream.write(reinterpret_cast<const char*>(&Material.Specular), sizeof(Material.Specular));
+        Stream.write(reinterpret_cast<const char*>(&Material.Ambient), sizeof(Material.Ambient));
+        Stream.write(reinterpret_cast<const char*>(&Material.Emissive), sizeof(Material.Emissive));
+        Stream.write(reinterpret_cast<const char*>(&Material.SpecularScalar), sizeof(Material.SpecularScalar));
+        Stream.write(reinterpret_cast<const char*>(&Material.DensityScalar), sizeof(Material.DensityScalar));
+        Stream.write(reinterpret_cast<const char*>(&Material.TransparencyScalar), sizeof(Material.TransparencyScalar));
+        Stream.write(reinterpret_cast<const char*>(&Material.IlluminanceModel), sizeof(Material.IlluminanceModel));
+
+        Serializer::WriteFString(Stream, Material.DiffuseTextureName);
+        Serializer::WriteFWString(Stream, Material.DiffuseTexturePath);
+        Serializer::WriteFString(Stream, Material.AmbientTextureName);
+        Serializer::WriteFWString(Stream, Material.AmbientTexturePath);
+        Serializer::WriteFString(Stream, Material.SpecularTextureName);
+        Serializer::WriteFWString(Stream, Material.SpecularTexturePath);
+        Serializer::WriteFString(Stream, Material.BumpTextureName);
+        Serializer::WriteFWString(Stream, Material.BumpTexturePath);
+        Serializer::WriteFString(Stream, Material.AlphaTextureName);
+        Serializer::WriteFWString(Stream, Material.AlphaTexturePath);
+    }
+
+    void ReadMaterial(std::istream& Stream, FObjMaterialInfo& Material)
+    {
+        Serializer::ReadFString(Stream, Material.MTLName);
+        Stream.read(reinterpret_cast<char*>(&Material.bHasTexture), sizeof(Material.bHasTexture));
+        Stream.read(reinterpret_cast<char*>(&Material.bTransparent), sizeof(Material.bTransparent));
+        Stream.read(reinterpret_cast<char*>(&Material.Diffuse), sizeof(Material.Diffuse));
+        Stream.read(reinterpret_cast<char*>(&Material.Specular), sizeof(Material.Specular));
+        Stream.read(reinterpret_cast<char*>(&Material.Ambient), sizeof(Material.Ambient));
+        Stream.read(reinterpret_cast<char*>(&Material.Emissive), sizeof(Material.Emissive));
+        Stream.read(reinterpret_cast<char*>(&Material.SpecularScalar), sizeof(Material.SpecularScalar));
+        Stream.read(reinterpret_cast<char*>(&Material.DensityScalar), sizeof(Material.DensityScalar));
+        Stream.read(reinterpret_cast<char*>(&Material.TransparencyScalar), sizeof(Material.TransparencyScalar));
+        Stream.read(reinterpret_cast<char*>(&Material.IlluminanceModel), sizeof(Material.IlluminanceModel));
+
+        Serializer::ReadFString(Stream, Material.DiffuseTextureName);
+        Serializer::ReadFWString(Stream, Material.DiffuseTexturePath);
+        Serializer::ReadFString(Stream, Material.AmbientTextureName);
+        Serializer::ReadFWString(Stream, Material.AmbientTexturePath);
+        Serializer::ReadFString(Stream, Material.SpecularTextureName);
+        Serializer::ReadFWString(Stream, Material.SpecularTexturePath);
+        Serializer::ReadFString(Stream, Material.BumpTextureName);
+        Serializer::ReadFWString(Stream, Material.BumpTexturePath);
+        Serializer::ReadFString(Stream, Material.AlphaTextureName);
+        Serializer::ReadFWString(Stream, Material.AlphaTexturePath);
+    }
+
+    void WriteSubsets(std::ostream& Stream, const TArray<FMaterialSubset>& Subsets)
+    {
+        uint32 SubsetCount = Subsets.Num();
+        Stream.write(reinterpret_cast<const char*>(&SubsetCount), sizeof(SubsetCount));
+        for (const FMaterialSubset& Subset : Subsets)
+        {
+            Serializer::WriteFString(Stream, Subset.MaterialName);
+            Stream.write(reinterpret_cast<const char*>(&Subset.IndexStart), sizeof(Subset.IndexStart));
+            Stream.write(reinterpret_cast<const char*>(&Subset.IndexCount), sizeof(Subset.IndexCount));
+            Stream.write(reinterpret_cast<const char*>(&Subset.MaterialIndex), sizeof(Subset.MaterialIndex));
+        }
+    }
+
+    void ReadSubsets(std::istream& Stream, TArray<FMaterialSubset>& Subsets)
+    {
+        uint32 SubsetCount = 0;
+        Stream.read(reinterpret_cast<char*>(&SubsetCount), sizeof(SubsetCount));
+        Subsets.SetNum(Stream.good() ? SubsetCount : 0);
+        for (FMaterialSubset& Subset : Subsets)
+        {
+            Serializer::ReadFString(Stream, Subset.MaterialName);
+            Stream.read(reinterpret_cast<char*>(&Subset.IndexStart), sizeof(Subset.IndexStart));
+            Stream.read(reinterpret_cast<char*>(&Subset.IndexCount), sizeof(Subset.IndexCount));
+            Stream.read(reinterpret_cast<char*>(&Subset.MaterialIndex), sizeof(Subset.MaterialIndex));
+        }
+    }
+
+    /** 다음 블록이 BlockAlignment에 맞게 시작하도록 0으로 채웁니다. @return 채운 뒤의 위치 */
+    uint64 PadToAlignment(std::ostream& Stream)
+    {
+        static constexpr char Zeros[FCookedMeshHeader::BlockAlignment] = {};
+        const uint64 Position = static_cast<uint64>(Stream.tellp());
+        const uint64 Padding = (FCookedMeshHeader::BlockAlignment - Position % FCookedMeshHeader::BlockAlignment) % FCookedMeshHeader::BlockAlignment;
+        Stream.write(Zeros, static_cast<std::streamsize>(Padding));
+        return Position + Padding;
+    }
+
+    bool IsSameObjInfo(const FObjInfo& A, const FObjInfo& B)
+    {
+        if (A.Vertices.Num() != B.Vertices.Num() || A.Normals.Num() != B.Normals.Num() || A.UVs.Num() != B.UVs.Num() ||
+            A.VertexIndices.Num() != B.VertexIndices.Num() || A.MaterialSubsets.Num() != B.MaterialSubsets.Num() ||
+            A.GroupName.Num() != B.GroupName.Num() || A.NumOfGroup != B.NumOfGroup || !(A.MatName == B.MatName))
+        {
+            return false;
+        }
+        for (uint32 i = 0; i < A.Vertices.Num(); ++i)
+        {
+            if (!(A.Vertices[i] == B.Vertices[i]))
+            {
+                return false;
+            }
+        }
+        for (uint32 i = 0; i < A.Normals.Num(); ++i)
+        {
+            if (!(A.Normals[i] == B.Normals[i]))
+            {
+                return false;
+            }
+        }
+        for (uint32 i = 0; i < A.UVs.Num(); ++i)
+        {
+            if (A.UVs[i].x != B.UVs[i].x || A.UVs[i].y != B.UVs[i].y)
+            {
+                return false;
+            }
+        }
+        for (uint32 i = 0; i < A.VertexIndices.Num(); ++i)
+        {
+            if (A.VertexIndices[i] != B.VertexIndices[i] || A.TextureIndices[i] != B.TextureIndices[i] || A.NormalIndices[i] != B.NormalIndices[i])
+            {
+                return false;
+            }
+        }
+        for (uint32 i = 0; i < A.MaterialSubsets.Num(); ++i)
+        {
+            const FMaterialSubset& SubsetA = A.MaterialSubsets[i];
+            const FMaterialSubset& SubsetB = B.MaterialSubsets[i];
+            if (SubsetA.IndexStart != SubsetB.IndexStart || SubsetA.IndexCount != SubsetB.IndexCount || !(SubsetA.MaterialName == SubsetB.MaterialName))
+            {
+                return false;
+            }
+        }
+        for (uint32 i = 0; i < A.GroupName.Num(); ++i)
+        {
+            if (!(A.GroupName[i] == B.GroupName[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * [Begin, End)를 OutObjInfo에 이어서 파싱합니다.
+     * OutRelative가 있으면 음수 인덱스의 위치를 기록합니다. 이때 음수 인덱스는 OutObjInfo 안의 개수 기준으로 풀립니다.
+     */
+    void ParseRange(const char* Begin, const char* End, FObjInfo& OutObjInfo, FRelativeCorners* OutRelative)
+    {
+        std::string Name;
+
+        const char* Cur = Begin;
+        while (Cur < End)
+        {
+            Cur = SkipBlanks(Cur, End);
+            if (Cur >= End)
+            {
+                break;
+            }
+
+            const char* LineEnd = NextLine(Cur, End);
+
+            if (Cur[0] == 'v')
+            {
+                const char Kind = Cur + 1 < LineEnd ? Cur[1] : '\n';
+                if (IsBlank(Kind)) // Vertex
+                {
+                    FVector Vertex;
+                    Cur = ParseFloat(Cur + 1, LineEnd, Vertex.x);
+                    Cur = ParseFloat(Cur, LineEnd, Vertex.y);
+                    ParseFloat(Cur, LineEnd, Vertex.z);
+                    OutObjInfo.Vertices.Add(Vertex);
+                }
+                else if (Kind == 'n' && Cur + 2 < End && IsBlank(Cur[2])) // Normal
+                {
+                    FVector Normal;
+                    Cur = ParseFloat(Cur + 2, LineEnd, Normal.x);
+                    Cur = ParseFloat(Cur, LineEnd, Normal.y);
+                    ParseFloat(Cur, LineEnd, Normal.z);
+                    OutObjInfo.Normals.Add(Normal);
+                }
+                else if (Kind == 't' && Cur + 2 < End && IsBlank(Cur[2])) // Texture
+                {
+                    FVector2D UV;
+                    Cur = ParseFloat(Cur + 2, LineEnd, UV.x);
+                    ParseFloat(Cur, LineEnd, UV.y);
+                    OutObjInfo.UVs.Add(UV);
+                }
+            }
+            else if (Cur[0] == 'f' && Cur + 1 < LineEnd && IsBlank(Cur[1]))
+            {
+                // 삼각형화 (삼각형 팬 방식). 첫 정점과 직전 정점만 들고 있으면 되므로 면마다 배열을 만들지 않음
+                FFaceCorner First = {};
+                FFaceCorner Prev = {};
+                uint32 NumCorners = 0;
+
+                Cur += 1;
+                while (true)
+                {
+                    Cur = SkipBlanks(Cur, LineEnd);
+                    if (Cur >= LineEnd || *Cur == '\n' || *Cur == '#')
+                    {
+                        break;
+                    }
+
+                    // v, v/vt, v//vn, v/vt/vn
+                    FFaceCorner Corner = { { UINT32_MAX, UINT32_MAX, UINT32_MAX }, 0 };
+                    bool bRelative = false;
+                    const char* Next = ParseIndex(Cur, LineEnd, OutObjInfo.Vertices.Num(), Corner.Indices[0], bRelative);
+                    Corner.RelativeMask |= bRelative ? 1 : 0;
+                    if (Next < LineEnd && *Next == '/')
+                    {
+                        Next = ParseIndex(Next + 1, LineEnd, OutObjInfo.UVs.Num(), Corner.Indices[1], bRelative);
+                        Corner.RelativeMask |= bRelative ? 2 : 0;
+                        if (Next < LineEnd && *Next == '/')
+                        {
+                            Next = ParseIndex(Next + 1, LineEnd, OutObjInfo.Normals.Num(), Corner.Indices[2], bRelative);
+                            Corner.RelativeMask |= bRelative ? 4 : 0;
+                        }
+                    }
+                    if (Next == Cur)
+                    {
+                        // 숫자가 아닌 토큰은 건너뜀
+                        while (Next < LineEnd && !IsBlank(*Next) && *Next != '\n')
+                        {
+                            ++Next;
+                        }
+                        Cur = Next;
+                        continue;
+                    }
+                    Cur = Next;
+
+                    // 정점 인덱스가 없으면 이전 파서와 같이 0번 정점. 청크 안에서 -1로 풀린 상대 인덱스는 병합 때 보정되므로 제외
+                    if (Corner.Indices[0] == UINT32_MAX && (Corner.RelativeMask & 1) == 0)
+                    {
+                        Corner.Indices[0] = 0;
+                    }
+
+                    if (NumCorners == 0)
+                    {
+                        First = Corner;
+                    }
+                    else if (NumCorners >= 2)
+                    {
+                        AddFaceCorner(OutObjInfo, First, OutRelative);
+                        AddFaceCorner(OutObjInfo, Prev, OutRelative);
+                        AddFaceCorner(OutObjInfo, Corner, OutRelative);
+                    }
+                    Prev = Corner;
+                    ++NumCorners;
+                }
+            }
+            else if (MatchKeyword(Cur, LineEnd, "usemtl", 6))
+            {
+                ParseName(Cur + 6, LineEnd, Name);
+                CloseLastSubset(OutObjInfo);
+
+                FMaterialSubset MaterialSubset;
+                MaterialSubset.MaterialName = FString(Name);
+                MaterialSubset.IndexStart = OutObjInfo.VertexIndices.Num();
+                MaterialSubset.IndexCount = 0;
+                OutObjInfo.MaterialSubsets.Add(MaterialSubset);
+            }
+            else if (MatchKeyword(Cur, LineEnd, "mtllib", 6))
+            {
+                ParseName(Cur + 6, LineEnd, Name);
+                OutObjInfo.MatName = FString(Name);
+            }
+            else if ((Cur[0] == 'g' || Cur[0] == 'o') && Cur + 1 < LineEnd && IsBlank(Cur[1]))
+            {
+                ParseName(Cur + 1, LineEnd, Name);
+                OutObjInfo.GroupName.Add(FString(Name));
+                OutObjInfo.NumOfGroup++;
+            }
+            // '#' 주석, s, l, vp 등은 무시
+
+            Cur = LineEnd;
+        }
+    }
+}
+
+bool FLoaderOBJ::ParseOBJ(const FString& ObjFilePath, FObjInfo& OutObjInfo, bool bAllowParallel)
+{
+    TArray<char> Buffer;
+    if (!ReadWholeFile(ObjFilePath.ToWideString(), Buffer))
+    {
+        return false;
+    }
+
+    SetObjNames(ObjFilePath, OutObjInfo);
+    if (bAllowParallel)
+    {
+        ParseOBJBufferParallel(Buffer.GetData(), Buffer.GetData() + Buffer.Num(), OutObjInfo);
+    }
+    else
+    {
+        ParseOBJBuffer(Buffer.GetData(), Buffer.GetData() + Buffer.Num(), OutObjInfo);
+    }
+    CloseLastSubset(OutObjInfo);
+    return true;
+}
+
+void FLoaderOBJ::ParseOBJBuffer(const char* Begin, const char* End, FObjInfo& OutObjInfo)
+{
+    ParseRange(Begin, End, OutObjInfo, nullptr);
+}
+
+void FLoaderOBJ::ParseOBJBufferParallel(const char* Begin, const char* End, FObjInfo& OutObjInfo)
+{
+    const size_t Size = End - Begin;
+    const uint32 NumChunks = static_cast<uint32>(FMath::Min<size_t>(FJobSystem::GetNumThreads() * ParallelChunksPerThread, Size / MinParallelChunkSize));
+    if (NumChunks <= 1)
+    {
+        ParseRange(Begin, End, OutObjInfo, nullptr);
+        return;
+    }
+
+    // 균등하게 자른 위치에서 다음 줄의 시작으로 밀어서 줄이 두 청크에 걸치지 않게 함
+    TArray<const char*> ChunkBounds;
+    ChunkBounds.SetNum(NumChunks + 1);
+    ChunkBounds[0] = Begin;
+    ChunkBounds[NumChunks] = End;
+    for (uint32 i = 1; i < NumChunks; ++i)
+    {
+        const char* Split = FMath::Max(Begin + Size * i / NumChunks, ChunkBounds[i - 1]);
+        ChunkBounds[i] = Split < End ? NextLine(Split, End) : End;
+    }
+
+    TArray<FObjInfo> Chunks;
+    TArray<FRelativeCorners> Relatives;
+    Chunks.SetNum(NumChunks);
+    Relatives.SetNum(NumChunks);
+    FJobSystem::ParallelFor(static_cast<int32>(NumChunks), [&](int32 Index)
+    {
+        ParseRange(ChunkBounds[Index], ChunkBounds[Index + 1], Chunks[Index], &Relatives[Index]);
+    });
+
+    // 청크마다 앞 청크들까지의 개수 (OutObjInfo에 이미 있던 것 포함)
+    struct FChunkBase
+    {
+        uint32 Vertex;
+        uint32 Normal;
+        uint32 UV;
+        uint32 Index;
+    };
+    TArray<FChunkBase> Bases;
+    Bases.SetNum(NumChunks);
+    FChunkBase Total = { OutObjInfo.Vertices.Num(), OutObjInfo.Normals.Num(), OutObjInfo.UVs.Num(), OutObjInfo.VertexIndices.Num() };
+    for (uint32 i = 0; i < NumChunks; ++i)
+    {
+        Bases[i] = Total;
+        Total.Vertex += Chunks[i].Vertices.Num();
+        Total.Normal += Chunks[i].Normals.Num();
+        Total.UV += Chunks[i].UVs.Num();
+        Total.Index += Chunks[i].VertexIndices.Num();
+    }
+
+    OutObjInfo.Vertices.SetNum(Total.Vertex);
+    OutObjInfo.Normals.SetNum(Total.Normal);
+    OutObjInfo.UVs.SetNum(Total.UV);
+    OutObjInfo.VertexIndices.SetNum(Total.Index);
+    OutObjInfo.TextureIndices.SetNum(Total.Index);
+    OutObjInfo.NormalIndices.SetNum(Total.Index);
+
+    // 복사와 상대 인덱스 보정도 청크마다 겹치지 않는 구간에 쓰므로 병렬로 처리
+    FJobSystem::ParallelFor(static_cast<int32>(NumChunks), [&](int32 Index)
+    {
+        const FObjInfo& Chunk = Chunks[Index];
+        const FChunkBase& Base = Bases[Index];
+        std::copy(Chunk.Vertices.begin(), Chunk.Vertices.end(), OutObjInfo.Vertices.begin() + Base.Vertex);
+        std::copy(Chunk.Normals.begin(), Chunk.Normals.end(), OutObjInfo.Normals.begin() + Base.Normal);
+        std::copy(Chunk.UVs.begin(), Chunk.UVs.end(), OutObjInfo.UVs.begin() + Base.UV);
+        std::copy(Chunk.VertexIndices.begin(), Chunk.VertexIndices.end(), OutObjInfo.VertexIndices.begin() + Base.Index);
+        std::copy(Chunk.TextureIndices.begin(), Chunk.TextureIndices.end(), OutObjInfo.TextureIndices.begin() + Base.Index);
+        std::copy(Chunk.NormalIndices.begin(), Chunk.NormalIndices.end(), OutObjInfo.NormalIndices.begin() + Base.Index);
+
+        const FRelativeCorners& Relative = Relatives[Index];
+        for (uint32 Position : Relative.Positions[0])
+        {
+            OutObjInfo.VertexIndices[Base.Index + Position] += Base.Vertex;
+        }
+        for (uint32 Position : Relative.Positions[1])
+        {
+            OutObjInfo.TextureIndices[Base.Index + Position] += Base.UV;
+        }
+        for (uint32 Position : Relative.Positions[2])
+        {
+            OutObjInfo.NormalIndices[Base.Index + Position] += Base.Normal;
+        }
+    });
+
+    // 서브셋은 청크 안의 인덱스 위치로 시작점이 기록되어 있으므로 옮기고, usemtl 사이의 개수를 다시 계산
+    uint32 FirstOpenSubset = OutObjInfo.MaterialSubsets.IsEmpty() ? 0 : OutObjInfo.MaterialSubsets.Num() - 1;
+    for (uint32 i = 0; i < NumChunks; ++i)
+    {
+        FObjInfo& Chunk = Chunks[i];
+        for (FMaterialSubset& Subset : Chunk.MaterialSubsets)
+        {
+            Subset.IndexStart += Bases[i].Index;
+            OutObjInfo.MaterialSubsets.Add(Subset);
+        }
+        OutObjInfo.GroupName += Chunk.GroupName;
+        OutObjInfo.NumOfGroup += Chunk.NumOfGroup;
+        if (!Chunk.MatName.IsEmpty())
+        {
+            OutObjInfo.MatName = Chunk.MatName;
+        }
+    }
+    for (uint32 i = FirstOpenSubset; i + 1 < OutObjInfo.MaterialSubsets.Num(); ++i)
+    {
+        OutObjInfo.MaterialSubsets[i].IndexCount = OutObjInfo.MaterialSubsets[i + 1].IndexStart - OutObjInfo.MaterialSubsets[i].IndexStart;
+    }
+}
+
+bool FLoaderOBJ::ConvertToStaticMesh(const FObjInfo& RawData, OBJ::FStaticMeshRenderData& OutStaticMesh, bool bAllowParallel)
+{
+    OutStaticMesh.ObjectName = RawData.ObjectName;
+    OutStaticMesh.PathName = RawData.PathName;
+    OutStaticMesh.DisplayName = RawData.DisplayName;
+
+    const uint32 NumCorners = RawData.VertexIndices.Num();
+    TArray<FWeldKey> Keys;
+    Keys.SetNum(NumCorners);
+    const uint32 NumVertices = RawData.Vertices.Num();
+    for (uint32 i = 0; i < NumCorners; ++i)
+    {
+        // UV와 노멀은 없으면 기본값을 쓰지만 위치는 없으면 정점을 만들 수 없음. 첫 정점보다 앞을 가리키는 상대 인덱스도 UINT32_MAX라 여기서 걸림
+        // 로딩 스레드에서도 불리므로 로그 없이 실패만 돌려줌
+        if (RawData.VertexIndices[i] >= NumVertices)
+        {
+            return false;
+        }
+        Keys[i] = { RawData.VertexIndices[i], RawData.TextureIndices[i], RawData.NormalIndices[i] };
+    }
+
+    TArray<uint32> FirstCorners;
+    FindFirstCorners(Keys, FirstCorners, WeldParallelBatchSize, bAllowParallel);
+
+    // 처음 나온 꼭짓점에만 새 정점 번호를 매기므로 정점 순서가 이전 방식과 같음
+    TArray<uint32> UniqueCorners;
+    UniqueCorners.Reserve(NumCorners);
+    OutStaticMesh.Indices.SetNum(NumCorners);
+    for (uint32 i = 0; i < NumCorners; ++i)
+    {
+        if (FirstCorners[i] == i)
+        {
+            OutStaticMesh.Indices[i] = UniqueCorners.Num();
+            UniqueCorners.Add(i);
+        }
+        else
+        {
+            OutStaticMesh.Indices[i] = OutStaticMesh.Indices[FirstCorners[i]];
+        }
+    }
+
+    OutStaticMesh.Vertices.SetNum(UniqueCorners.Num());
+    const bool bHasNormals = !RawData.Normals.IsEmpty();
+    if (bHasNormals)
+    {
+        OutStaticMesh.Normals.SetNum(UniqueCorners.Num());
+    }
+    ParallelForIf(bAllowParallel, static_cast<int32>(UniqueCorners.Num()), [&](int32 Index)
+    {
+        const FWeldKey& Key = Keys[UniqueCorners[Index]];
+
+        FVertexSimple vertex {};
+        vertex.x = RawData.Vertices[Key.Vertex].x;
+        vertex.y = RawData.Vertices[Key.Vertex].y;
+        vertex.z = RawData.Vertices[Key.Vertex].z;
+
+        vertex.r = 0.0f; vertex.g = 0.0f; vertex.b = 0.0f; vertex.a = 1.0f; // 기본 색상
+
+        if (Key.Texture != UINT32_MAX && Key.Texture < RawData.UVs.Num())
+        {
+            vertex.u = RawData.UVs[Key.Texture].x;
+            vertex.v = -RawData.UVs[Key.Texture].y;
+        }
+        OutStaticMesh.Vertices[Index] = vertex;
+
+        if (bHasNormals)
+        {
+            OutStaticMesh.Normals[Index] = Key.Normal < RawData.Normals.Num() ? RawData.Normals[Key.Normal] : FVector(0.f, 0.f, 0.f);
+        }
+    }, WeldParallelBatchSize);
+
+    // Calculate StaticMesh BoundingBox
+    ComputeBoundingBox(OutStaticMesh.Vertices, OutStaticMesh.BoundingBoxMin, OutStaticMesh.BoundingBoxMax);
+
+    return true;
+}
+
+EStaticMeshVertexFormat FLoaderOBJ::CompressVertices(OBJ::FStaticMeshRenderData& InOutStaticMesh, bool bAllowParallel)
+{
+    const TArray<FVertexSimple>& Vertices = InOutStaticMesh.Vertices;
+
+    bool bFitsCompact = !InOutStaticMesh.IsCompact() && !Vertices.IsEmpty();
+    for (int32 i = 0; bFitsCompact && i < Vertices.Num(); ++i)
+    {
+        bFitsCompact = std::fabs(Vertices[i].u) <= MaxCompactTexCoord && std::fabs(Vertices[i].v) <= MaxCompactTexCoord;
+    }
+    if (!bFitsCompact)
+    {
+        InOutStaticMesh.Normals.Empty();
+        return InOutStaticMesh.VertexFormat;
+    }
+
+    const bool bHasNormals = InOutStaticMesh.Normals.Num() == Vertices.Num();
+    const FVector Min = InOutStaticMesh.BoundingBoxMin;
+    const FVector Extent = InOutStaticMesh.BoundingBoxMax - Min;
+
+    TArray<FVertexCompact>& CompactVertices = InOutStaticMesh.CompactVertices;
+    CompactVertices.SetNum(Vertices.Num());
+    ParallelForIf(bAllowParallel, static_cast<int32>(Vertices.Num()), [&](int32 Index)
+    {
+        const FVertexSimple& Vertex = Vertices[Index];
+        FVertexCompact& Compact = CompactVertices[Index];
+        Compact.X = FQuantizedPosition::Encode(Vertex.x, Min.x, Extent.x);
+        Compact.Y = FQuantizedPosition::Encode(Vertex.y, Min.y, Extent.y);
+        Compact.Z = FQuantizedPosition::Encode(Vertex.z, Min.z, Extent.z);
+        Compact.Normal = bHasNormals ? FOctahedralNormal::Encode(InOutStaticMesh.Normals[Index]) : 0;
+        Compact.U = FFloat16::Encode(Vertex.u);
+        Compact.V = FFloat16::Encode(Vertex.v);
+    }, WeldParallelBatchSize);
+
+    InOutStaticMesh.VertexFormat = EStaticMeshVertexFormat::Compact;
+    InOutStaticMesh.bHasVertexNormals = bHasNormals;
+    InOutStaticMesh.Vertices.Empty();
+    InOutStaticMesh.Normals.Empty();
+    return InOutStaticMesh.VertexFormat;
+}
+
+bool FLoaderOBJ::WriteGridOBJ(const FWString& FilePath, uint32 GridSize)
+{
+    std::ofstream File(FilePath, std::ios::binary);
+    if (!File.is_open())
+    {
+        return false;
+    }
+
+    const uint32 NumSide = GridSize + 1;
+    char Line[128];
+
+    File << "# Grid " << GridSize << " x " << GridSize << "\n";
+    File << "o Grid\n";
+    for (uint32 y = 0; y < NumSide; ++y)
+    {
+        for (uint32 x = 0; x < NumSide; ++x)
+        {
+            const float Height = 0.25f * std::sin(x * 0.37f) * std::cos(y * 0.23f);
+            const int Length = std::snprintf(Line, sizeof(Line), "v %.6f %.6f %.6f\nvt %.6f %.6f\n",
+                static_cast<float>(x), static_cast<float>(y), Height,
+                static_cast<float>(x) / GridSize, static_cast<float>(y) / GridSize);
+            File.write(Line, Length);
+        }
+    }
+    File << "vn 0.000000 0.000000 1.000000\n";
+    File << "s off\n";
+
+    for (uint32 y = 0; y < GridSize; ++y)
+    {
+        for (uint32 x = 0; x < GridSize; ++x)
+        {
+            const uint32 I0 = y * NumSide + x + 1;
+            const uint32 I1 = I0 + 1;
+            const uint32 I2 = I1 + NumSide;
+            const uint32 I3 = I0 + NumSide;
+            const int Length = std::snprintf(Line, sizeof(Line), "f %u/%u/1 %u/%u/1 %u/%u/1 %u/%u/1\n", I0, I0, I1, I1, I2, I2, I3, I3);
+            File.write(Line, Length);
+        }
+    }
+
+    return File.good();
+}
+
+namespace
+{
+    /**
+     * 이전 줄 단위 istringstream 파서. BenchmarkParseOBJ의 비교 대상으로만 남겨둡니다.
+     * 3각형과 4각형 면만 처리합니다.
+     */
+    bool ParseOBJLegacy(const FString& ObjFilePath, FObjInfo& OutObjInfo)
+    {
+        std::ifstream OBJ(ObjFilePath.ToWideString());
+        if (!OBJ)
+        {
+            return false;
+        }
+
+        SetObjNames(ObjFilePath, OutObjInfo);
+    
+        std::string Line;
+
+        while (std::getline(OBJ, Line))
+        {
+            if (Line.empty() || Line[0] == '#')
+                continue;
+        
+            std::istringstream LineStream(Line);
+            std::string Token;
+            LineStream >> Token;
+
+            if (Token == "mtllib")
+            {
+                LineStream >> Line;
+                OutObjInfo.MatName = Line;
+                continue;
+            }
+
+            if (Token == "usemtl")
+            {
+                LineStream >> Line;
+                FString MatName(Line);
+
+                if (!OutObjInfo.MaterialSubsets.IsEmpty())
+                {
+                    FMaterialSubset& LastSubset = OutObjInfo.MaterialSubsets[OutObjInfo.MaterialSubsets.Num() - 1];
+                    LastSubset.IndexCount = OutObjInfo.VertexIndices.Num() - LastSubset.IndexStart;
+                }
+            
+                FMaterialSubset MaterialSubset;
+                MaterialSubset.MaterialName = MatName;
+                MaterialSubset.IndexStart = OutObjInfo.VertexIndices.Num();
+                MaterialSubset.IndexCount = 0;
+                OutObjInfo.MaterialSubsets.Add(MaterialSubset);
+            }
+
+            if (Token == "g" || Token == "o")
+            {
+                LineStream >> Line;
+                OutObjInfo.GroupName.Add(Line);
+                OutObjInfo.NumOfGroup++;
+            }
+
+            if (Token == "v") // Vertex
+            {
+                float x, y, z;
+                LineStream >> x >> y >> z;
+                OutObjInfo.Vertices.Add(FVector(x,y,z));
+                continue;
+            }
+
+            if (Token == "vn") // Normal
+            {
+                float nx, ny, nz;
+                LineStream >> nx >> ny >> nz;
+                OutObjInfo.Normals.Add(FVector(nx,ny,nz));
+                continue;
+            }
+
+            if (Token == "vt") // Texture
+            {
+                float u, v;
+                LineStream >> u >> v;
+                OutObjInfo.UVs.Add(FVector2D(u, v));
+                continue;
+            }
+
+            if (Token == "f")
+            {
+                TArray<uint32> faceVertexIndices;  // 이번 페이스의 정점 인덱스
+                TArray<uint32> faceNormalIndices;  // 이번 페이스의 법선 인덱스
+                TArray<uint32> faceTextureIndices; // 이번 페이스의 텍스처 인덱스
+            
+                while (LineStream >> Token)
+                {
+                    std::istringstream tokenStream(Token);
+                    std::string part;
+                    TArray<std::string> facePieces;
+
+                    // '/'로 분리하여 v/vt/vn 파싱
+                    while (std::getline(tokenStream, part, '/'))
+                    {
+                        facePieces.Add(part);
+                    }
+
+                    // OBJ 인덱스는 1부터 시작하므로 -1로 변환
+                    uint32 vertexIndex = facePieces[0].empty() ? 0 : std::stoi(facePieces[0]) - 1;
+                    uint32 textureIndex = (facePieces.Num() > 1 && !facePieces[1].empty()) ? std::stoi(facePieces[1]) - 1 : UINT32_MAX;
+                    uint32 normalIndex = (facePieces.Num() > 2 && !facePieces[2].empty()) ? std::stoi(facePieces[2]) - 1 : UINT32_MAX;
+
+                    faceVertexIndices.Add(vertexIndex);
+                    faceTextureIndices.Add(textureIndex);
+                    faceNormalIndices.Add(normalIndex);
+                }
+
+                if (faceVertexIndices.Num() == 4) // 쿼드
+                {
+                    // 첫 번째 삼각형: 0-1-2
+                    OutObjInfo.VertexIndices.Add(faceVertexIndices[0]);
+                    OutObjInfo.VertexIndices.Add(faceVertexIndices[1]);
+                    OutObjInfo.VertexIndices.Add(faceVertexIndices[2]);
+
+                    OutObjInfo.TextureIndices.Add(faceTextureIndices[0]);
+                    OutObjInfo.TextureIndices.Add(faceTextureIndices[1]);
+                    OutObjInfo.TextureIndices.Add(faceTextureIndices[2]);
+
+                    OutObjInfo.NormalIndices.Add(faceNormalIndices[0]);
+                    OutObjInfo.NormalIndices.Add(faceNormalIndices[1]);
+                    OutObjInfo.NormalIndices.Add(faceNormalIndices[2]);
+
+                    // 두 번째 삼각형: 0-2-3
+                    OutObjInfo.VertexIndices.Add(faceVertexIndices[0]);
+                    OutObjInfo.VertexIndices.Add(faceVertexIndices[2]);
+                    OutObjInfo.VertexIndices.Add(faceVertexIndices[3]);
+
+                    OutObjInfo.TextureIndices.Add(faceTextureIndices[0]);
+                    OutObjInfo.TextureIndices.Add(faceTextureIndices[2]);
+                    OutObjInfo.TextureIndices.Add(faceTextureIndices[3]);
+
+                    OutObjInfo.NormalIndices.Add(faceNormalIndices[0]);
+                    OutObjInfo.NormalIndices.Add(faceNormalIndices[2]);
+                    OutObjInfo.NormalIndices.Add(faceNormalIndices[3]);
+                }
+                else if (faceVertexIndices.Num() == 3) // 삼각형
+                {
+                    OutObjInfo.VertexIndices.Add(faceVertexIndices[0]);
+                    OutObjInfo.VertexIndices.Add(faceVertexIndices[1]);
+                    OutObjInfo.VertexIndices.Add(faceVertexIndices[2]);
+
+                    OutObjInfo.TextureIndices.Add(faceTextureIndices[0]);
+                    OutObjInfo.TextureIndices.Add(faceTextureIndices[1]);
+                    OutObjInfo.TextureIndices.Add(faceTextureIndices[2]);
+
+                    OutObjInfo.NormalIndices.Add(faceNormalIndices[0]);
+                    OutObjInfo.NormalIndices.Add(faceNormalIndices[1]);
+                    OutObjInfo.NormalIndices.Add(faceNormalIndices[2]);
+                }
+            }
+        }
+
+        if (!OutObjInfo.MaterialSubsets.IsEmpty())
+        {
+            FMaterialSubset& LastSubset = OutObjInfo.MaterialSubsets[OutObjInfo.MaterialSubsets.Num() - 1];
+            LastSubset.IndexCount = OutObjInfo.VertexIndices.Num() - LastSubset.IndexStart;
+        }
+    
+        return true;
+    }
+
+    /** 이전 문자열 키 TMap 방식. BenchmarkConvertToStaticMesh의 비교 대상으로만 남겨둡니다. */
+    bool ConvertToStaticMeshLegacy(const FObjInfo& RawData, OBJ::FStaticMeshRenderData& OutStaticMesh)
+    {
+        OutStaticMesh.ObjectName = RawData.ObjectName;
+        OutStaticMesh.PathName = RawData.PathName;
+        OutStaticMesh.DisplayName = RawData.DisplayName;
+
+        // 고유 정점을 기반으로 FVertexSimple 배열 생성
+        TMap<std::string, uint32> vertexMap; // 중복 체크용
+
+        for (int32 i = 0; i < RawData.VertexIndices.Num(); i++)
+        {
+            uint32 vIdx = RawData.VertexIndices[i];
+            uint32 tIdx = RawData.TextureIndices[i];
+            uint32 nIdx = RawData.NormalIndices[i];
+
+            // 키 생성 (v/vt/vn 조합)
+            std::string key = std::to_string(vIdx) + "/" + 
+                             std::to_string(tIdx) + "/" + 
+                             std::to_string(nIdx);
+
+            uint32 index;
+            if (vertexMap.Find(key) == nullptr)
+            {
+                FVertexSimple vertex {};
+                vertex.x = RawData.Vertices[vIdx].x;
+                vertex.y = RawData.Vertices[vIdx].y;
+                vertex.z = RawData.Vertices[vIdx].z;
+
+                vertex.r = 0.0f; vertex.g = 0.0f; vertex.b = 0.0f; vertex.a = 1.0f; // 기본 색상
+
+                if (tIdx != UINT32_MAX && tIdx < RawData.UVs.Num())
+                {
+                    vertex.u = RawData.UVs[tIdx].x;
+                    vertex.v = -RawData.UVs[tIdx].y;
+                }
+            
+                index = OutStaticMesh.Vertices.Num();
+                OutStaticMesh.Vertices.Add(vertex);
+                vertexMap[key] = index;
+            }
+            else
+            {
+                index = vertexMap[key];
+            }
+
+            OutStaticMesh.Indices.Add(index);
+        
+        }
+
+        // Calculate StaticMesh BoundingBox
+        FLoaderOBJ::ComputeBoundingBox(OutStaticMesh.Vertices, OutStaticMesh.BoundingBoxMin, OutStaticMesh.BoundingBoxMax);
+    
+        return true;
+    }
+}
+
+void FLoaderOBJ::BenchmarkParseOBJ(const FString& ObjFilePath, uint32 GridSize)
+{
+    FWString FilePath = ObjFilePath.ToWideString();
+    if (FilePath.empty())
+    {
+        FilePath = (std::filesystem::temp_directory_path() / L"ObjParseBenchmark.obj").wstring();
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        if (!WriteGridOBJ(FilePath, GridSize))
+        {
+            UE_LOG(LogLevel::Error, "OBJ parse benchmark: can't write grid OBJ");
+            return;
+        }
+        UE_LOG(LogLevel::Display, "OBJ parse benchmark: wrote %u x %u grid in %.1f ms", GridSize, GridSize,
+            FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles));
+    }
+
+    std::error_code Error;
+    const uintmax_t FileSize = std::filesystem::file_size(FilePath, Error);
+    if (Error)
+    {
+        UE_LOG(LogLevel::Error, "OBJ parse benchmark: can't open %s", *ObjFilePath);
+        return;
+    }
+    const double FileMB = static_cast<double>(FileSize) / (1024.0 * 1024.0);
+    const FString Path(std::string(FilePath.begin(), FilePath.end()));
+
+    // 첫 번째 실행으로 파일 캐시를 데운 뒤, 모든 파서를 캐시된 상태에서 잼
+    FObjInfo Serial;
+    uint64 StartCycles = FPlatformTime::Cycles64();
+    ParseOBJ(Path, Serial, false);
+    const double ColdMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+    FObjInfo Legacy;
+    StartCycles = FPlatformTime::Cycles64();
+    ParseOBJLegacy(Path, Legacy);
+    const double LegacyMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+    Serial = FObjInfo();
+    StartCycles = FPlatformTime::Cycles64();
+    ParseOBJ(Path, Serial, false);
+    const double SerialMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+    FObjInfo Parallel;
+    StartCycles = FPlatformTime::Cycles64();
+    ParseOBJ(Path, Parallel, true);
+    const double ParallelMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+    // 이전 파서는 5각형 이상의 면을 버리므로 그런 면이 있으면 다를 수 있음
+    const bool bLegacyMatches = IsSameObjInfo(Serial, Legacy);
+    const bool bParallelMatches = IsSameObjInfo(Serial, Parallel);
+
+    const auto Throughput = [FileMB](double Ms) { return Ms > 0.0 ? FileMB / (Ms / 1000.0) : 0.0; };
+    UE_LOG(LogLevel::Display, "OBJ parse benchmark: %.1f MB, %u vertices, %u triangles", FileMB, Serial.Vertices.Num(), Serial.VertexIndices.Num() / 3);
+    UE_LOG(LogLevel::Display, " - Legacy (istringstream): %.1f ms, %.1f MB/s", LegacyMs, Throughput(LegacyMs));
+    UE_LOG(LogLevel::Display, " - In-place (from_chars): %.1f ms cold, %.1f ms warm, %.1f MB/s (x%.1f), %s",
+        ColdMs, SerialMs, Throughput(SerialMs), SerialMs > 0.0 ? LegacyMs / SerialMs : 0.0, bLegacyMatches ? "match" : "MISMATCH");
+    UE_LOG(LogLevel::Display, " - In-place parallel (%u threads): %.1f ms, %.1f MB/s (x%.1f), %s",
+        FJobSystem::GetNumThreads(), ParallelMs, Throughput(ParallelMs), ParallelMs > 0.0 ? LegacyMs / ParallelMs : 0.0, bParallelMatches ? "match" : "MISMATCH");
+}
+
+void FLoaderOBJ::BenchmarkConvertToStaticMesh(const FString& ObjFilePath)
+{
+    const FString Path = ObjFilePath.IsEmpty() ? FString("Assets/JungleApples/apple_mid.obj") : ObjFilePath;
+
+    FObjInfo ObjInfo;
+    if (!ParseOBJ(Path, ObjInfo))
+    {
+        UE_LOG(LogLevel::Error, "Vertex weld benchmark: can't open %s", *Path);
+        return;
+    }
+
+    OBJ::FStaticMeshRenderData Legacy;
+    uint64 StartCycles = FPlatformTime::Cycles64();
+    ConvertToStaticMeshLegacy(ObjInfo, Legacy);
+    const double LegacyMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+    OBJ::FStaticMeshRenderData Hashed;
+    StartCycles = FPlatformTime::Cycles64();
+    ConvertToStaticMesh(ObjInfo, Hashed);
+    const double HashedMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+    const bool bMatches = Legacy.Vertices.Num() == Hashed.Vertices.Num() && Legacy.Indices.Num() == Hashed.Indices.Num() &&
+        std::memcmp(Legacy.Vertices.GetData(), Hashed.Vertices.GetData(), Legacy.Vertices.Num() * sizeof(FVertexSimple)) == 0 &&
+        std::memcmp(Legacy.Indices.GetData(), Hashed.Indices.GetData(), Legacy.Indices.Num() * sizeof(UINT)) == 0;
+
+    UE_LOG(LogLevel::Display, "Vertex weld benchmark: %s, %u corners -> %u vertices", *Path, ObjInfo.VertexIndices.Num(), Hashed.Vertices.Num());
+    UE_LOG(LogLevel::Display, " - Legacy (string TMap): %.2f ms", LegacyMs);
+    UE_LOG(LogLevel::Display, " - Hashed (%u threads): %.2f ms (x%.1f), %s",
+        FJobSystem::GetNumThreads(), HashedMs, HashedMs > 0.0 ? LegacyMs / HashedMs : 0.0, bMatches ? "match" : "MISMATCH");
+}
+
+void FLoaderOBJ::BenchmarkVertexCompression(const FString& ObjFilePath)
+{
+    const FString Path = ObjFilePath.IsEmpty() ? FString("Assets/JungleApples/apple_mid.obj") : ObjFilePath;
+
+    FObjInfo ObjInfo;
+    if (!ParseOBJ(Path, ObjInfo))
+    {
+        UE_LOG(LogLevel::Error, "Vertex compression benchmark: can't open %s", *Path);
+        return;
+    }
+
+    OBJ::FStaticMeshRenderData StaticMesh;
+    ConvertToStaticMesh(ObjInfo, StaticMesh);
+    const TArray<FVertexSimple> FullVertices = StaticMesh.Vertices;
+    const uint64 FullBytes = static_cast<uint64>(FullVertices.Num()) * sizeof(FVertexSimple);
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    const EStaticMeshVertexFormat Format = CompressVertices(StaticMesh);
+    const double EncodeMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+    UE_LOG(LogLevel::Display, "Vertex compression benchmark: %s, %u vertices", *Path, FullVertices.Num());
+    if (Format != EStaticMeshVertexFormat::Compact)
+    {
+        UE_LOG(LogLevel::Display, " - UVs exceed +-%.1f, kept full vertices (%llu bytes)", MaxCompactTexCoord, FullBytes);
+        return;
+    }
+
+    // 디코드 결과를 원본과 비교해서 최대 오차를 구함
+    TArray<FVertexSimple> Decoded;
+    StaticMesh.DecodeVertices(Decoded);
+    float MaxPositionError = 0.f;
+    float MaxTexCoordError = 0.f;
+    for (int32 i = 0; i < FullVertices.Num(); ++i)
+    {
+        MaxPositionError = std::max({ MaxPositionError, std::fabs(Decoded[i].x - FullVertices[i].x),
+            std::fabs(Decoded[i].y - FullVertices[i].y), std::fabs(Decoded[i].z - FullVertices[i].z) });
+        MaxTexCoordError = std::max({ MaxTexCoordError, std::fabs(Decoded[i].u - FullVertices[i].u), std::fabs(Decoded[i].v - FullVertices[i].v) });
+    }
+
+    const uint64 CompactBytes = static_cast<uint64>(StaticMesh.GetNumVertices()) * StaticMesh.GetVertexStride();
+    const FVector Extent = StaticMesh.BoundingBoxMax - StaticMesh.BoundingBoxMin;
+    UE_LOG(LogLevel::Display, " - Full: %llu bytes, Compact: %llu bytes (%.1f%%), encoded in %.2f ms, normals: %s",
+        FullBytes, CompactBytes, FullBytes > 0 ? 100.0 * CompactBytes / FullBytes : 0.0, EncodeMs, StaticMesh.bHasVertexNormals ? "yes" : "no");
+    UE_LOG(LogLevel::Display, " - Max error: position %.6f (bounds %.3f x %.3f x %.3f), uv %.6f",
+        MaxPositionError, Extent.x, Extent.y, Extent.z, MaxTexCoordError);
+}
+
+void FLoaderOBJ::BenchmarkMeshOptimization(const FString& ObjFilePath)
+{
+    const FString Path = ObjFilePath.IsEmpty() ? FString("Assets/JungleApples/apple_mid.obj") : ObjFilePath;
+
+    FObjInfo ObjInfo;
+    if (!ParseOBJ(Path, ObjInfo))
+    {
+        UE_LOG(LogLevel::Error, "Mesh optimization benchmark: can't open %s", *Path);
+        return;
+    }
+
+    OBJ::FStaticMeshRenderData StaticMesh;
+    ConvertToStaticMesh(ObjInfo, StaticMesh);
+    StaticMesh.MaterialSubsets = ObjInfo.MaterialSubsets;
+
+    const auto Analyze = [&StaticMesh](uint32 CacheSize)
+    {
+        return FMeshOptimizer::AnalyzeVertexCache(StaticMesh.Indices.GetData(), StaticMesh.Indices.Num(), StaticMesh.Vertices.Num(), CacheSize);
+    };
+    const FVertexCacheStats Before = Analyze(FMeshOptimizer::FifoCacheSize);
+    const FVertexCacheStats BeforeLarge = Analyze(FMeshOptimizer::ScoringCacheSize);
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    FMeshOptimizer::OptimizeStaticMesh(StaticMesh);
+    const double OptimizeMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+    const FVertexCacheStats After = Analyze(FMeshOptimizer::FifoCacheSize);
+    const FVertexCacheStats AfterLarge = Analyze(FMeshOptimizer::ScoringCacheSize);
+
+    UE_LOG(LogLevel::Display, "Mesh optimization benchmark: %s, %u triangles, %u subsets, optimized in %.2f ms",
+        *Path, StaticMesh.Indices.Num() / 3, StaticMesh.MaterialSubsets.Num(), OptimizeMs);
+    UE_LOG(LogLevel::Display, " - FIFO %u: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f",
+        FMeshOptimizer::FifoCacheSize, Before.ACMR, After.ACMR, Before.ATVR, After.ATVR);
+    UE_LOG(LogLevel::Display, " - FIFO %u: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f",
+        FMeshOptimizer::ScoringCacheSize, BeforeLarge.ACMR, AfterLarge.ACMR, BeforeLarge.ATVR, AfterLarge.ATVR);
+}
+
+void FLoaderOBJ::BenchmarkLODGeneration(const FString& ObjFilePath)
+{
+    const FString Path = ObjFilePath.IsEmpty() ? FString("Assets/JungleApples/apple_mid.obj") : ObjFilePath;
+
+    FObjInfo ObjInfo;
+    if (!ParseOBJ(Path, ObjInfo))
+    {
+        UE_LOG(LogLevel::Error, "LOD benchmark: can't open %s", *Path);
+        return;
+    }
+
+    OBJ::FStaticMeshRenderData StaticMesh;
+    ConvertToStaticMesh(ObjInfo, StaticMesh);
+    StaticMesh.MaterialSubsets = ObjInfo.MaterialSubsets;
+    if (StaticMesh.MaterialSubsets.IsEmpty())
+    {
+        // 머티리얼이 없는 메시도 LOD를 볼 수 있도록 전체를 서브셋 하나로 취급
+        FMaterialSubset Subset = {};
+        Subset.IndexCount = StaticMesh.Indices.Num();
+        StaticMesh.MaterialSubsets.Add(Subset);
+    }
+    FMeshOptimizer::OptimizeStaticMesh(StaticMesh);
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    FMeshSimplifier::GenerateLODs(StaticMesh);
+    const double SimplifyMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+    const uint32 NumBaseIndices = StaticMesh.GetNumBaseIndices();
+    UE_LOG(LogLevel::Display, "LOD benchmark: %s, %u vertices, %u LODs generated in %.2f ms",
+        *Path, StaticMesh.Vertices.Num(), StaticMesh.GetNumLODs(), SimplifyMs);
+    UE_LOG(LogLevel::Display, " - LOD0: %u triangles, ACMR %.3f", NumBaseIndices / 3,
+        FMeshOptimizer::AnalyzeVertexCache(StaticMesh.Indices.GetData(), NumBaseIndices, StaticMesh.Vertices.Num(), FMeshOptimizer::FifoCacheSize).ACMR);
+    for (int32 i = 0; i < StaticMesh.LODs.Num(); ++i)
+    {
+        const FStaticMeshLOD& LOD = StaticMesh.LODs[i];
+        const FVertexCacheStats Stats = FMeshOptimizer::AnalyzeVertexCache(
+            StaticMesh.Indices.GetData() + LOD.FirstIndex, LOD.NumIndices, StaticMesh.Vertices.Num(), FMeshOptimizer::FifoCacheSize);
+        UE_LOG(LogLevel::Display, " - LOD%d: %u triangles (%.1f%%), max error %.5f, ACMR %.3f",
+            i + 1, LOD.NumIndices / 3, NumBaseIndices > 0 ? 100.0 * LOD.NumIndices / NumBaseIndices : 0.0, LOD.MaxError, Stats.ACMR);
+    }
+}
+
+bool FManagerOBJ::SaveCookedStaticMesh(const FWString& CookedPath, const OBJ::FStaticMeshRenderData& StaticMesh, const FContentHash& SourceHash)
+{
+    FCookedMeshHeader Header = {};
+    std::ofstream File(CookedPath, std::ios::binary | std::ios::trunc);
+    if (!File.is_open())
+    {
+        // 로딩 스레드에서도 불리므로 로그 없이 실패만 돌려줌. 메시를 등록할 때 메인 스레드에서 알림
+        return false;
+    }
+
+    // 매직은 다 쓴 뒤에 헤더와 같이 기록하므로, 중간에 끊긴 파일은 읽을 때 거부됨
+    File.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+
+    Header.Magic = FCookedMeshHeader::ExpectedMagic;
+    Header.Version = FCookedMeshHeader::CurrentVersion;
+    Header.VertexStride = StaticMesh.GetVertexStride();
+    Header.NumVertices = StaticMesh.GetNumVertices();
+    Header.VertexFormat = static_cast<uint8>(StaticMesh.VertexFormat);
+    Header.bHasVertexNormals = StaticMesh.bHasVertexNormals;
+    Header.IndexStride = sizeof(UINT);
+    Header.NumIndices = StaticMesh.GetNumIndices();
+    Header.BoundingBoxMin = StaticMesh.BoundingBoxMin;
+    Header.BoundingBoxMax = StaticMesh.BoundingBoxMax;
+    Header.SourceHash = SourceHash;
+
+    Header.VertexOffset = PadToAlignment(File);
+    File.write(static_cast<const char*>(StaticMesh.GetVertexBufferData()), static_cast<std::streamsize>(Header.NumVertices) * Header.VertexStride);
+
+    Header.IndexOffset = PadToAlignment(File);
+    File.write(reinterpret_cast<const char*>(StaticMesh.GetIndexData()), static_cast<std::streamsize>(Header.NumIndices) * Header.IndexStride);
+
+    Header.MetadataOffset = PadToAlignment(File);
+    Serializer::WriteFWString(File, StaticMesh.ObjectName);
+    Serializer::WriteFWString(File, StaticMesh.PathName);
+    Serializer::WriteFString(File, StaticMesh.DisplayName);
+
+    uint32 MaterialCount = StaticMesh.Materials.Num();
+    File.write(reinterpret_cast<const char*>(&MaterialCount), sizeof(MaterialCount));
+    for (const FObjMaterialInfo& Material : StaticMesh.Materials)
+    {
+        WriteMaterial(File, Material);
+    }
+
+    WriteSubsets(File, StaticMesh.MaterialSubsets);
+
+    uint32 LODCount = StaticMesh.LODs.Num();
+    File.write(reinterpret_cast<const char*>(&LODCount), sizeof(LODCount));
+    for (const FStaticMeshLOD& LOD : StaticMesh.LODs)
+    {
+        File.write(reinterpret_cast<const char*>(&LOD.FirstIndex), sizeof(LOD.FirstIndex));
+        File.write(reinterpret_cast<const char*>(&LOD.NumIndices), sizeof(LOD.NumIndices));
+        File.write(reinterpret_cast<const char*>(&LOD.MaxError), sizeof(LOD.MaxError));
+        WriteSubsets(File, LOD.MaterialSubsets);
+    }
+    Header.MetadataSize = static_cast<uint64>(File.tellp()) - Header.MetadataOffset;
+
+    File.seekp(0);
+    File.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+    return File.good();
+}
+
+bool FManagerOBJ::LoadCookedStaticMesh(const FWString& CookedPath, const FContentHash& SourceHash, OBJ::FStaticMeshRenderData& OutStaticMesh)
+{
+    // 중간에 실패해도 OutStaticMesh가 반쯤 채워지지 않도록 다 읽은 뒤 옮김
+    OBJ::FStaticMeshRenderData StaticMesh = {};
+
+    const std::shared_ptr<FMappedFile> File = std::make_shared<FMappedFile>();
+    if (!File->Open(CookedPath) || File->GetSize() < sizeof(FCookedMeshHeader))
+    {
+        return false;
+    }
+
+    FCookedMeshHeader Header;
+    std::memcpy(&Header, File->GetData(), sizeof(Header));
+    if (Header.Magic != FCookedMeshHeader::ExpectedMagic || Header.Version != FCookedMeshHeader::CurrentVersion || Header.SourceHash != SourceHash ||
+        Header.VertexFormat > static_cast<uint8>(EStaticMeshVertexFormat::Compact) || Header.IndexStride != sizeof(UINT))
+    {
+        return false;
+    }
+
+    StaticMesh.VertexFormat = static_cast<EStaticMeshVertexFormat>(Header.VertexFormat);
+    StaticMesh.bHasVertexNormals = Header.bHasVertexNormals != 0;
+    if (Header.VertexStride != StaticMesh.GetVertexStride())
+    {
+        return false;
+    }
+
+    const auto IsValidBlock = [&File](uint64 Offset, uint64 Size)
+    {
+        return Offset % FCookedMeshHeader::BlockAlignment == 0 && Offset <= File->GetSize() && Size <= File->GetSize() - Offset;
+    };
+    if (!IsValidBlock(Header.VertexOffset, static_cast<uint64>(Header.NumVertices) * Header.VertexStride) ||
+        !IsValidBlock(Header.IndexOffset, static_cast<uint64>(Header.NumIndices) * Header.IndexStride) ||
+        !IsValidBlock(Header.MetadataOffset, Header.MetadataSize))
+    {
+        return false;
+    }
+
+    FMemoryReadBuffer MetadataBuffer(File->GetData() + Header.MetadataOffset, Header.MetadataSize);
+    std::istream Metadata(&MetadataBuffer);
+
+    Serializer::ReadFWString(Metadata, StaticMesh.ObjectName);
+    Serializer::ReadFWString(Metadata, StaticMesh.PathName);
+    Serializer::ReadFString(Metadata, StaticMesh.DisplayName);
+
+    uint32 MaterialCount = 0;
+    Metadata.read(reinterpret_cast<char*>(&MaterialCount), sizeof(MaterialCount));
+    StaticMesh.Materials.SetNum(MaterialCount);
+    for (FObjMaterialInfo& Material : StaticMesh.Materials)
+    {
+        ReadMaterial(Metadata, Material);
+    }
+
+    ReadSubsets(Metadata, StaticMesh.MaterialSubsets);
+
+    uint32 LODCount = 0;
+    Metadata.read(reinterpret_cast<char*>(&LODCount), sizeof(LODCount));
+    StaticMesh.LODs.SetNum(Metadata.good() ? LODCount : 0);
+    for (FStaticMeshLOD& LOD : StaticMesh.LODs)
+    {
+        Metadata.read(reinterpret_cast<char*>(&LOD.FirstIndex), sizeof(LOD.FirstIndex));
+        Metadata.read(reinterpret_cast<char*>(&LOD.NumIndices), sizeof(LOD.NumIndices));
+        Metadata.read(reinterpret_cast<char*>(&LOD.MaxError), sizeof(LOD.MaxError));
+        ReadSubsets(Metadata, LOD.MaterialSubsets);
+
+        // LOD 구간은 매핑된 인덱스 버퍼 안에 있어야 하고, 서브셋은 LOD0과 개수가 같아야 함
+        if (static_cast<uint64>(LOD.FirstIndex) + LOD.NumIndices > Header.NumIndices ||
+            LOD.MaterialSubsets.Num() != StaticMesh.MaterialSubsets.Num())
+        {
+            return false;
+        }
+    }
+
+    if (!Metadata.good())
+    {
+        return false;
+    }
+
+    // 정점과 인덱스는 복사하지 않음. 매핑은 RenderData가 살아 있는 동안 유지됨
+    StaticMesh.CookedFile = File;
+    const uint8* VertexData = Header.NumVertices > 0 ? File->GetData() + Header.VertexOffset : nullptr;
+    if (StaticMesh.IsCompact())
+    {
+        StaticMesh.MappedCompactVertices = reinterpret_cast<const FVertexCompact*>(VertexData);
+    }
+    else
+    {
+        StaticMesh.MappedVertices = reinterpret_cast<const FVertexSimple*>(VertexData);
+    }
+    StaticMesh.NumMappedVertices = Header.NumVertices;
+    StaticMesh.MappedIndices = Header.NumIndices > 0 ? reinterpret_cast<const UINT*>(File->GetData() + Header.IndexOffset) : nullptr;
+    StaticMesh.NumMappedIndices = Header.NumIndices;
+    StaticMesh.BoundingBoxMin = Header.BoundingBoxMin;
+    StaticMesh.BoundingBoxMax = Header.BoundingBoxMax;
+    OutStaticMesh = std::move(StaticMesh);
+    return true;
+}
 
 UMaterial* FManagerOBJ::CreateMaterial(FObjMaterialInfo materialInfo)
 {
@@ -21,20 +1438,300 @@ UMaterial* FManagerOBJ::GetMaterial(FString name)
 
 UStaticMesh* FManagerOBJ::CreateStaticMesh(FString filePath)
 {
-
     OBJ::FStaticMeshRenderData* StaticMeshRenderData = FManagerOBJ::LoadObjStaticMeshAsset(filePath);
 
     if (StaticMeshRenderData == nullptr) return nullptr;
 
-    UStaticMesh* staticMesh = GetStaticMesh(StaticMeshRenderData->ObjectName);
-    if (staticMesh != nullptr) {
-        return staticMesh;
+    return FindOrCreateStaticMesh(StaticMeshRenderData);
+}
+
+FAsyncLoadHandle FManagerOBJ::CreateStaticMeshAsync(const FString& filePath, EAsyncLoadPriority Priority, const FOnStaticMeshLoaded& OnLoaded)
+{
+    if (ObjStaticMeshMap.Contains(filePath))
+    {
+        OnLoaded.ExecuteIfBound(CreateStaticMesh(filePath));
+        return FAsyncLoadHandle{};
+    }
+
+    return FAsyncLoader::RequestStaticMesh(filePath, Priority, OnLoaded);
+}
+
+UStaticMesh* FManagerOBJ::CreateStaticMeshFromRenderData(const FString& filePath, OBJ::FStaticMeshRenderData* RenderData, bool bLoadTexturesAsync)
+{
+    return FindOrCreateStaticMesh(RegisterObjStaticMeshAsset(filePath, RenderData, bLoadTexturesAsync));
+}
+
+UStaticMesh* FManagerOBJ::GetPlaceholderStaticMesh()
+{
+    if (PlaceholderStaticMesh != nullptr)
+    {
+        return PlaceholderStaticMesh;
+    }
+
+    OBJ::FStaticMeshRenderData* RenderData = new OBJ::FStaticMeshRenderData();
+    RenderData->ObjectName = L"Placeholder";
+    RenderData->DisplayName = "Placeholder";
+
+    for (uint32 Corner = 0; Corner < 8; ++Corner)
+    {
+        FVertexSimple Vertex {};
+        Vertex.x = (Corner & 1) ? 0.5f : -0.5f;
+        Vertex.y = (Corner & 2) ? 0.5f : -0.5f;
+        Vertex.z = (Corner & 4) ? 0.5f : -0.5f;
+        Vertex.r = 0.5f; Vertex.g = 0.5f; Vertex.b = 0.5f; Vertex.a = 1.0f;
+        RenderData->Vertices.Add(Vertex);
+    }
+
+    // 면마다 꼭짓점 4개 (비트 0: x, 1: y, 2: z)
+    constexpr uint32 Faces[6][4] = {
+        { 0, 2, 6, 4 }, { 1, 5, 7, 3 }, // -x, +x
+        { 0, 4, 5, 1 }, { 2, 3, 7, 6 }, // -y, +y
+        { 0, 1, 3, 2 }, { 4, 6, 7, 5 }, // -z, +z
+    };
+    for (const uint32* Face : Faces)
+    {
+        for (const uint32 Corner : { Face[0], Face[1], Face[2], Face[0], Face[2], Face[3] })
+        {
+            RenderData->Indices.Add(Corner);
+        }
+    }
+    FLoaderOBJ::ComputeBoundingBox(RenderData->Vertices, RenderData->BoundingBoxMin, RenderData->BoundingBoxMax);
+
+    FObjMaterialInfo Material;
+    Material.MTLName = "Placeholder";
+    Material.Diffuse = FVector(0.5f, 0.5f, 0.5f);
+    Material.SpecularScalar = 0.0f;
+    Material.DensityScalar = 1.0f;
+    Material.TransparencyScalar = 1.0f;
+    Material.IlluminanceModel = 1;
+    RenderData->Materials.Add(Material);
+
+    FMaterialSubset Subset;
+    Subset.MaterialName = Material.MTLName;
+    Subset.IndexStart = 0;
+    Subset.IndexCount = RenderData->Indices.Num();
+    Subset.MaterialIndex = 0;
+    RenderData->MaterialSubsets.Add(Subset);
+
+    // 에디터의 메시 목록에 보이지 않도록 StaticMeshMap에는 넣지 않음
+    PlaceholderStaticMesh = FObjectFactory::ConstructObject<UStaticMesh>();
+    PlaceholderStaticMesh->SetData(RenderData);
+    return PlaceholderStaticMesh;
+}
+
+OBJ::FStaticMeshRenderData* FManagerOBJ::LoadObjStaticMeshAsset(const FString& PathFileName)
+{
+    if (const auto It = ObjStaticMeshMap.Find(PathFileName))
+    {
+        return *It;
+    }
+
+    // 로딩 스레드가 읽는 중이면 같은 파일을 두 번 읽지 않고 결과를 기다림
+    const FAsyncLoadHandle PendingRequest = FAsyncLoader::FindStaticMeshRequest(PathFileName);
+    if (PendingRequest.IsValid())
+    {
+        FAsyncLoader::Wait(PendingRequest);
+        const auto It = ObjStaticMeshMap.Find(PathFileName);
+        return It ? *It : nullptr;
+    }
+
+    OBJ::FStaticMeshRenderData* NewStaticMesh = new OBJ::FStaticMeshRenderData();
+    if (!BuildStaticMeshRenderData(PathFileName, *NewStaticMesh))
+    {
+        delete NewStaticMesh;
+        return nullptr;
+    }
+
+    return RegisterObjStaticMeshAsset(PathFileName, NewStaticMesh, false);
+}
+
+namespace
+{
+    struct FMaterialLibraryEntry
+    {
+        FContentHash ObjHash;
+        FWString MaterialPath;
+    };
+
+    /** .obj 경로별로 찾아 둔 .mtl 경로. .obj 내용이 바뀌지 않았으면 다시 훑지 않음 */
+    std::mutex MaterialLibraryMutex;
+    TMap<FWString, FMaterialLibraryEntry> MaterialLibraries;
+
+    /**
+     * ParseMaterial이 열 .mtl 경로를 찾습니다. ParseOBJ처럼 마지막 mtllib 줄을 쓰고, 없으면 빈 경로
+     * 로딩 스레드에서도 부르므로 로그를 남기지 않음
+     */
+    bool FindMaterialLibraryPath(const FWString& ObjPath, const FContentHash& ObjHash, FWString& OutPath)
+    {
+        {
+            std::lock_guard Lock(MaterialLibraryMutex);
+            const FMaterialLibraryEntry* Entry = MaterialLibraries.Find(ObjPath);
+            if (Entry && Entry->ObjHash == ObjHash)
+            {
+                OutPath = Entry->MaterialPath;
+                return true;
+            }
+        }
+
+        FMappedFile File;
+        if (!File.Open(ObjPath))
+        {
+            return false;
+        }
+
+        const char* Cur = reinterpret_cast<const char*>(File.GetData());
+        const char* End = Cur + File.GetSize();
+        std::string Name;
+        bool bFound = false;
+        while (Cur < End)
+        {
+            Cur = SkipBlanks(Cur, End);
+            const char* LineEnd = NextLine(Cur, End);
+            if (MatchKeyword(Cur, LineEnd, "mtllib", 6))
+            {
+                ParseName(Cur + 6, LineEnd, Name);
+                bFound = true;
+            }
+            Cur = LineEnd;
+        }
+
+        // SetObjNames + ParseMaterial과 같은 경로
+        OutPath.clear();
+        if (bFound)
+        {
+            OutPath = ObjPath.substr(0, ObjPath.find_last_of(L"\\/") + 1) + FString(Name).ToWideString();
+        }
+
+        std::lock_guard Lock(MaterialLibraryMutex);
+        MaterialLibraries.Add(ObjPath, { ObjHash, OutPath });
+        return true;
+    }
+}
+
+bool FManagerOBJ::BuildStaticMeshRenderData(const FString& PathFileName, OBJ::FStaticMeshRenderData& OutStaticMesh, bool bAllowParallel)
+{
+    const FWString ObjPath = PathFileName.ToWideString();
+    FContentHash SourceHash;
+    if (!FDerivedDataCache::HashSourceFile(ObjPath, SourceHash))
+    {
+        return false;
+    }
+
+    // 쿡한 메시에는 .mtl에서 읽은 머티리얼도 들어가므로 .mtl 내용도 키에 섞음. .mtl이 없으면 빈 해시
+    FWString MaterialPath;
+    if (!FindMaterialLibraryPath(ObjPath, SourceHash, MaterialPath))
+    {
+        return false;
+    }
+    FContentHash MaterialHash;
+    if (MaterialPath.empty() || !FDerivedDataCache::HashSourceFile(MaterialPath, MaterialHash))
+    {
+        MaterialHash = FContentHash();
+    }
+    SourceHash = FContentHash::Compute(&MaterialHash, sizeof(MaterialHash), SourceHash);
+
+    const FContentHash Key = FDerivedDataCache::MakeKey(EDerivedDataType::StaticMesh, FCookedMeshHeader::CurrentVersion, SourceHash);
+    FWString CookedPath;
+    if (FDerivedDataCache::FindFile(EDerivedDataType::StaticMesh, Key, CookedPath) && LoadCookedStaticMesh(CookedPath, SourceHash, OutStaticMesh))
+    {
+        OutStaticMesh.DerivedDataKey = Key;
+        return true;
+    }
+
+    // Parse OBJ
+    FObjInfo NewObjInfo;
+    if (!FLoaderOBJ::ParseOBJ(PathFileName, NewObjInfo, bAllowParallel))
+    {
+        return false;
+    }
+
+    // Material
+    if (NewObjInfo.MaterialSubsets.Num() > 0)
+    {
+        if (!FLoaderOBJ::ParseMaterial(NewObjInfo, OutStaticMesh))
+        {
+            return false;
+        }
+
+        CombineMaterialIndex(OutStaticMesh);
+    }
+
+    // Convert FStaticMeshRenderData
+    if (!FLoaderOBJ::ConvertToStaticMesh(NewObjInfo, OutStaticMesh, bAllowParallel))
+    {
+        return false;
+    }
+    // 정점 순서가 바뀌므로 압축 전에 최적화
+    FMeshOptimizer::OptimizeStaticMesh(OutStaticMesh);
+    // LOD는 최적화된 LOD0의 정점 버퍼를 같이 쓰고 삼각형 순서를 이어받음
+    FMeshSimplifier::GenerateLODs(OutStaticMesh);
+    FLoaderOBJ::CompressVertices(OutStaticMesh, bAllowParallel);
+
+    if (FDerivedDataCache::PutFile(EDerivedDataType::StaticMesh, Key, [&OutStaticMesh, &SourceHash](const FWString& TempPath)
+    {
+        return SaveCookedStaticMesh(TempPath, OutStaticMesh, SourceHash);
+    }))
+    {
+        OutStaticMesh.DerivedDataKey = Key;
+    }
+    return true;
+}
+
+OBJ::FStaticMeshRenderData* FManagerOBJ::RegisterObjStaticMeshAsset(const FString& PathFileName, OBJ::FStaticMeshRenderData* RenderData, bool bLoadTexturesAsync)
+{
+    if (const auto It = ObjStaticMeshMap.Find(PathFileName))
+    {
+        delete RenderData;
+        return *It;
+    }
+
+    // 빌드한 스레드에서는 로그를 남길 수 없으므로 DDC에 넣지 못한 것을 여기서 알림
+    if (RenderData->DerivedDataKey.IsZero() && FDerivedDataCache::IsInitialized())
+    {
+        UE_LOG(LogLevel::Warning, "Can't save cooked static mesh to the derived data cache: %s", *PathFileName);
+    }
+
+    for (const FObjMaterialInfo& Material : RenderData->Materials)
+    {
+        CreateMaterial(Material);
+
+        // Texture Load
+        for (const FWString* TexturePath : { &Material.DiffuseTexturePath, &Material.AmbientTexturePath, &Material.SpecularTexturePath,
+                                             &Material.BumpTexturePath, &Material.AlphaTexturePath })
+        {
+            if (TexturePath->empty() || FEngineLoop::ResourceManager.GetTexture(*TexturePath) != nullptr)
+            {
+                continue;
+            }
+
+            // 텍스처가 늦게 도착해도 렌더러가 매 프레임 경로로 찾으므로 콜백이 필요 없음
+            if (bLoadTexturesAsync)
+            {
+                FAsyncLoader::RequestTexture(*TexturePath, EAsyncLoadPriority::Normal, FOnTextureLoaded());
+            }
+            else
+            {
+                FLoaderOBJ::CreateTextureFromFile(*TexturePath);
+            }
+        }
+    }
+
+    ObjStaticMeshMap.Add(PathFileName, RenderData);
+    return RenderData;
+}
+
+UStaticMesh* FManagerOBJ::FindOrCreateStaticMesh(OBJ::FStaticMeshRenderData* RenderData)
+{
+    if (UStaticMesh* const* Found = StaticMeshMap.Find(RenderData->ObjectName); Found && *Found)
+    {
+        return *Found;
     }
 
-    staticMesh = FObjectFactory::ConstructObject<UStaticMesh>();
-    staticMesh->SetData(StaticMeshRenderData);
+    UStaticMesh* staticMesh = FObjectFactory::ConstructObject<UStaticMesh>();
+    staticMesh->SetData(RenderData);
 
-    StaticMeshMap.Add(StaticMeshRenderData->ObjectName, staticMesh);
+    StaticMeshMap.Add(RenderData->ObjectName, staticMesh);
+    return staticMesh;
 }
 
 UStaticMesh* FManagerOBJ::GetStaticMesh(FWString name)
@@ -4,6 +4,7 @@
 
 #include "Define.h"
 #include "EngineLoop.h"
+#include "Engine/AsyncLoader.h"
 #include "Container/Map.h"
 #include "HAL/PlatformType.h"
 #include "Serialization/Serializer.h"
@@ -12,15 +13,32 @@ class UStaticMesh;
 struct FManagerOBJ;
 struct FLoaderOBJ
 {
-    // Obj Parsing (*.obj to FObjInfo)
-    static bool ParseOBJ(const FString& ObjFilePath, FObjInfo& OutObjInfo)
+    /**
+     * Obj Parsing (*.obj to FObjInfo)
+     * 파일 전체를 한 번에 읽은 뒤 버퍼 안에서 바로 토큰을 나누고 std::from_chars로 숫자를 읽습니다.
+     * 줄/토큰마다 문자열을 만들지 않으며, 5각형 이상의 면은 삼각형 팬으로 나눕니다.
+     * @param bAllowParallel true면 큰 파일은 ParseOBJBufferParallel로 나눠서 파싱
+     */
+    static bool ParseOBJ(const FString& ObjFilePath, FObjInfo& OutObjInfo, bool bAllowParallel = true);
+
+    /** [Begin, End) 범위의 OBJ 텍스트를 OutObjInfo에 이어서 파싱합니다. 이름 정보는 건드리지 않습니다. */
+    static void ParseOBJBuffer(const char* Begin, const char* End, FObjInfo& OutObjInfo);
+
+    /**
+     * ParseOBJBuffer와 같은 결과를 만들되, 버퍼를 줄 경계에서 청크로 잘라 워커 스레드에서 동시에 파싱한 뒤 이어 붙입니다.
+     * 음수(상대) 인덱스는 앞 청크들의 개수만큼 보정하고, usemtl 서브셋은 청크 경계를 넘어 이어집니다.
+     */
+    static void ParseOBJBufferParallel(const char* Begin, const char* End, FObjInfo& OutObjInfo);
+
+    /** 청크 하나의 최소 크기. 이보다 작은 파일은 한 스레드에서 파싱 */
+    static constexpr size_t MinParallelChunkSize = 1 << 20;
+
+    /** 스레드마다 나눌 청크 수. 줄 길이가 고르지 않아도 부하가 맞도록 스레드 수보다 잘게 나눔 */
+    static constexpr uint32 ParallelChunksPerThread = 4;
+
+    /** 파일 경로로 ObjectName, PathName, DisplayName을 채웁니다. */
+    static void SetObjNames(const FString& ObjFilePath, FObjInfo& OutObjInfo)
     {
-        std::ifstream OBJ(ObjFilePath.ToWideString());
-        if (!OBJ)
-        {
-            return false;
-        }
-
         OutObjInfo.PathName = ObjFilePath.ToWideString().substr(0, ObjFilePath.ToWideString().find_last_of(L"\\/") + 1);
         OutObjInfo.ObjectName = ObjFilePath.ToWideString().substr(ObjFilePath.ToWideString().find_last_of(L"\\/") + 1);
         // ObjectName은 wstring 타입이므로, 이를 string으로 변환 (간단한 ASCII 변환의 경우)
@@ -34,170 +52,28 @@ struct FLoaderOBJ
         } else {
             OutObjInfo.DisplayName = fileName;
         }
-        
-        std::string Line;
-
-        while (std::getline(OBJ, Line))
-        {
-            if (Line.empty() || Line[0] == '#')
-                continue;
-            
-            std::istringstream LineStream(Line);
-            std::string Token;
-            LineStream >> Token;
-
-            if (Token == "mtllib")
-            {
-                LineStream >> Line;
-                OutObjInfo.MatName = Line;
-                continue;
-            }
-
-            if (Token == "usemtl")
-            {
-                LineStream >> Line;
-                FString MatName(Line);
+    }
 
-                if (!OutObjInfo.MaterialSubsets.IsEmpty())
-                {
-                    FMaterialSubset& LastSubset = OutObjInfo.MaterialSubsets[OutObjInfo.MaterialSubsets.Num() - 1];
-                    LastSubset.IndexCount = OutObjInfo.VertexIndices.Num() - LastSubset.IndexStart;
-                }
-                
-                FMaterialSubset MaterialSubset;
-                MaterialSubset.MaterialName = MatName;
-                MaterialSubset.IndexStart = OutObjInfo.VertexIndices.Num();
-                MaterialSubset.IndexCount = 0;
-                OutObjInfo.MaterialSubsets.Add(MaterialSubset);
-            }
+    /**
+     * ObjFilePath를 ParseOBJLegacy, ParseOBJ(한 스레드), ParseOBJ(병렬)로 각각 파싱해서 처리량(MB/s)과 결과 일치 여부를 로그로 남깁니다.
+     * 경로가 비어 있으면 GridSize x GridSize 사각형 격자 OBJ를 임시 폴더에 만들어서 씁니다.
+     */
+    static void BenchmarkParseOBJ(const FString& ObjFilePath, uint32 GridSize = 1024);
 
-            if (Token == "g" || Token == "o")
-            {
-                LineStream >> Line;
-                OutObjInfo.GroupName.Add(Line);
-                OutObjInfo.NumOfGroup++;
-            }
+    /** ObjFilePath를 파싱한 뒤 ConvertToStaticMesh와 ConvertToStaticMeshLegacy의 시간과 결과 일치 여부를 로그로 남깁니다. */
+    static void BenchmarkConvertToStaticMesh(const FString& ObjFilePath);
 
-            if (Token == "v") // Vertex
-            {
-                float x, y, z;
-                LineStream >> x >> y >> z;
-                OutObjInfo.Vertices.Add(FVector(x,y,z));
-                continue;
-            }
+    /** ObjFilePath를 압축 정점으로 바꿔서 크기, 인코딩 시간, 디코드한 위치와 UV의 최대 오차를 로그로 남깁니다. */
+    static void BenchmarkVertexCompression(const FString& ObjFilePath);
 
-            if (Token == "vn") // Normal
-            {
-                float nx, ny, nz;
-                LineStream >> nx >> ny >> nz;
-                OutObjInfo.Normals.Add(FVector(nx,ny,nz));
-                continue;
-            }
+    /** ObjFilePath를 FMeshOptimizer로 최적화하기 전과 후의 ACMR/ATVR과 걸린 시간을 로그로 남깁니다. */
+    static void BenchmarkMeshOptimization(const FString& ObjFilePath);
 
-            if (Token == "vt") // Texture
-            {
-                float u, v;
-                LineStream >> u >> v;
-                OutObjInfo.UVs.Add(FVector2D(u, v));
-                continue;
-            }
+    /** ObjFilePath를 최적화한 뒤 FMeshSimplifier로 LOD를 만들어서 LOD마다 삼각형 수, 최대 오차, ACMR과 걸린 시간을 로그로 남깁니다. */
+    static void BenchmarkLODGeneration(const FString& ObjFilePath);
 
-            if (Token == "f")
-            {
-                TArray<uint32> faceVertexIndices;  // 이번 페이스의 정점 인덱스
-                TArray<uint32> faceNormalIndices;  // 이번 페이스의 법선 인덱스
-                TArray<uint32> faceTextureIndices; // 이번 페이스의 텍스처 인덱스
-                
-                while (LineStream >> Token)
-                {
-                    std::istringstream tokenStream(Token);
-                    std::string part;
-                    TArray<std::string> facePieces;
-
-                    // '/'로 분리하여 v/vt/vn 파싱
-                    while (std::getline(tokenStream, part, '/'))
-                    {
-                        facePieces.Add(part);
-                    }
-
-                    // OBJ 인덱스는 1부터 시작하므로 -1로 변환
-                    uint32 vertexIndex = facePieces[0].empty() ? 0 : std::stoi(facePieces[0]) - 1;
-                    uint32 textureIndex = (facePieces.Num() > 1 && !facePieces[1].empty()) ? std::stoi(facePieces[1]) - 1 : UINT32_MAX;
-                    uint32 normalIndex = (facePieces.Num() > 2 && !facePieces[2].empty()) ? std::stoi(facePieces[2]) - 1 : UINT32_MAX;
-
-                    faceVertexIndices.Add(vertexIndex);
-                    faceTextureIndices.Add(textureIndex);
-                    faceNormalIndices.Add(normalIndex);
-                }
-
-                if (faceVertexIndices.Num() == 4) // 쿼드
-                {
-                    // 첫 번째 삼각형: 0-1-2
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[0]);
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[1]);
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[2]);
-
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[0]);
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[1]);
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[2]);
-
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[0]);
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[1]);
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[2]);
-
-                    // 두 번째 삼각형: 0-2-3
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[0]);
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[2]);
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[3]);
-
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[0]);
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[2]);
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[3]);
-
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[0]);
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[2]);
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[3]);
-                }
-                else if (faceVertexIndices.Num() == 3) // 삼각형
-                {
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[0]);
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[1]);
-                    OutObjInfo.VertexIndices.Add(faceVertexIndices[2]);
-
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[0]);
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[1]);
-                    OutObjInfo.TextureIndices.Add(faceTextureIndices[2]);
-
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[0]);
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[1]);
-                    OutObjInfo.NormalIndices.Add(faceNormalIndices[2]);
-                }
-                // // 삼각형화 (삼각형 팬 방식)
-                // for (int j = 1; j + 1 < faceVertexIndices.Num(); j++)
-                // {
-                //     OutObjInfo.VertexIndices.Add(faceVertexIndices[0]);
-                //     OutObjInfo.VertexIndices.Add(faceVertexIndices[j]);
-                //     OutObjInfo.VertexIndices.Add(faceVertexIndices[j + 1]);
-                //
-                //     OutObjInfo.TextureIndices.Add(faceTextureIndices[0]);
-                //     OutObjInfo.TextureIndices.Add(faceTextureIndices[j]);
-                //     OutObjInfo.TextureIndices.Add(faceTextureIndices[j + 1]);
-                //
-                //     OutObjInfo.NormalIndices.Add(faceNormalIndices[0]);
-                //     OutObjInfo.NormalIndices.Add(faceNormalIndices[j]);
-                //     OutObjInfo.NormalIndices.Add(faceNormalIndices[j + 1]);
-                // }
-            }
-        }
-
-        if (!OutObjInfo.MaterialSubsets.IsEmpty())
-        {
-            FMaterialSubset& LastSubset = OutObjInfo.MaterialSubsets[OutObjInfo.MaterialSubsets.Num() - 1];
-            LastSubset.IndexCount = OutObjInfo.VertexIndices.Num() - LastSubset.IndexStart;
-        }
-        
-        return true;
-    }
+    /** v/vt/vn과 4각형 면으로 된 GridSize x GridSize 격자 OBJ를 씁니다. */
+    static bool WriteGridOBJ(const FWString& FilePath, uint32 GridSize);
     
     // Material Parsing (*.obj to MaterialInfo)
     static bool ParseMaterial(FObjInfo& OutObjInfo, OBJ::FStaticMeshRenderData& OutFStaticMesh)
@@ -300,68 +176,33 @@ struct FLoaderOBJ
                 OutFStaticMesh.Materials[MaterialIndex].DiffuseTexturePath = TexturePath;
                 OutFStaticMesh.Materials[MaterialIndex].bHasTexture = true;
 
-                CreateTextureFromFile(OutFStaticMesh.Materials[MaterialIndex].DiffuseTexturePath);
+                // GPU 텍스처는 메인 스레드에서 메시를 등록할 때 만듦 (RegisterObjStaticMeshAsset)
             }
         }
         
         return true;
     }
     
-    // Convert the Raw data to Cooked data (FStaticMeshRenderData)
-    static bool ConvertToStaticMesh(const FObjInfo& RawData, OBJ::FStaticMeshRenderData& OutStaticMesh)
-    {
-        OutStaticMesh.ObjectName = RawData.ObjectName;
-        OutStaticMesh.PathName = RawData.PathName;
-        OutStaticMesh.DisplayName = RawData.DisplayName;
-
-        // 고유 정점을 기반으로 FVertexSimple 배열 생성
-        TMap<std::string, uint32> vertexMap; // 중복 체크용
-
-        for (int32 i = 0; i < RawData.VertexIndices.Num(); i++)
-        {
-            uint32 vIdx = RawData.VertexIndices[i];
-            uint32 tIdx = RawData.TextureIndices[i];
-            uint32 nIdx = RawData.NormalIndices[i];
-
-            // 키 생성 (v/vt/vn 조합)
-            std::string key = std::to_string(vIdx) + "/" + 
-                             std::to_string(tIdx) + "/" + 
-                             std::to_string(nIdx);
-
-            uint32 index;
-            if (vertexMap.Find(key) == nullptr)
-            {
-                FVertexSimple vertex {};
-                vertex.x = RawData.Vertices[vIdx].x;
-                vertex.y = RawData.Vertices[vIdx].y;
-                vertex.z = RawData.Vertices[vIdx].z;
-
-                vertex.r = 0.0f; vertex.g = 0.0f; vertex.b = 0.0f; vertex.a = 1.0f; // 기본 색상
-
-                if (tIdx != UINT32_MAX && tIdx < RawData.UVs.Num())
-                {
-                    vertex.u = RawData.UVs[tIdx].x;
-                    vertex.v = -RawData.UVs[tIdx].y;
-                }
-                
-                index = OutStaticMesh.Vertices.Num();
-                OutStaticMesh.Vertices.Add(vertex);
-                vertexMap[key] = index;
-            }
-            else
-            {
-                index = vertexMap[key];
-            }
-
-            OutStaticMesh.Indices.Add(index);
-            
-        }
-
-        // Calculate StaticMesh BoundingBox
-        ComputeBoundingBox(OutStaticMesh.Vertices, OutStaticMesh.BoundingBoxMin, OutStaticMesh.BoundingBoxMax);
-        
-        return true;
-    }
+    /**
+     * Convert the Raw data to Cooked data (FStaticMeshRenderData)
+     * v/vt/vn 인덱스 3개를 묶은 96비트 키로 개방 주소법 해시 테이블을 만들어 같은 꼭짓점을 합칩니다.
+     * 꼭짓점이 많으면 워커 스레드에서 나눠 처리하며, 정점 순서는 처음 나온 순서로 이전 문자열 키 방식과 같습니다.
+     * @param bAllowParallel false면 호출한 스레드에서만 처리. 로딩 스레드는 false로 부름
+     * @return 면의 위치 인덱스가 정점 범위를 벗어나면 false
+     */
+    static bool ConvertToStaticMesh(const FObjInfo& RawData, OBJ::FStaticMeshRenderData& OutStaticMesh, bool bAllowParallel = true);
+
+    /** 이보다 꼭짓점이 적으면 한 스레드에서 합침 */
+    static constexpr uint32 WeldParallelBatchSize = 1 << 14;
+
+    /**
+     * 메시에 맞는 정점 형식을 고르고, Compact면 Vertices와 Normals를 CompactVertices로 옮긴 뒤 비웁니다.
+     * UV가 MaxCompactTexCoord를 넘으면 half로는 텍셀 단위 정밀도가 모자라므로 Full로 둡니다.
+     */
+    static EStaticMeshVertexFormat CompressVertices(OBJ::FStaticMeshRenderData& InOutStaticMesh, bool bAllowParallel = true);
+
+    /** 압축 정점을 쓸 수 있는 UV의 최대 절댓값. [1, 2) 구간의 half 간격이 1/1024 */
+    static constexpr float MaxCompactTexCoord = 2.0f;
 
     static bool CreateTextureFromFile(const FWString& Filename)
     {
@@ -402,69 +243,57 @@ struct FLoaderOBJ
     }
 };
 
+/**
+ * 쿡 파일의 헤더. 파일 맨 앞에 있고, 각 블록은 파일 시작 기준 오프셋으로 찾습니다.
+ * 정점/인덱스 구조나 배치가 바뀌면 CurrentVersion을 올려서 이전 파일을 다시 쿡하게 합니다. CurrentVersion은 DDC 키에도 들어가므로 이전 항목은 찾지 않음
+ */
+struct FCookedMeshHeader
+{
+    static constexpr uint32 ExpectedMagic = 0x48534D43; // "CMSH"
+    static constexpr uint32 CurrentVersion = 6;
+    static constexpr uint64 BlockAlignment = 16;
+
+    uint32 Magic;
+    uint32 Version;
+
+    // 정점/인덱스 블록
+    uint32 VertexStride;
+    uint32 NumVertices;
+    uint64 VertexOffset;
+    uint32 IndexStride;
+    uint32 NumIndices;
+    uint64 IndexOffset;
+
+    // EStaticMeshVertexFormat. VertexStride는 이 형식의 정점 크기와 같아야 함
+    uint8 VertexFormat;
+    uint8 bHasVertexNormals;
+    uint8 Padding[6];
+
+    // 이름, 머티리얼, 서브셋, LOD (Serializer 형식)
+    uint64 MetadataOffset;
+    uint64 MetadataSize;
+
+    FVector BoundingBoxMin;
+    FVector BoundingBoxMax;
+
+    // 쿡할 때의 원본(.obj와 .mtl) 해시. DDC를 거치지 않고 읽을 때도 원본이 바뀐 쿡 파일을 거부할 수 있게 함
+    FContentHash SourceHash;
+};
+
 struct FManagerOBJ
 {
 public:
-    static OBJ::FStaticMeshRenderData* LoadObjStaticMeshAsset(const FString& PathFileName)
-    {
-        OBJ::FStaticMeshRenderData* NewStaticMesh = new OBJ::FStaticMeshRenderData();
-        
-        if ( const auto It = ObjStaticMeshMap.Find(PathFileName))
-        {
-            return *It;
-        }
-        
-        FWString BinaryPath = (PathFileName + ".bin").ToWideString();
-        if (std::ifstream(BinaryPath).good())
-        {
-            if (LoadStaticMeshFromBinary(BinaryPath, *NewStaticMesh))
-            {
-                ObjStaticMeshMap.Add(PathFileName, NewStaticMesh);
-                return NewStaticMesh;
-            }
-        }
-        
-        // Parse OBJ
-        FObjInfo NewObjInfo;
-        bool Result = FLoaderOBJ::ParseOBJ(PathFileName, NewObjInfo);
-
-        if (!Result)
-        {
-            delete NewStaticMesh;
-            return nullptr;
-        }
-
-        // Material
-        if (NewObjInfo.MaterialSubsets.Num() > 0)
-        {
-            Result = FLoaderOBJ::ParseMaterial(NewObjInfo, *NewStaticMesh);
-
-            if (!Result)
-            {
-                delete NewStaticMesh;
-                return nullptr;
-            }
+    /** .obj를 읽어 등록합니다. 이미 등록됐으면 그대로 돌려주고, FAsyncLoader가 읽는 중이면 끝날 때까지 기다립니다. */
+    static OBJ::FStaticMeshRenderData* LoadObjStaticMeshAsset(const FString& PathFileName);
 
-            CombineMaterialIndex(*NewStaticMesh);
+    /**
+     * .obj와 참조하는 .mtl 내용의 해시로 DDC에서 쿡 결과를 찾아 매핑해서 읽고, 없으면 .obj와 .mtl을 파싱해서 쿡한 뒤 DDC에 넣습니다.
+     * 전역 맵, UObject, GPU 리소스를 건드리지 않으므로 FAsyncLoader의 로딩 스레드에서 호출해도 됩니다.
+     * @param bAllowParallel 파싱과 용접, 압축을 FJobSystem 워커에 나눌지 여부. 로딩 스레드는 워커(메인 스레드 포함)에 긴 작업을
+     *        넣어 프레임을 붙잡지 않도록 false로 부름
+     */
+    static bool BuildStaticMeshRenderData(const FString& PathFileName, OBJ::FStaticMeshRenderData& OutStaticMesh, bool bAllowParallel = true);
 
-            for (int materialIndex = 0; materialIndex < NewStaticMesh->Materials.Num(); materialIndex++) {
-                CreateMaterial(NewStaticMesh->Materials[materialIndex]);
-            }
-        }
-        
-        // Convert FStaticMeshRenderData
-        Result = FLoaderOBJ::ConvertToStaticMesh(NewObjInfo, *NewStaticMesh);
-        if (!Result)
-        {
-            delete NewStaticMesh;
-            return nullptr;
-        }
-
-        SaveStaticMeshToBinary(BinaryPath, *NewStaticMesh);
-        ObjStaticMeshMap.Add(PathFileName, NewStaticMesh);
-        return NewStaticMesh;
-    }
-    
     static void CombineMaterialIndex(OBJ::FStaticMeshRenderData& OutFStaticMesh)
     {
         for (int32 i = 0; i < OutFStaticMesh.MaterialSubsets.Num(); i++)
@@ -481,208 +310,53 @@ public:
         }
     }
 
-    static bool SaveStaticMeshToBinary(const FWString& FilePath, const OBJ::FStaticMeshRenderData& StaticMesh)
-    {
-        std::ofstream File(FilePath, std::ios::binary);
-        if (!File.is_open())
-        {
-            assert("CAN'T SAVE STATIC MESH BINARY FILE");
-            return false;
-        }
-
-        // Object Name
-        Serializer::WriteFWString(File, StaticMesh.ObjectName);
+    /**
+     * StaticMesh를 쿡 파일로 저장합니다.
+     * 정점(StaticMesh의 형식 그대로)과 인덱스는 BlockAlignment에 맞춘 위치에 쓰고, 가변 길이 데이터는 그 뒤에 둡니다.
+     * @param SourceHash 쿡한 원본의 해시. 헤더에 기록해서 읽을 때 비교함
+     */
+    static bool SaveCookedStaticMesh(const FWString& CookedPath, const OBJ::FStaticMeshRenderData& StaticMesh, const FContentHash& SourceHash);
 
-        // Path Name
-        Serializer::WriteFWString(File, StaticMesh.PathName);
-
-        // Display Name
-        Serializer::WriteFString(File, StaticMesh.DisplayName);
-
-        // Vertices
-        uint32 VertexCount = StaticMesh.Vertices.Num();
-        File.write(reinterpret_cast<const char*>(&VertexCount), sizeof(VertexCount));
-        File.write(reinterpret_cast<const char*>(StaticMesh.Vertices.GetData()), VertexCount * sizeof(FVertexSimple));
-
-        // Indices
-        uint32 IndexCount = StaticMesh.Indices.Num();
-        File.write(reinterpret_cast<const char*>(&IndexCount), sizeof(IndexCount));
-        File.write(reinterpret_cast<const char*>(StaticMesh.Indices.GetData()), IndexCount * sizeof(UINT));
-
-        // Materials
-        uint32 MaterialCount = StaticMesh.Materials.Num();
-        File.write(reinterpret_cast<const char*>(&MaterialCount), sizeof(MaterialCount));
-        for (const FObjMaterialInfo& Material : StaticMesh.Materials)
-        {
-            Serializer::WriteFString(File, Material.MTLName);
-            File.write(reinterpret_cast<const char*>(&Material.bHasTexture), sizeof(Material.bHasTexture));
-            File.write(reinterpret_cast<const char*>(&Material.bTransparent), sizeof(Material.bTransparent));
-            File.write(reinterpret_cast<const char*>(&Material.Diffuse), sizeof(Material.Diffuse));
-            File.write(reinterpret_cast<const char*>(&Material.Specular), sizeof(Material.Specular));
-            File.write(reinterpret_cast<const char*>(&Material.Ambient), sizeof(Material.Ambient));
-            File.write(reinterpret_cast<const char*>(&Material.Emissive), sizeof(Material.Emissive));
-            File.write(reinterpret_cast<const char*>(&Material.SpecularScalar), sizeof(Material.SpecularScalar));
-            File.write(reinterpret_cast<const char*>(&Material.DensityScalar), sizeof(Material.DensityScalar));
-            File.write(reinterpret_cast<const char*>(&Material.TransparencyScalar), sizeof(Material.TransparencyScalar));
-            File.write(reinterpret_cast<const char*>(&Material.IlluminanceModel), sizeof(Material.IlluminanceModel));
-
-            Serializer::WriteFString(File, Material.DiffuseTextureName);
-            Serializer::WriteFWString(File, Material.DiffuseTexturePath);
-            Serializer::WriteFString(File, Material.AmbientTextureName);
-            Serializer::WriteFWString(File, Material.AmbientTexturePath);
-            Serializer::WriteFString(File, Material.SpecularTextureName);
-            Serializer::WriteFWString(File, Material.SpecularTexturePath);
-            Serializer::WriteFString(File, Material.BumpTextureName);
-            Serializer::WriteFWString(File, Material.BumpTexturePath);
-            Serializer::WriteFString(File, Material.AlphaTextureName);
-            Serializer::WriteFWString(File, Material.AlphaTexturePath);
-        }
-
-        // Material Subsets
-        uint32 SubsetCount = StaticMesh.MaterialSubsets.Num();
-        File.write(reinterpret_cast<const char*>(&SubsetCount), sizeof(SubsetCount));
-        for (const FMaterialSubset& Subset : StaticMesh.MaterialSubsets)
-        {
-            Serializer::WriteFString(File, Subset.MaterialName);
-            File.write(reinterpret_cast<const char*>(&Subset.IndexStart), sizeof(Subset.IndexStart));
-            File.write(reinterpret_cast<const char*>(&Subset.IndexCount), sizeof(Subset.IndexCount));
-            File.write(reinterpret_cast<const char*>(&Subset.MaterialIndex), sizeof(Subset.MaterialIndex));
-        }
-
-        // Bounding Box
-        File.write(reinterpret_cast<const char*>(&StaticMesh.BoundingBoxMin), sizeof(FVector));
-        File.write(reinterpret_cast<const char*>(&StaticMesh.BoundingBoxMax), sizeof(FVector));
-        
-        File.close();
-        return true;
-    }
-
-    static bool LoadStaticMeshFromBinary(const FWString& FilePath, OBJ::FStaticMeshRenderData& OutStaticMesh)
-    {
-        std::ifstream File(FilePath, std::ios::binary);
-        if (!File.is_open())
-        {
-            assert("CAN'T OPEN STATIC MESH BINARY FILE");
-            return false;
-        }
-
-        TArray<FWString> Textures;
-
-        // Object Name
-        Serializer::ReadFWString(File, OutStaticMesh.ObjectName);
-
-        // Path Name
-        Serializer::ReadFWString(File, OutStaticMesh.PathName);
-
-        // Display Name
-        Serializer::ReadFString(File, OutStaticMesh.DisplayName);
-
-        // Vertices
-        uint32 VertexCount = 0;
-        File.read(reinterpret_cast<char*>(&VertexCount), sizeof(VertexCount));
-        OutStaticMesh.Vertices.SetNum(VertexCount);
-        File.read(reinterpret_cast<char*>(OutStaticMesh.Vertices.GetData()), VertexCount * sizeof(FVertexSimple));
-
-        // Indices
-        uint32 IndexCount = 0;
-        File.read(reinterpret_cast<char*>(&IndexCount), sizeof(IndexCount));
-        OutStaticMesh.Indices.SetNum(IndexCount);
-        File.read(reinterpret_cast<char*>(OutStaticMesh.Indices.GetData()), IndexCount * sizeof(UINT));
-
-        // Material
-        uint32 MaterialCount = 0;
-        File.read(reinterpret_cast<char*>(&MaterialCount), sizeof(MaterialCount));
-        OutStaticMesh.Materials.SetNum(MaterialCount);
-        for (FObjMaterialInfo& Material : OutStaticMesh.Materials)
-        {
-            Serializer::ReadFString(File, Material.MTLName);
-            File.read(reinterpret_cast<char*>(&Material.bHasTexture), sizeof(Material.bHasTexture));
-            File.read(reinterpret_cast<char*>(&Material.bTransparent), sizeof(Material.bTransparent));
-            File.read(reinterpret_cast<char*>(&Material.Diffuse), sizeof(Material.Diffuse));
-            File.read(reinterpret_cast<char*>(&Material.Specular), sizeof(Material.Specular));
-            File.read(reinterpret_cast<char*>(&Material.Ambient), sizeof(Material.Ambient));
-            File.read(reinterpret_cast<char*>(&Material.Emissive), sizeof(Material.Emissive));
-            File.read(reinterpret_cast<char*>(&Material.SpecularScalar), sizeof(Material.SpecularScalar));
-            File.read(reinterpret_cast<char*>(&Material.DensityScalar), sizeof(Material.DensityScalar));
-            File.read(reinterpret_cast<char*>(&Material.TransparencyScalar), sizeof(Material.TransparencyScalar));
-            File.read(reinterpret_cast<char*>(&Material.IlluminanceModel), sizeof(Material.IlluminanceModel));
-            Serializer::ReadFString(File, Material.DiffuseTextureName);
-            Serializer::ReadFWString(File, Material.DiffuseTexturePath);
-            Serializer::ReadFString(File, Material.AmbientTextureName);
-            Serializer::ReadFWString(File, Material.AmbientTexturePath);
-            Serializer::ReadFString(File, Material.SpecularTextureName);
-            Serializer::ReadFWString(File, Material.SpecularTexturePath);
-            Serializer::ReadFString(File, Material.BumpTextureName);
-            Serializer::ReadFWString(File, Material.BumpTexturePath);
-            Serializer::ReadFString(File, Material.AlphaTextureName);
-            Serializer::ReadFWString(File, Material.AlphaTexturePath);
-
-            if (!Material.DiffuseTexturePath.empty())
-            {
-                Textures.AddUnique(Material.DiffuseTexturePath);
-            }
-            if (!Material.AmbientTexturePath.empty())
-            {
-                Textures.AddUnique(Material.AmbientTexturePath);
-            }
-            if (!Material.SpecularTexturePath.empty())
-            {
-                Textures.AddUnique(Material.SpecularTexturePath);
-            }
-            if (!Material.BumpTexturePath.empty())
-            {
-                Textures.AddUnique(Material.BumpTexturePath);
-            }
-            if (!Material.AlphaTexturePath.empty())
-            {
-                Textures.AddUnique(Material.AlphaTexturePath);
-            }
-        }
-
-        // Material Subset
-        uint32 SubsetCount = 0;
-        File.read(reinterpret_cast<char*>(&SubsetCount), sizeof(SubsetCount));
-        OutStaticMesh.MaterialSubsets.SetNum(SubsetCount);
-        for (FMaterialSubset& Subset : OutStaticMesh.MaterialSubsets)
-        {
-            Serializer::ReadFString(File, Subset.MaterialName);
-            File.read(reinterpret_cast<char*>(&Subset.IndexStart), sizeof(Subset.IndexStart));
-            File.read(reinterpret_cast<char*>(&Subset.IndexCount), sizeof(Subset.IndexCount));
-            File.read(reinterpret_cast<char*>(&Subset.MaterialIndex), sizeof(Subset.MaterialIndex));
-        }
-
-        // Bounding Box
-        File.read(reinterpret_cast<char*>(&OutStaticMesh.BoundingBoxMin), sizeof(FVector));
-        File.read(reinterpret_cast<char*>(&OutStaticMesh.BoundingBoxMax), sizeof(FVector));
-        
-        File.close();
-
-        // Texture Load
-        if (Textures.Num() > 0)
-        {
-            for (const FWString& Texture : Textures)
-            {
-                if (FEngineLoop::ResourceManager.GetTexture(Texture) == nullptr)
-                {
-                    FEngineLoop::ResourceManager.LoadTextureFromFile(FEngineLoop::GraphicDevice.Device, FEngineLoop::GraphicDevice.DeviceContext, Texture.c_str());
-                }
-            }
-        }
-        
-        return true;
-    }
+    /**
+     * 쿡 파일을 매핑해서 읽습니다. 정점과 인덱스는 복사하지 않고 매핑된 메모리를 가리킵니다.
+     * 매직/버전이나 원본 해시가 다르거나 정점 크기가 형식과 맞지 않으면 false를 돌려주므로 다시 쿡하면 됩니다.
+     * @param SourceHash 지금 원본의 해시. 쿡할 때 기록한 값과 다르면 원본이 바뀐 것
+     */
+    static bool LoadCookedStaticMesh(const FWString& CookedPath, const FContentHash& SourceHash, OBJ::FStaticMeshRenderData& OutStaticMesh);
 
     static UMaterial* CreateMaterial(FObjMaterialInfo materialInfo);
     static TMap<FString, UMaterial*>& GetMaterials() { return MaterialMap; }
     static UMaterial* GetMaterial(FString name);
     static int GetMaterialNum() { return MaterialMap.Num(); }
     static UStaticMesh* CreateStaticMesh(FString filePath);
+
+    /**
+     * filePath를 FAsyncLoader로 읽고, 다 읽으면 메인 스레드에서 OnLoaded를 호출합니다.
+     * 이미 등록된 메시면 OnLoaded를 바로 호출하고 빈 핸들을 돌려줍니다.
+     */
+    static FAsyncLoadHandle CreateStaticMeshAsync(const FString& filePath, EAsyncLoadPriority Priority, const FOnStaticMeshLoaded& OnLoaded);
+
+    /**
+     * 읽어 둔 RenderData를 등록하고 UStaticMesh를 만듭니다. RenderData의 소유권을 가져가며, 같은 경로가 이미 있으면 지우고 기존 것을 씁니다.
+     * @param bLoadTexturesAsync true면 없는 텍스처를 FAsyncLoader에 요청만 하고 기다리지 않음
+     */
+    static UStaticMesh* CreateStaticMeshFromRenderData(const FString& filePath, OBJ::FStaticMeshRenderData* RenderData, bool bLoadTexturesAsync);
+
+    /** 비동기로 읽는 메시가 준비될 때까지 대신 그리는 회색 단위 큐브 */
+    static UStaticMesh* GetPlaceholderStaticMesh();
     static const TMap<FWString, UStaticMesh*>& GetStaticMeshes() { return StaticMeshMap; }
     static UStaticMesh* GetStaticMesh(FWString name);
     static int GetStaticMeshNum() { return StaticMeshMap.Num(); }
 
 private:
+    /** RenderData를 ObjStaticMeshMap에 넣고 머티리얼과 텍스처를 만듭니다. 같은 경로가 이미 있으면 RenderData를 지우고 기존 것을 돌려줌 */
+    static OBJ::FStaticMeshRenderData* RegisterObjStaticMeshAsset(const FString& PathFileName, OBJ::FStaticMeshRenderData* RenderData, bool bLoadTexturesAsync);
+
+    /** RenderData로 만든 UStaticMesh가 있으면 돌려주고, 없으면 GPU 버퍼를 만들어 등록합니다. */
+    static UStaticMesh* FindOrCreateStaticMesh(OBJ::FStaticMeshRenderData* RenderData);
+
     inline static TMap<FString, OBJ::FStaticMeshRenderData*> ObjStaticMeshMap;
     inline static TMap<FWString, UStaticMesh*> StaticMeshMap;
     inline static TMap<FString, UMaterial*> MaterialMap;
+    inline static UStaticMesh* PlaceholderStaticMesh = nullptr;
 };
\ No newline at end of file
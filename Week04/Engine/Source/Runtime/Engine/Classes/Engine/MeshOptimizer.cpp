@@ -0,0 +1,432 @@
+#include "MeshOptimizer.h"
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+    // Forsyth, "Linear-Speed Vertex Cache Optimisation"의 기본값
+    constexpr float CacheDecayPower = 1.5f;
+    constexpr float LastTriangleScore = 0.75f;
+    constexpr float ValenceBoostScale = 2.0f;
+    constexpr float ValenceBoostPower = 0.5f;
+
+    /** 이 이하의 남은 삼각형 수는 표로 찾음 */
+    constexpr uint32 MaxValenceInTable = 64;
+
+    struct FVertexScoreTable
+    {
+        float Position[FMeshOptimizer::ScoringCacheSize];
+        float Valence[MaxValenceInTable + 1];
+
+        FVertexScoreTable()
+        {
+            for (uint32 i = 0; i < FMeshOptimizer::ScoringCacheSize; ++i)
+            {
+                // 마지막 삼각형의 세 정점은 같은 점수를 줘서 바로 다음 삼각형이 같은 정점을 재사용하는 것만 노리지 않게 함
+                const float Scaler = 1.f / (FMeshOptimizer::ScoringCacheSize - 3);
+                Position[i] = i < 3 ? LastTriangleScore : std::pow(1.f - (i - 3) * Scaler, CacheDecayPower);
+            }
+            Valence[0] = 0.f;
+            for (uint32 i = 1; i <= MaxValenceInTable; ++i)
+            {
+                Valence[i] = ValenceBoostScale * std::pow(static_cast<float>(i), -ValenceBoostPower);
+            }
+        }
+
+        float Get(int32 CachePosition, uint32 TrianglesLeft) const
+        {
+            if (TrianglesLeft == 0)
+            {
+                return -1.f;
+            }
+            const float ValenceScore = TrianglesLeft <= MaxValenceInTable
+                ? Valence[TrianglesLeft] : ValenceBoostScale * std::pow(static_cast<float>(TrianglesLeft), -ValenceBoostPower);
+            return (CachePosition >= 0 ? Position[CachePosition] : 0.f) + ValenceScore;
+        }
+    };
+
+    const FVertexScoreTable& GetScoreTable()
+    {
+        static const FVertexScoreTable Table;
+        return Table;
+    }
+
+    /** 세 정점을 FIFO 캐시에 넣고 미스 수를 돌려줌. Timestamps는 정점이 캐시에 들어간 시각 */
+    uint32 FetchTriangle(const uint32* Triangle, TArray<uint32>& Timestamps, uint32& Time, uint32 CacheSize)
+    {
+        uint32 Misses = 0;
+        for (uint32 k = 0; k < 3; ++k)
+        {
+            const uint32 Vertex = Triangle[k];
+            if (Time - Timestamps[Vertex] > CacheSize)
+            {
+                Timestamps[Vertex] = Time++;
+                ++Misses;
+            }
+        }
+        return Misses;
+    }
+
+    FVector GetPosition(const FVertexSimple& Vertex)
+    {
+        return FVector(Vertex.x, Vertex.y, Vertex.z);
+    }
+}
+
+void FMeshOptimizer::OptimizeStaticMesh(OBJ::FStaticMeshRenderData& InOutStaticMesh)
+{
+    if (InOutStaticMesh.IsCompact() || InOutStaticMesh.Vertices.IsEmpty() || InOutStaticMesh.Indices.IsEmpty())
+    {
+        return;
+    }
+
+    const uint32 NumVertices = InOutStaticMesh.Vertices.Num();
+    const uint32 NumIndices = InOutStaticMesh.Indices.Num();
+    uint32* Indices = InOutStaticMesh.Indices.GetData();
+
+    // 서브셋 경계를 넘어 삼각형을 옮기면 머티리얼이 바뀌므로 서브셋마다 따로 처리
+    const auto OptimizeRange = [&](uint32 Start, uint32 Count)
+    {
+        if (Start >= NumIndices)
+        {
+            return;
+        }
+        Count = FMath::Min(Count, NumIndices - Start) / 3 * 3;
+        OptimizeVertexCache(Indices + Start, Count, NumVertices);
+        OptimizeOverdraw(Indices + Start, Count, InOutStaticMesh.Vertices.GetData(), NumVertices);
+    };
+
+    if (InOutStaticMesh.MaterialSubsets.IsEmpty())
+    {
+        OptimizeRange(0, NumIndices);
+    }
+    for (const FMaterialSubset& Subset : InOutStaticMesh.MaterialSubsets)
+    {
+        OptimizeRange(Subset.IndexStart, Subset.IndexCount);
+    }
+
+    OptimizeVertexFetch(InOutStaticMesh);
+}
+
+void FMeshOptimizer::OptimizeVertexCache(uint32* Indices, uint32 NumIndices, uint32 NumVertices)
+{
+    const uint32 NumTriangles = NumIndices / 3;
+    if (NumTriangles < 2)
+    {
+        return;
+    }
+
+    const FVertexScoreTable& ScoreTable = GetScoreTable();
+    TArray<uint32> Input;
+    Input.SetNum(NumTriangles * 3);
+    std::copy(Indices, Indices + NumTriangles * 3, Input.begin());
+
+    // 정점마다 아직 그리지 않은 삼각형 목록 (CSR). [Offsets[v], Offsets[v] + TrianglesLeft[v])가 살아 있는 구간
+    TArray<uint32> TrianglesLeft;
+    TrianglesLeft.SetNum(NumVertices);
+    std::fill(TrianglesLeft.begin(), TrianglesLeft.end(), 0u);
+    for (const uint32 Vertex : Input)
+    {
+        ++TrianglesLeft[Vertex];
+    }
+
+    TArray<uint32> Offsets;
+    Offsets.SetNum(NumVertices + 1);
+    Offsets[0] = 0;
+    for (uint32 v = 0; v < NumVertices; ++v)
+    {
+        Offsets[v + 1] = Offsets[v] + TrianglesLeft[v];
+    }
+
+    TArray<uint32> VertexTriangles;
+    VertexTriangles.SetNum(NumTriangles * 3);
+    {
+        TArray<uint32> Fill = Offsets;
+        for (uint32 t = 0; t < NumTriangles; ++t)
+        {
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                VertexTriangles[Fill[Input[t * 3 + k]]++] = t;
+            }
+        }
+    }
+
+    TArray<int32> CachePositions;
+    CachePositions.SetNum(NumVertices);
+    std::fill(CachePositions.begin(), CachePositions.end(), -1);
+
+    TArray<float> VertexScores;
+    VertexScores.SetNum(NumVertices);
+    for (uint32 v = 0; v < NumVertices; ++v)
+    {
+        VertexScores[v] = ScoreTable.Get(-1, TrianglesLeft[v]);
+    }
+
+    TArray<float> TriangleScores;
+    TriangleScores.SetNum(NumTriangles);
+    uint32 BestTriangle = 0;
+    for (uint32 t = 0; t < NumTriangles; ++t)
+    {
+        TriangleScores[t] = VertexScores[Input[t * 3]] + VertexScores[Input[t * 3 + 1]] + VertexScores[Input[t * 3 + 2]];
+        if (TriangleScores[t] > TriangleScores[BestTriangle])
+        {
+            BestTriangle = t;
+        }
+    }
+
+    TArray<uint8> Emitted;
+    Emitted.SetNum(NumTriangles);
+    std::fill(Emitted.begin(), Emitted.end(), static_cast<uint8>(0));
+
+    // 새 삼각형의 세 정점이 앞에 들어가므로 갱신 중에는 최대 ScoringCacheSize + 3개
+    uint32 Cache[ScoringCacheSize + 3];
+    uint32 CacheCount = 0;
+    uint32 NextCandidate = 0;
+
+    for (uint32 Out = 0; Out < NumTriangles; ++Out)
+    {
+        if (BestTriangle == UINT32_MAX)
+        {
+            // 캐시 안의 정점에 남은 삼각형이 없으면 아직 그리지 않은 다음 삼각형부터 다시 시작
+            while (Emitted[NextCandidate])
+            {
+                ++NextCandidate;
+            }
+            BestTriangle = NextCandidate;
+        }
+
+        const uint32* Triangle = &Input[BestTriangle * 3];
+        Indices[Out * 3] = Triangle[0];
+        Indices[Out * 3 + 1] = Triangle[1];
+        Indices[Out * 3 + 2] = Triangle[2];
+        Emitted[BestTriangle] = 1;
+
+        for (uint32 k = 0; k < 3; ++k)
+        {
+            const uint32 Vertex = Triangle[k];
+            uint32* Begin = &VertexTriangles[Offsets[Vertex]];
+            uint32* Last = Begin + TrianglesLeft[Vertex] - 1;
+            for (uint32* It = Begin; It <= Last; ++It)
+            {
+                if (*It == BestTriangle)
+                {
+                    std::swap(*It, *Last);
+                    break;
+                }
+            }
+            --TrianglesLeft[Vertex];
+        }
+
+        // 방금 그린 정점을 맨 앞으로 옮긴 새 LRU 캐시
+        uint32 NewCache[ScoringCacheSize + 3] = { Triangle[0], Triangle[1], Triangle[2] };
+        uint32 NewCacheCount = 3;
+        for (uint32 i = 0; i < CacheCount; ++i)
+        {
+            const uint32 Vertex = Cache[i];
+            if (Vertex != Triangle[0] && Vertex != Triangle[1] && Vertex != Triangle[2])
+            {
+                NewCache[NewCacheCount++] = Vertex;
+            }
+        }
+
+        for (uint32 i = 0; i < NewCacheCount; ++i)
+        {
+            const uint32 Vertex = NewCache[i];
+            CachePositions[Vertex] = i < ScoringCacheSize ? static_cast<int32>(i) : -1;
+            VertexScores[Vertex] = ScoreTable.Get(CachePositions[Vertex], TrianglesLeft[Vertex]);
+        }
+
+        // 점수가 바뀐 정점의 남은 삼각형만 다시 계산해서 다음 삼각형을 고름
+        BestTriangle = UINT32_MAX;
+        float BestScore = -FLT_MAX;
+        for (uint32 i = 0; i < NewCacheCount; ++i)
+        {
+            const uint32 Vertex = NewCache[i];
+            const uint32* Begin = &VertexTriangles[Offsets[Vertex]];
+            for (const uint32* It = Begin; It < Begin + TrianglesLeft[Vertex]; ++It)
+            {
+                const uint32 t = *It;
+                const float Score = VertexScores[Input[t * 3]] + VertexScores[Input[t * 3 + 1]] + VertexScores[Input[t * 3 + 2]];
+                TriangleScores[t] = Score;
+                if (Score > BestScore)
+                {
+                    BestScore = Score;
+                    BestTriangle = t;
+                }
+            }
+        }
+
+        CacheCount = FMath::Min(NewCacheCount, ScoringCacheSize);
+        std::copy(NewCache, NewCache + CacheCount, Cache);
+    }
+}
+
+void FMeshOptimizer::OptimizeOverdraw(uint32* Indices, uint32 NumIndices, const FVertexSimple* Vertices, uint32 NumVertices, float Threshold)
+{
+    const uint32 NumTriangles = NumIndices / 3;
+    if (NumTriangles < 2)
+    {
+        return;
+    }
+
+    // 세 정점이 모두 캐시 미스인 삼각형에서 새 묶음을 시작. 묶음 안의 순서는 그대로라 캐시 효율이 거의 유지됨
+    TArray<uint32> ClusterStarts;
+    {
+        TArray<uint32> Timestamps;
+        Timestamps.SetNum(NumVertices);
+        std::fill(Timestamps.begin(), Timestamps.end(), 0u);
+        uint32 Time = FifoCacheSize + 1;
+        for (uint32 t = 0; t < NumTriangles; ++t)
+        {
+            if (FetchTriangle(Indices + t * 3, Timestamps, Time, FifoCacheSize) == 3)
+            {
+                ClusterStarts.Add(t);
+            }
+        }
+    }
+    if (ClusterStarts.Num() < 2)
+    {
+        return;
+    }
+    const uint32 NumClusters = ClusterStarts.Num();
+    ClusterStarts.Add(NumTriangles);
+
+    // 묶음마다 넓이 가중 중심과 평균 법선. 메시 중심에서 바깥을 향한 묶음일수록 앞을 가리므로 먼저 그림
+    TArray<FVector> Centroids;
+    TArray<FVector> Normals;
+    Centroids.SetNum(NumClusters);
+    Normals.SetNum(NumClusters);
+    FVector MeshCentroid(0.f, 0.f, 0.f);
+    float MeshArea = 0.f;
+    for (uint32 c = 0; c < NumClusters; ++c)
+    {
+        FVector Centroid(0.f, 0.f, 0.f);
+        FVector AreaNormal(0.f, 0.f, 0.f);
+        float ClusterArea = 0.f;
+        for (uint32 t = ClusterStarts[c]; t < ClusterStarts[c + 1]; ++t)
+        {
+            const FVector P0 = GetPosition(Vertices[Indices[t * 3]]);
+            const FVector P1 = GetPosition(Vertices[Indices[t * 3 + 1]]);
+            const FVector P2 = GetPosition(Vertices[Indices[t * 3 + 2]]);
+            const FVector Cross = (P1 - P0).Cross(P2 - P0);
+            const float Area = Cross.Magnitude();
+            Centroid = Centroid + (P0 + P1 + P2) * (Area / 3.f);
+            AreaNormal = AreaNormal + Cross;
+            ClusterArea += Area;
+        }
+        MeshCentroid = MeshCentroid + Centroid;
+        MeshArea += ClusterArea;
+        Centroids[c] = ClusterArea > 0.f ? Centroid * (1.f / ClusterArea) : GetPosition(Vertices[Indices[ClusterStarts[c] * 3]]);
+        Normals[c] = AreaNormal.Magnitude() > 0.f ? AreaNormal.Normalize() : AreaNormal;
+    }
+    if (MeshArea > 0.f)
+    {
+        MeshCentroid = MeshCentroid * (1.f / MeshArea);
+    }
+
+    TArray<float> SortKeys;
+    SortKeys.SetNum(NumClusters);
+    for (uint32 c = 0; c < NumClusters; ++c)
+    {
+        SortKeys[c] = (Centroids[c] - MeshCentroid).Dot(Normals[c]);
+    }
+
+    TArray<uint32> ClusterOrder;
+    ClusterOrder.SetNum(NumClusters);
+    std::iota(ClusterOrder.begin(), ClusterOrder.end(), 0u);
+    std::stable_sort(ClusterOrder.begin(), ClusterOrder.end(), [&SortKeys](uint32 A, uint32 B) { return SortKeys[A] > SortKeys[B]; });
+
+    TArray<uint32> Reordered;
+    Reordered.Reserve(NumTriangles * 3);
+    for (const uint32 c : ClusterOrder)
+    {
+        for (uint32 i = ClusterStarts[c] * 3; i < ClusterStarts[c + 1] * 3; ++i)
+        {
+            Reordered.Add(Indices[i]);
+        }
+    }
+
+    const FVertexCacheStats Before = AnalyzeVertexCache(Indices, NumTriangles * 3, NumVertices, FifoCacheSize);
+    const FVertexCacheStats After = AnalyzeVertexCache(Reordered.GetData(), NumTriangles * 3, NumVertices, FifoCacheSize);
+    if (After.ACMR <= Before.ACMR * Threshold)
+    {
+        std::copy(Reordered.begin(), Reordered.end(), Indices);
+    }
+}
+
+void FMeshOptimizer::OptimizeVertexFetch(OBJ::FStaticMeshRenderData& InOutStaticMesh)
+{
+    const uint32 NumVertices = InOutStaticMesh.Vertices.Num();
+
+    TArray<uint32> Remap;
+    Remap.SetNum(NumVertices);
+    std::fill(Remap.begin(), Remap.end(), UINT32_MAX);
+
+    uint32 NumUsed = 0;
+    for (uint32& Index : InOutStaticMesh.Indices)
+    {
+        if (Remap[Index] == UINT32_MAX)
+        {
+            Remap[Index] = NumUsed++;
+        }
+        Index = Remap[Index];
+    }
+
+    const bool bHasNormals = InOutStaticMesh.Normals.Num() == static_cast<int32>(NumVertices);
+    TArray<FVertexSimple> Vertices;
+    TArray<FVector> Normals;
+    Vertices.SetNum(NumUsed);
+    if (bHasNormals)
+    {
+        Normals.SetNum(NumUsed);
+    }
+    for (uint32 v = 0; v < NumVertices; ++v)
+    {
+        if (Remap[v] != UINT32_MAX)
+        {
+            Vertices[Remap[v]] = InOutStaticMesh.Vertices[v];
+            if (bHasNormals)
+            {
+                Normals[Remap[v]] = InOutStaticMesh.Normals[v];
+            }
+        }
+    }
+
+    InOutStaticMesh.Vertices = std::move(Vertices);
+    InOutStaticMesh.Normals = std::move(Normals);
+}
+
+FVertexCacheStats FMeshOptimizer::AnalyzeVertexCache(const uint32* Indices, uint32 NumIndices, uint32 NumVertices, uint32 CacheSize)
+{
+    FVertexCacheStats Stats;
+    const uint32 NumTriangles = NumIndices / 3;
+    if (NumTriangles == 0)
+    {
+        return Stats;
+    }
+
+    TArray<uint32> Timestamps;
+    Timestamps.SetNum(NumVertices);
+    std::fill(Timestamps.begin(), Timestamps.end(), 0u);
+    uint32 Time = CacheSize + 1;
+
+    uint32 Misses = 0;
+    for (uint32 t = 0; t < NumTriangles; ++t)
+    {
+        Misses += FetchTriangle(Indices + t * 3, Timestamps, Time, CacheSize);
+    }
+
+    TArray<uint8> Used;
+    Used.SetNum(NumVertices);
+    std::fill(Used.begin(), Used.end(), static_cast<uint8>(0));
+    uint32 NumUsed = 0;
+    for (uint32 i = 0; i < NumTriangles * 3; ++i)
+    {
+        NumUsed += Used[Indices[i]] == 0;
+        Used[Indices[i]] = 1;
+    }
+
+    Stats.ACMR = static_cast<float>(Misses) / NumTriangles;
+    Stats.ATVR = NumUsed > 0 ? static_cast<float>(Misses) / NumUsed : 0.f;
+    return Stats;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "Define.h"
+
+/** 정점 캐시 시뮬레이션 결과 */
+struct FVertexCacheStats
+{
+    /** 삼각형당 캐시 미스 수 (Average Cache Miss Ratio). 0.5 근처가 좋고 최악은 3 */
+    float ACMR = 0.f;
+
+    /** 참조된 정점당 캐시 미스 수 (Average Transformed Vertex Ratio). 1이 최적 */
+    float ATVR = 0.f;
+};
+
+/**
+ * 쿡할 때 스태틱 메시의 인덱스와 정점 순서를 GPU에 맞게 바꿉니다.
+ * 1. 정점 캐시 최적화: Forsyth의 선형 시간 알고리즘으로 서브셋마다 삼각형 순서를 바꿈
+ * 2. 오버드로 최적화: 캐시가 끊기는 지점에서 삼각형을 묶고, 바깥을 향한 묶음부터 그리도록 정렬 (Sander et al.)
+ * 3. 정점 fetch 최적화: 인덱스에서 처음 쓰이는 순서로 정점을 다시 번호 매김
+ * 서브셋의 IndexStart/IndexCount는 바뀌지 않습니다.
+ */
+class FMeshOptimizer
+{
+public:
+    /** Full 형식 정점의 메시에 세 단계를 모두 적용합니다. Compact면 아무것도 하지 않음 */
+    static void OptimizeStaticMesh(OBJ::FStaticMeshRenderData& InOutStaticMesh);
+
+    /** Indices의 삼각형 순서를 캐시 적중이 많도록 제자리에서 바꿉니다. */
+    static void OptimizeVertexCache(uint32* Indices, uint32 NumIndices, uint32 NumVertices);
+
+    /**
+     * 정점 캐시 최적화가 끝난 Indices를 묶음 단위로 다시 정렬해서 오버드로를 줄입니다.
+     * 결과의 ACMR이 원래의 Threshold배를 넘으면 원래 순서를 유지합니다.
+     */
+    static void OptimizeOverdraw(uint32* Indices, uint32 NumIndices, const FVertexSimple* Vertices, uint32 NumVertices, float Threshold = DefaultOverdrawThreshold);
+
+    /** 처음 쓰이는 순서로 정점을 다시 배치하고 인덱스를 고칩니다. 쓰이지 않는 정점은 버림 */
+    static void OptimizeVertexFetch(OBJ::FStaticMeshRenderData& InOutStaticMesh);
+
+    /** CacheSize 크기의 FIFO 캐시로 Indices를 그렸을 때의 미스 수를 셉니다. */
+    static FVertexCacheStats AnalyzeVertexCache(const uint32* Indices, uint32 NumIndices, uint32 NumVertices, uint32 CacheSize);
+
+    /** Forsyth 점수 계산에 쓰는 LRU 캐시 크기 */
+    static constexpr uint32 ScoringCacheSize = 32;
+
+    /** 오버드로 묶음을 나눌 때와 ACMR 지표에 쓰는 FIFO 캐시 크기 */
+    static constexpr uint32 FifoCacheSize = 16;
+
+    static constexpr float DefaultOverdrawThreshold = 1.05f;
+};
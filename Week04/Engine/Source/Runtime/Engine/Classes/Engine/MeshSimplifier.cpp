@@ -0,0 +1,477 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include "Quadric.h"
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <queue>
+
+namespace
+{
+    enum class EVertexKind : uint8
+    {
+        Interior,
+        Border, // 열린 경계 위. 경계 에지를 따라 경계나 잠긴 정점으로만 합침
+        Locked, // UV 이음매, 머티리얼 경계, 비다양체. 움직이지 않음
+    };
+
+    struct FCollapse
+    {
+        float Cost;
+        uint32 From;
+        uint32 To;
+        uint32 FromVersion;
+        uint32 ToVersion;
+
+        bool operator>(const FCollapse& Other) const { return Cost > Other.Cost; }
+    };
+
+    uint64 MakeEdgeKey(uint32 A, uint32 B)
+    {
+        return A < B ? (static_cast<uint64>(A) << 32) | B : (static_cast<uint64>(B) << 32) | A;
+    }
+
+    FVector GetPosition(const FVertexSimple& Vertex)
+    {
+        return FVector(Vertex.x, Vertex.y, Vertex.z);
+    }
+
+    /**
+     * 한 메시의 축약 상태. 인접 관계는 위치가 같은 정점을 하나로 묶은 기하 정점 기준이고,
+     * 삼각형은 렌더 정점 인덱스를 그대로 들고 있어서 살아남은 삼각형을 바로 인덱스 버퍼로 쓸 수 있습니다.
+     */
+    class FSimplifier
+    {
+    public:
+        explicit FSimplifier(const OBJ::FStaticMeshRenderData& StaticMesh);
+
+        /** 살아 있는 삼각형이 TargetTriangles 이하가 되거나 더 합칠 에지가 없을 때까지 축약합니다. */
+        void Simplify(uint32 TargetTriangles);
+
+        /** 살아 있는 삼각형을 서브셋별로 OutIndices 뒤에 붙이고, OutSubsets에 서브셋마다의 구간을 씁니다. */
+        void AppendTriangles(TArray<UINT>& OutIndices, TArray<FMaterialSubset>& OutSubsets) const;
+
+        uint32 GetNumTriangles() const { return NumLiveTriangles; }
+        float GetMaxError() const { return MaxError; }
+
+    private:
+        bool HasCorner(uint32 Triangle, uint32 Vertex) const;
+        void GatherNeighbors(uint32 Vertex, TArray<uint32>& OutNeighbors) const;
+        void PushCollapse(uint32 From, uint32 To);
+        bool TryCollapse(uint32 From, uint32 To);
+
+        const TArray<FMaterialSubset>& Subsets;
+
+        // 삼각형 (렌더 정점 인덱스)
+        TArray<uint32> Triangles;
+        TArray<uint32> TriangleSubsets;
+        TArray<uint8> TriangleAlive;
+        uint32 NumLiveTriangles = 0;
+
+        // 렌더 정점 -> 기하 정점
+        TArray<uint32> GeometricVertices;
+
+        // 기하 정점
+        TArray<FVector> Positions;
+        TArray<FQuadric> Quadrics;
+        TArray<EVertexKind> Kinds;
+        TArray<uint32> Versions;
+        TArray<uint8> Removed;
+        TArray<TArray<uint32>> VertexTriangles;
+
+        std::priority_queue<FCollapse, std::vector<FCollapse>, std::greater<FCollapse>> Queue;
+        float MaxError = 0.f;
+    };
+
+    FSimplifier::FSimplifier(const OBJ::FStaticMeshRenderData& StaticMesh)
+        : Subsets(StaticMesh.MaterialSubsets)
+    {
+        const TArray<FVertexSimple>& Vertices = StaticMesh.Vertices;
+        const uint32 NumVertices = Vertices.Num();
+        const uint32 NumIndices = StaticMesh.Indices.Num();
+
+        // 위치가 비트 단위로 같은 정점을 하나의 기하 정점으로 묶음
+        TArray<uint32> SortedVertices;
+        SortedVertices.SetNum(NumVertices);
+        std::iota(SortedVertices.begin(), SortedVertices.end(), 0u);
+        const auto PositionBits = [&Vertices](uint32 Index)
+        {
+            uint32 Bits[3];
+            std::memcpy(Bits, &Vertices[Index].x, sizeof(Bits));
+            return std::make_tuple(Bits[0], Bits[1], Bits[2]);
+        };
+        std::sort(SortedVertices.begin(), SortedVertices.end(), [&PositionBits](uint32 A, uint32 B) { return PositionBits(A) < PositionBits(B); });
+
+        GeometricVertices.SetNum(NumVertices);
+        for (uint32 i = 0; i < NumVertices; ++i)
+        {
+            if (i == 0 || PositionBits(SortedVertices[i]) != PositionBits(SortedVertices[i - 1]))
+            {
+                Positions.Add(GetPosition(Vertices[SortedVertices[i]]));
+            }
+            GeometricVertices[SortedVertices[i]] = Positions.Num() - 1;
+        }
+        const uint32 NumGeometric = Positions.Num();
+
+        // 서브셋에 속한 삼각형만 단순화. 위치가 겹치는 삼각형은 넓이가 0이므로 버림
+        for (uint32 SubsetIndex = 0; SubsetIndex < static_cast<uint32>(Subsets.Num()); ++SubsetIndex)
+        {
+            const FMaterialSubset& Subset = Subsets[SubsetIndex];
+            const uint32 End = FMath::Min(Subset.IndexStart + Subset.IndexCount, NumIndices);
+            for (uint32 i = Subset.IndexStart; i + 2 < End; i += 3)
+            {
+                const uint32 G0 = GeometricVertices[StaticMesh.Indices[i]];
+                const uint32 G1 = GeometricVertices[StaticMesh.Indices[i + 1]];
+                const uint32 G2 = GeometricVertices[StaticMesh.Indices[i + 2]];
+                if (G0 == G1 || G1 == G2 || G2 == G0)
+                {
+                    continue;
+                }
+                Triangles.Add(StaticMesh.Indices[i]);
+                Triangles.Add(StaticMesh.Indices[i + 1]);
+                Triangles.Add(StaticMesh.Indices[i + 2]);
+                TriangleSubsets.Add(SubsetIndex);
+            }
+        }
+        const uint32 NumTriangles = TriangleSubsets.Num();
+        TriangleAlive.SetNum(NumTriangles);
+        std::fill(TriangleAlive.begin(), TriangleAlive.end(), static_cast<uint8>(1));
+        NumLiveTriangles = NumTriangles;
+
+        Kinds.SetNum(NumGeometric);
+        std::fill(Kinds.begin(), Kinds.end(), EVertexKind::Interior);
+        Versions.SetNum(NumGeometric);
+        std::fill(Versions.begin(), Versions.end(), 0u);
+        Removed.SetNum(NumGeometric);
+        std::fill(Removed.begin(), Removed.end(), static_cast<uint8>(0));
+        VertexTriangles.SetNum(NumGeometric);
+
+        // 렌더 정점이 둘 이상 쓰이는 위치(UV 이음매)와 여러 서브셋이 만나는 위치는 잠금
+        TArray<uint32> FirstRenderVertex;
+        TArray<uint32> FirstSubset;
+        FirstRenderVertex.SetNum(NumGeometric);
+        FirstSubset.SetNum(NumGeometric);
+        std::fill(FirstRenderVertex.begin(), FirstRenderVertex.end(), UINT32_MAX);
+        for (uint32 t = 0; t < NumTriangles; ++t)
+        {
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                const uint32 Render = Triangles[t * 3 + k];
+                const uint32 Vertex = GeometricVertices[Render];
+                VertexTriangles[Vertex].Add(t);
+                if (FirstRenderVertex[Vertex] == UINT32_MAX)
+                {
+                    FirstRenderVertex[Vertex] = Render;
+                    FirstSubset[Vertex] = TriangleSubsets[t];
+                }
+                else if (FirstRenderVertex[Vertex] != Render || FirstSubset[Vertex] != TriangleSubsets[t])
+                {
+                    Kinds[Vertex] = EVertexKind::Locked;
+                }
+            }
+        }
+
+        // 에지마다 삼각형 수. 1이면 열린 경계, 3 이상이면 비다양체
+        TArray<uint64> EdgeKeys;
+        EdgeKeys.SetNum(NumTriangles * 3);
+        for (uint32 t = 0; t < NumTriangles; ++t)
+        {
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                EdgeKeys[t * 3 + k] = MakeEdgeKey(GeometricVertices[Triangles[t * 3 + k]], GeometricVertices[Triangles[t * 3 + (k + 1) % 3]]);
+            }
+        }
+        TArray<uint64> SortedEdgeKeys = EdgeKeys;
+        std::sort(SortedEdgeKeys.begin(), SortedEdgeKeys.end());
+        const auto CountEdge = [&SortedEdgeKeys](uint64 Key)
+        {
+            const auto Range = std::equal_range(SortedEdgeKeys.begin(), SortedEdgeKeys.end(), Key);
+            return static_cast<uint32>(Range.second - Range.first);
+        };
+
+        // 면 평면 쿼드릭. 경계 에지에는 에지를 지나고 면에 수직인 평면을 가중치를 줘서 더함
+        Quadrics.SetNum(NumGeometric);
+        const float BoundaryScale = std::sqrt(FMeshSimplifier::BoundaryWeight);
+        for (uint32 t = 0; t < NumTriangles; ++t)
+        {
+            const uint32 G[3] = { GeometricVertices[Triangles[t * 3]], GeometricVertices[Triangles[t * 3 + 1]], GeometricVertices[Triangles[t * 3 + 2]] };
+            const FVector Cross = (Positions[G[1]] - Positions[G[0]]).Cross(Positions[G[2]] - Positions[G[0]]);
+            if (Cross.Magnitude() <= 0.f)
+            {
+                continue;
+            }
+            const FVector Normal = Cross.Normalize();
+            const FQuadric FaceQuadric(Normal.x, Normal.y, Normal.z, -Normal.Dot(Positions[G[0]]));
+
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                Quadrics[G[k]] += FaceQuadric;
+
+                const uint32 Count = CountEdge(EdgeKeys[t * 3 + k]);
+                const uint32 A = G[k];
+                const uint32 B = G[(k + 1) % 3];
+                if (Count > 2)
+                {
+                    Kinds[A] = EVertexKind::Locked;
+                    Kinds[B] = EVertexKind::Locked;
+                }
+                else if (Count == 1)
+                {
+                    for (const uint32 Vertex : { A, B })
+                    {
+                        if (Kinds[Vertex] == EVertexKind::Interior)
+                        {
+                            Kinds[Vertex] = EVertexKind::Border;
+                        }
+                    }
+
+                    const FVector EdgeNormal = (Positions[B] - Positions[A]).Cross(Normal);
+                    if (EdgeNormal.Magnitude() > 0.f)
+                    {
+                        const FVector Plane = EdgeNormal.Normalize() * BoundaryScale;
+                        const FQuadric EdgeQuadric(Plane.x, Plane.y, Plane.z, -Plane.Dot(Positions[A]));
+                        Quadrics[A] += EdgeQuadric;
+                        Quadrics[B] += EdgeQuadric;
+                    }
+                }
+            }
+        }
+
+        // 안쪽 에지는 양쪽 삼각형이 서로 반대 방향을 하나씩 넣고, 경계 에지는 한 삼각형이 양방향을 다 넣음
+        for (uint32 t = 0; t < NumTriangles; ++t)
+        {
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                const uint32 A = GeometricVertices[Triangles[t * 3 + k]];
+                const uint32 B = GeometricVertices[Triangles[t * 3 + (k + 1) % 3]];
+                PushCollapse(A, B);
+                if (CountEdge(EdgeKeys[t * 3 + k]) == 1)
+                {
+                    PushCollapse(B, A);
+                }
+            }
+        }
+    }
+
+    bool FSimplifier::HasCorner(uint32 Triangle, uint32 Vertex) const
+    {
+        return GeometricVertices[Triangles[Triangle * 3]] == Vertex || GeometricVertices[Triangles[Triangle * 3 + 1]] == Vertex ||
+            GeometricVertices[Triangles[Triangle * 3 + 2]] == Vertex;
+    }
+
+    void FSimplifier::GatherNeighbors(uint32 Vertex, TArray<uint32>& OutNeighbors) const
+    {
+        OutNeighbors.Empty();
+        for (const uint32 Triangle : VertexTriangles[Vertex])
+        {
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                const uint32 Neighbor = GeometricVertices[Triangles[Triangle * 3 + k]];
+                if (Neighbor != Vertex && !OutNeighbors.Contains(Neighbor))
+                {
+                    OutNeighbors.Add(Neighbor);
+                }
+            }
+        }
+    }
+
+    void FSimplifier::PushCollapse(uint32 From, uint32 To)
+    {
+        if (Kinds[From] == EVertexKind::Locked || (Kinds[From] == EVertexKind::Border && Kinds[To] == EVertexKind::Interior))
+        {
+            return;
+        }
+        const float Cost = (Quadrics[From] + Quadrics[To]).Evaluate(Positions[To]);
+        Queue.push({ FMath::Max(Cost, 0.f), From, To, Versions[From], Versions[To] });
+    }
+
+    bool FSimplifier::TryCollapse(uint32 From, uint32 To)
+    {
+        // 에지를 공유하는 삼각형. Border는 경계 에지(삼각형 1개)를 따라서만 합침
+        uint32 NumShared = 0;
+        uint32 ToRender = UINT32_MAX;
+        for (const uint32 Triangle : VertexTriangles[From])
+        {
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                if (GeometricVertices[Triangles[Triangle * 3 + k]] == To)
+                {
+                    ToRender = Triangles[Triangle * 3 + k];
+                    ++NumShared;
+                }
+            }
+        }
+        if (NumShared == 0 || NumShared > 2 || (Kinds[From] == EVertexKind::Border && NumShared != 1))
+        {
+            return false;
+        }
+
+        // 링크 조건: 두 정점의 공통 이웃이 에지를 낀 삼각형의 맞은편 정점뿐이어야 축약 뒤에도 다양체가 유지됨
+        TArray<uint32> FromNeighbors;
+        TArray<uint32> ToNeighbors;
+        GatherNeighbors(From, FromNeighbors);
+        GatherNeighbors(To, ToNeighbors);
+        uint32 NumCommon = 0;
+        for (const uint32 Neighbor : FromNeighbors)
+        {
+            NumCommon += Neighbor != To && ToNeighbors.Contains(Neighbor);
+        }
+        if (NumCommon != NumShared)
+        {
+            return false;
+        }
+
+        // From을 To로 옮겼을 때 뒤집히거나 찌그러지는 삼각형이 있으면 거부
+        for (const uint32 Triangle : VertexTriangles[From])
+        {
+            if (HasCorner(Triangle, To))
+            {
+                continue;
+            }
+            FVector Before[3];
+            FVector After[3];
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                const uint32 Vertex = GeometricVertices[Triangles[Triangle * 3 + k]];
+                Before[k] = Positions[Vertex];
+                After[k] = Vertex == From ? Positions[To] : Positions[Vertex];
+            }
+            const FVector NormalBefore = (Before[1] - Before[0]).Cross(Before[2] - Before[0]);
+            const FVector NormalAfter = (After[1] - After[0]).Cross(After[2] - After[0]);
+            if (NormalBefore.Dot(NormalAfter) <= FMeshSimplifier::MinNormalCosine * NormalBefore.Magnitude() * NormalAfter.Magnitude())
+            {
+                return false;
+            }
+        }
+
+        // 공유 삼각형은 지우고, 나머지는 From 꼭짓점을 To의 렌더 정점으로 바꿔서 To에 붙임
+        const TArray<uint32> FromTriangles = VertexTriangles[From];
+        for (const uint32 Triangle : FromTriangles)
+        {
+            if (HasCorner(Triangle, To))
+            {
+                TriangleAlive[Triangle] = 0;
+                --NumLiveTriangles;
+                for (uint32 k = 0; k < 3; ++k)
+                {
+                    const uint32 Vertex = GeometricVertices[Triangles[Triangle * 3 + k]];
+                    if (Vertex != From)
+                    {
+                        VertexTriangles[Vertex].RemoveSingle(Triangle);
+                    }
+                }
+                continue;
+            }
+
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                if (GeometricVertices[Triangles[Triangle * 3 + k]] == From)
+                {
+                    Triangles[Triangle * 3 + k] = ToRender;
+                }
+            }
+            VertexTriangles[To].Add(Triangle);
+        }
+        VertexTriangles[From].Empty();
+        Removed[From] = 1;
+
+        Quadrics[To] += Quadrics[From];
+        ++Versions[To];
+
+        GatherNeighbors(To, ToNeighbors);
+        for (const uint32 Neighbor : ToNeighbors)
+        {
+            PushCollapse(To, Neighbor);
+            PushCollapse(Neighbor, To);
+        }
+        return true;
+    }
+
+    void FSimplifier::Simplify(uint32 TargetTriangles)
+    {
+        while (NumLiveTriangles > TargetTriangles && !Queue.empty())
+        {
+            const FCollapse Collapse = Queue.top();
+            Queue.pop();
+
+            // 넣은 뒤에 끝점이 합쳐졌거나 쿼드릭이 바뀐 후보는 버림
+            if (Removed[Collapse.From] || Removed[Collapse.To] ||
+                Versions[Collapse.From] != Collapse.FromVersion || Versions[Collapse.To] != Collapse.ToVersion)
+            {
+                continue;
+            }
+
+            if (TryCollapse(Collapse.From, Collapse.To))
+            {
+                MaxError = FMath::Max(MaxError, std::sqrt(Collapse.Cost));
+            }
+        }
+    }
+
+    void FSimplifier::AppendTriangles(TArray<UINT>& OutIndices, TArray<FMaterialSubset>& OutSubsets) const
+    {
+        // 원래 삼각형 순서를 유지해서 LOD0의 캐시 최적화 순서를 최대한 이어받음
+        TArray<TArray<uint32>> SubsetTriangles;
+        SubsetTriangles.SetNum(Subsets.Num());
+        for (uint32 t = 0; t < static_cast<uint32>(TriangleSubsets.Num()); ++t)
+        {
+            if (TriangleAlive[t])
+            {
+                SubsetTriangles[TriangleSubsets[t]].Add(t);
+            }
+        }
+
+        OutSubsets = Subsets;
+        for (int32 SubsetIndex = 0; SubsetIndex < Subsets.Num(); ++SubsetIndex)
+        {
+            FMaterialSubset& Subset = OutSubsets[SubsetIndex];
+            Subset.IndexStart = OutIndices.Num();
+            for (const uint32 Triangle : SubsetTriangles[SubsetIndex])
+            {
+                OutIndices.Add(Triangles[Triangle * 3]);
+                OutIndices.Add(Triangles[Triangle * 3 + 1]);
+                OutIndices.Add(Triangles[Triangle * 3 + 2]);
+            }
+            Subset.IndexCount = OutIndices.Num() - Subset.IndexStart;
+        }
+    }
+}
+
+void FMeshSimplifier::GenerateLODs(OBJ::FStaticMeshRenderData& InOutStaticMesh, uint32 NumLODs)
+{
+    InOutStaticMesh.LODs.Empty();
+    if (InOutStaticMesh.IsCompact() || InOutStaticMesh.MaterialSubsets.IsEmpty() || InOutStaticMesh.Vertices.IsEmpty())
+    {
+        return;
+    }
+
+    FSimplifier Simplifier(InOutStaticMesh);
+    uint32 PreviousTriangles = Simplifier.GetNumTriangles();
+    if (PreviousTriangles < MinTrianglesForLOD)
+    {
+        return;
+    }
+
+    for (uint32 LODIndex = 1; LODIndex < FMath::Min(NumLODs, MaxNumLODs); ++LODIndex)
+    {
+        Simplifier.Simplify(static_cast<uint32>(PreviousTriangles * LODTriangleRatio));
+        if (Simplifier.GetNumTriangles() > PreviousTriangles * MinLODReduction)
+        {
+            break;
+        }
+
+        FStaticMeshLOD LOD;
+        LOD.FirstIndex = InOutStaticMesh.Indices.Num();
+        LOD.MaxError = Simplifier.GetMaxError();
+        Simplifier.AppendTriangles(InOutStaticMesh.Indices, LOD.MaterialSubsets);
+        LOD.NumIndices = InOutStaticMesh.Indices.Num() - LOD.FirstIndex;
+
+        for (const FMaterialSubset& Subset : LOD.MaterialSubsets)
+        {
+            FMeshOptimizer::OptimizeVertexCache(InOutStaticMesh.Indices.GetData() + Subset.IndexStart, Subset.IndexCount, InOutStaticMesh.Vertices.Num());
+        }
+
+        InOutStaticMesh.LODs.Add(std::move(LOD));
+        PreviousTriangles = Simplifier.GetNumTriangles();
+    }
+}
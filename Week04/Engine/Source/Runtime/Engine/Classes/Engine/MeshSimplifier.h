@@ -0,0 +1,34 @@
+#pragma once
+#include "Define.h"
+
+/**
+ * Garland-Heckbert 쿼드릭 오차(QEM)로 에지를 하나씩 축약해서 스태틱 메시의 LOD를 만듭니다.
+ * 에지의 한쪽 끝점을 다른 끝점으로 합치므로(half-edge collapse) 새 정점이 생기지 않고, 모든 LOD가 LOD0의 정점 버퍼를 같이 씁니다.
+ * UV 이음매, 머티리얼 경계, 비다양체 정점은 움직이지 않고, 열린 경계의 정점은 경계를 따라서만 합칩니다.
+ */
+class FMeshSimplifier
+{
+public:
+    /**
+     * LOD0(MaterialSubsets)에서 삼각형 수를 LODTriangleRatio씩 줄인 LOD를 만들어 Indices 뒤에 붙이고 LODs를 채웁니다.
+     * LOD 서브셋마다 정점 캐시 최적화를 하며, 서브셋이 없거나 삼각형이 MinTrianglesForLOD보다 적으면 만들지 않습니다.
+     * @param NumLODs LOD0을 포함한 LOD 수
+     */
+    static void GenerateLODs(OBJ::FStaticMeshRenderData& InOutStaticMesh, uint32 NumLODs = MaxNumLODs);
+
+    static constexpr uint32 MaxNumLODs = 4;
+
+    /** 이전 LOD에 대한 목표 삼각형 수 비율 */
+    static constexpr float LODTriangleRatio = 0.5f;
+
+    static constexpr uint32 MinTrianglesForLOD = 256;
+
+    /** 잠긴 정점이 많아서 이전 LOD의 이 비율 아래로 줄이지 못하면 LOD를 더 만들지 않음 */
+    static constexpr float MinLODReduction = 0.8f;
+
+    /** 열린 경계가 안쪽으로 말려 들어가지 않도록 경계 에지에 더하는 수직 평면 쿼드릭의 가중치 */
+    static constexpr float BoundaryWeight = 10.f;
+
+    /** 뒤집힘 검사. 축약 전후 삼각형 법선의 코사인이 이보다 작으면 축약하지 않음 */
+    static constexpr float MinNormalCosine = 0.25f;
+};
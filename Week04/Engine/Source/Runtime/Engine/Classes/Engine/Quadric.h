@@ -3,6 +3,8 @@
 #include <cmath>
 #include <DirectXMath.h>
 
+#include "Math/Vector.h"
+
 using namespace DirectX;
 
 class FQuadric {
@@ -8,6 +8,8 @@
 #include "D3D11RHI/GraphicDevice.h"
 #include "DirectXTK/Include/DDSTextureLoader.h"
 #include "Engine/FLoaderOBJ.h"
+#include "Engine/DerivedDataCache.h"
+#include "Math/MathUtility.h"
 
 void FResourceMgr::Initialize(FRenderer* renderer, FGraphicsDevice* device)
 {
@@ -48,64 +50,198 @@ std::shared_ptr<FTexture> FResourceMgr::GetTexture(const FWString& name) const
 }
 
 HRESULT FResourceMgr::LoadTextureFromFile(ID3D11Device* device, ID3D11DeviceContext* context, const wchar_t* filename)
+{
+	FDecodedImage Image;
+	HRESULT hr = LoadImageFromFile(filename, Image);
+	if (FAILED(hr)) return hr;
+
+	return CreateTextureFromImage(device, filename, Image);
+}
+
+HRESULT FResourceMgr::DecodeImageFromFile(const wchar_t* filename, FDecodedImage& OutImage)
 {
 	IWICImagingFactory* wicFactory = nullptr;
 	IWICBitmapDecoder* decoder = nullptr;
 	IWICBitmapFrameDecode* frame = nullptr;
 	IWICFormatConverter* converter = nullptr;
 
-	// WIC 팩토리 생성
+	// 스레드마다 한 번 초기화해야 하므로 로딩 스레드에서도 그대로 호출
 	HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
 	if (FAILED(hr)) return hr;
 
+	// WIC 팩토리 생성
 	hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&wicFactory));
-	if (FAILED(hr)) return hr;
-
 
 	// 이미지 파일 디코딩
-	hr = wicFactory->CreateDecoderFromFilename(filename, nullptr, GENERIC_READ, WICDecodeMetadataCacheOnLoad, &decoder);
-	if (FAILED(hr)) return hr;
+	if (SUCCEEDED(hr))
+		hr = wicFactory->CreateDecoderFromFilename(filename, nullptr, GENERIC_READ, WICDecodeMetadataCacheOnLoad, &decoder);
 
-
-	hr = decoder->GetFrame(0, &frame);
-	if (FAILED(hr)) return hr;
+	if (SUCCEEDED(hr))
+		hr = decoder->GetFrame(0, &frame);
 
 	// WIC 포맷 변환기 생성 (픽셀 포맷 변환)
-	hr = wicFactory->CreateFormatConverter(&converter);
-	if (FAILED(hr)) return hr;
+	if (SUCCEEDED(hr))
+		hr = wicFactory->CreateFormatConverter(&converter);
 
-	hr = converter->Initialize(frame, GUID_WICPixelFormat32bppRGBA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom);
-	if (FAILED(hr)) return hr;
+	if (SUCCEEDED(hr))
+		hr = converter->Initialize(frame, GUID_WICPixelFormat32bppRGBA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeCustom);
 
-	// 이미지 크기 가져오기
-	UINT width, height;
-	frame->GetSize(&width, &height);
-	
 	// 픽셀 데이터 로드
-	BYTE* imageData = new BYTE[width * height * 4];
-	hr = converter->CopyPixels(nullptr, width * 4, width * height * 4, imageData);
-	if (FAILED(hr)) {
-		delete[] imageData;
-		return hr;
+	if (SUCCEEDED(hr))
+	{
+		UINT width, height;
+		frame->GetSize(&width, &height);
+
+		OutImage.Width = width;
+		OutImage.Height = height;
+		OutImage.Pixels.SetNum(width * height * 4);
+		hr = converter->CopyPixels(nullptr, width * 4, width * height * 4, OutImage.Pixels.GetData());
+	}
+
+	// 리소스 해제
+	if (converter) converter->Release();
+	if (frame) frame->Release();
+	if (decoder) decoder->Release();
+	if (wicFactory) wicFactory->Release();
+
+	return hr;
+}
+
+HRESULT FResourceMgr::LoadImageFromFile(const wchar_t* filename, FDecodedImage& OutImage)
+{
+	// DDC 항목은 FTextureCacheHeader 뒤에 모든 밉의 픽셀
+	struct FTextureCacheHeader
+	{
+		uint32 Width;
+		uint32 Height;
+		uint32 NumMips;
+		uint32 Padding;
+	};
+
+	FContentHash SourceHash;
+	const bool bHasSourceHash = FDerivedDataCache::HashSourceFile(filename, SourceHash);
+	const FContentHash Key = FDerivedDataCache::MakeKey(EDerivedDataType::Texture, TextureCookVersion, SourceHash);
+
+	TArray<uint8> CachedData;
+	if (bHasSourceHash && FDerivedDataCache::Get(EDerivedDataType::Texture, Key, CachedData) && static_cast<uint64>(CachedData.Num()) >= sizeof(FTextureCacheHeader))
+	{
+		FTextureCacheHeader Header;
+		std::memcpy(&Header, CachedData.GetData(), sizeof(Header));
+		const uint64 NumPixelBytes = CachedData.Num() - sizeof(Header);
+		uint64 ExpectedBytes = 0;
+		for (uint32 Mip = 0; Mip < FMath::Min(Header.NumMips, 32u); ++Mip)
+		{
+			ExpectedBytes += static_cast<uint64>(FMath::Max(Header.Width >> Mip, 1u)) * FMath::Max(Header.Height >> Mip, 1u) * 4;
+		}
+
+		if (Header.NumMips > 0 && Header.NumMips <= 32 && ExpectedBytes == NumPixelBytes)
+		{
+			OutImage.Width = Header.Width;
+			OutImage.Height = Header.Height;
+			OutImage.NumMips = Header.NumMips;
+			OutImage.Pixels.SetNum(static_cast<int32>(NumPixelBytes));
+			std::memcpy(OutImage.Pixels.GetData(), CachedData.GetData() + sizeof(Header), NumPixelBytes);
+			return S_OK;
+		}
 	}
 
+	HRESULT hr = DecodeImageFromFile(filename, OutImage);
+	if (FAILED(hr)) return hr;
+
+	GenerateMips(OutImage);
+
+	if (bHasSourceHash)
+	{
+		const FTextureCacheHeader Header = { OutImage.Width, OutImage.Height, OutImage.NumMips, 0 };
+		CachedData.SetNum(static_cast<int32>(sizeof(Header) + OutImage.Pixels.Num()));
+		std::memcpy(CachedData.GetData(), &Header, sizeof(Header));
+		std::memcpy(CachedData.GetData() + sizeof(Header), OutImage.Pixels.GetData(), OutImage.Pixels.Num());
+		FDerivedDataCache::Put(EDerivedDataType::Texture, Key, CachedData.GetData(), CachedData.Num());
+	}
+	return hr;
+}
+
+void FResourceMgr::GenerateMips(FDecodedImage& InOutImage)
+{
+	if (InOutImage.NumMips != 1 || InOutImage.Width == 0 || InOutImage.Height == 0)
+	{
+		return;
+	}
+
+	uint32 NumMips = 1;
+	uint64 TotalBytes = static_cast<uint64>(InOutImage.Width) * InOutImage.Height * 4;
+	for (uint32 Width = InOutImage.Width, Height = InOutImage.Height; Width > 1 || Height > 1; ++NumMips)
+	{
+		Width = FMath::Max(Width / 2, 1u);
+		Height = FMath::Max(Height / 2, 1u);
+		TotalBytes += static_cast<uint64>(Width) * Height * 4;
+	}
+
+	InOutImage.Pixels.SetNum(static_cast<int32>(TotalBytes));
+	uint8* Source = InOutImage.Pixels.GetData();
+	uint32 SourceWidth = InOutImage.Width;
+	uint32 SourceHeight = InOutImage.Height;
+	for (uint32 Mip = 1; Mip < NumMips; ++Mip)
+	{
+		const uint32 Width = FMath::Max(SourceWidth / 2, 1u);
+		const uint32 Height = FMath::Max(SourceHeight / 2, 1u);
+		uint8* Dest = Source + static_cast<uint64>(SourceWidth) * SourceHeight * 4;
+
+		// 홀수 크기면 마지막 줄/열을 한 번 더 읽음 (가장자리 클램프)
+		for (uint32 y = 0; y < Height; ++y)
+		{
+			const uint32 y0 = FMath::Min(y * 2, SourceHeight - 1);
+			const uint32 y1 = FMath::Min(y * 2 + 1, SourceHeight - 1);
+			for (uint32 x = 0; x < Width; ++x)
+			{
+				const uint32 x0 = FMath::Min(x * 2, SourceWidth - 1);
+				const uint32 x1 = FMath::Min(x * 2 + 1, SourceWidth - 1);
+				const uint8* P00 = Source + (static_cast<uint64>(y0) * SourceWidth + x0) * 4;
+				const uint8* P01 = Source + (static_cast<uint64>(y0) * SourceWidth + x1) * 4;
+				const uint8* P10 = Source + (static_cast<uint64>(y1) * SourceWidth + x0) * 4;
+				const uint8* P11 = Source + (static_cast<uint64>(y1) * SourceWidth + x1) * 4;
+				uint8* Out = Dest + (static_cast<uint64>(y) * Width + x) * 4;
+				for (uint32 c = 0; c < 4; ++c)
+				{
+					Out[c] = static_cast<uint8>((P00[c] + P01[c] + P10[c] + P11[c] + 2) / 4);
+				}
+			}
+		}
+
+		Source = Dest;
+		SourceWidth = Width;
+		SourceHeight = Height;
+	}
+	InOutImage.NumMips = NumMips;
+}
+
+HRESULT FResourceMgr::CreateTextureFromImage(ID3D11Device* device, const wchar_t* filename, const FDecodedImage& Image)
+{
 	// DirectX 11 텍스처 생성
 	D3D11_TEXTURE2D_DESC textureDesc = {};
-	textureDesc.Width = width;
-	textureDesc.Height = height;
-	textureDesc.MipLevels = 1;
+	textureDesc.Width = Image.Width;
+	textureDesc.Height = Image.Height;
+	textureDesc.MipLevels = Image.NumMips;
 	textureDesc.ArraySize = 1;
 	textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
 	textureDesc.SampleDesc.Count = 1;
 	textureDesc.Usage = D3D11_USAGE_IMMUTABLE;
 	textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
 
-	D3D11_SUBRESOURCE_DATA initData = {};
-	initData.pSysMem = imageData;
-	initData.SysMemPitch = width * 4;
+	TArray<D3D11_SUBRESOURCE_DATA> initData;
+	initData.SetNum(Image.NumMips);
+	const uint8* MipPixels = Image.Pixels.GetData();
+	for (uint32 Mip = 0; Mip < Image.NumMips; ++Mip)
+	{
+		const uint32 MipWidth = FMath::Max(Image.Width >> Mip, 1u);
+		const uint32 MipHeight = FMath::Max(Image.Height >> Mip, 1u);
+		initData[Mip] = {};
+		initData[Mip].pSysMem = MipPixels;
+		initData[Mip].SysMemPitch = MipWidth * 4;
+		MipPixels += static_cast<uint64>(MipWidth) * MipHeight * 4;
+	}
 	ID3D11Texture2D* Texture2D;
-	hr = device->CreateTexture2D(&textureDesc, &initData, &Texture2D);
-	delete[] imageData;
+	HRESULT hr = device->CreateTexture2D(&textureDesc, initData.GetData(), &Texture2D);
 	if (FAILED(hr)) return hr;
 
 	// Shader Resource View 생성
@@ -113,16 +249,10 @@ HRESULT FResourceMgr::LoadTextureFromFile(ID3D11Device* device, ID3D11DeviceCont
 	srvDesc.Format = textureDesc.Format;
 	srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
 	srvDesc.Texture2D.MostDetailedMip = 0;
-	srvDesc.Texture2D.MipLevels = 1;
+	srvDesc.Texture2D.MipLevels = Image.NumMips;
 	ID3D11ShaderResourceView* TextureSRV;
 	hr = device->CreateShaderResourceView(Texture2D, &srvDesc, &TextureSRV);
 
-	// 리소스 해제
-	wicFactory->Release();
-	decoder->Release();
-	frame->Release();
-	converter->Release();
-
 	//샘플러 스테이트 생성
 	ID3D11SamplerState* SamplerState;
 	D3D11_SAMPLER_DESC samplerDesc = {};
@@ -137,7 +267,7 @@ HRESULT FResourceMgr::LoadTextureFromFile(ID3D11Device* device, ID3D11DeviceCont
 	device->CreateSamplerState(&samplerDesc, &SamplerState);
 	FWString name = FWString(filename);
 
-	textureMap[name] = std::make_shared<FTexture>(TextureSRV, Texture2D, SamplerState, width, height);
+	textureMap[name] = std::make_shared<FTexture>(TextureSRV, Texture2D, SamplerState, Image.Width, Image.Height);
 
 	Console::GetInstance().AddLog(LogLevel::Warning, "Texture File Load Successs");
 	return hr;
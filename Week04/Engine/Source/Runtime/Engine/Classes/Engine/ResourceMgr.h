@@ -2,6 +2,18 @@
 #include <memory>
 #include "Texture.h"
 #include "Container/Map.h"
+#include "Container/Array.h"
+
+/** 파일에서 디코딩한 RGBA8 픽셀. GPU 텍스처는 따로 만듭니다. */
+struct FDecodedImage
+{
+    uint32 Width = 0;
+    uint32 Height = 0;
+
+    /** Pixels에 들어 있는 밉 수. 밉은 큰 것부터 이어 붙어 있음 */
+    uint32 NumMips = 1;
+    TArray<uint8> Pixels;
+};
 
 class FRenderer;
 class FGraphicsDevice;
@@ -12,6 +24,24 @@ public:
     void Initialize(FRenderer* renderer, FGraphicsDevice* device);
     void Release(FRenderer* renderer);
     HRESULT LoadTextureFromFile(ID3D11Device* device, ID3D11DeviceContext* context, const wchar_t* filename);
+
+    /** WIC로 이미지를 RGBA8로 디코딩합니다. 텍스처 맵을 건드리지 않으므로 에셋 로딩 스레드에서 호출해도 됩니다. */
+    static HRESULT DecodeImageFromFile(const wchar_t* filename, FDecodedImage& OutImage);
+
+    /**
+     * 원본 내용의 해시로 DDC에서 밉맵까지 만든 이미지를 찾고, 없으면 디코딩해서 밉맵을 만든 뒤 DDC에 넣습니다.
+     * DecodeImageFromFile과 같이 에셋 로딩 스레드에서 호출해도 됩니다.
+     */
+    static HRESULT LoadImageFromFile(const wchar_t* filename, FDecodedImage& OutImage);
+
+    /** 밉 0만 있는 이미지에 2x2 평균으로 1x1까지의 밉을 붙입니다. */
+    static void GenerateMips(FDecodedImage& InOutImage);
+
+    /** 밉 생성이나 DDC 항목 형식이 바뀌면 올림 */
+    static constexpr uint32 TextureCookVersion = 1;
+
+    /** 디코딩한 이미지로 텍스처를 만들어 filename으로 등록합니다. 메인 스레드에서만 호출합니다. */
+    HRESULT CreateTextureFromImage(ID3D11Device* device, const wchar_t* filename, const FDecodedImage& Image);
     HRESULT LoadTextureFromDDS(ID3D11Device* device, ID3D11DeviceContext* context, const wchar_t* filename);
 
     std::shared_ptr<FTexture> GetTexture(const FWString& name) const;
@@ -1,171 +1,430 @@
 #include "FBVHNode.h"
 
-FBVHNode::FBVHNode(FVector Min, FVector Max)
-    : BoundBox(Min, Max)
-    , Vertices(TArray<FVertexSimple>())
-    , Children(TArray<FBVHNode*>(8))
-    , bIsLeaf(true)
-    {}
-
-// 정점 기반 BVH 생성도 개선
-void FBVHNode::CreateVertexBVH(const TArray<FVertexSimple>& vertices, int depth, int maxDepth)
+#include <cmath>
+#include <cstring>
+
+#include "Math/MathUtility.h"
+
+namespace
 {
-    // 적은 수의 정점에서는 더 분할할 필요가 없음
-    if (depth > maxDepth || vertices.Num() <= 5)
+    float GetSurfaceArea(const FBoundingBox& Box)
+    {
+        const FVector Size = Box.max - Box.min;
+        return 2.f * (Size.x * Size.y + Size.y * Size.z + Size.z * Size.x);
+    }
+
+    float GetAxis(const FVector& Vector, int32 Axis)
+    {
+        return Axis == 0 ? Vector.x : (Axis == 1 ? Vector.y : Vector.z);
+    }
+
+    /** 아무것도 담지 않은 상태의 박스. Union으로 처음 합치는 박스가 그대로 남음 */
+    FBoundingBox MakeEmptyBox()
+    {
+        return FBoundingBox(FVector(FLT_MAX, FLT_MAX, FLT_MAX), FVector(-FLT_MAX, -FLT_MAX, -FLT_MAX));
+    }
+}
+
+void FTriangleBVH::Build(const FVertexSimple* Vertices, uint32 NumVertices, const uint32* Indices, uint32 NumIndices)
+{
+    Empty();
+
+    const bool bIndexed = NumIndices > 0;
+    const uint32 NumTriangles = bIndexed ? NumIndices / 3 : NumVertices / 3;
+    if (NumTriangles == 0)
     {
-        // 리프 노드에 정점 저장
-        Vertices = vertices;
-        bIsLeaf = true;
         return;
     }
 
-    // 공간 분할
-    SubDivide();
-    
-    // 각 자식 노드에 대한 정점 분류
-    TArray<TArray<FVertexSimple>> childVertices;
-    childVertices.SetNum(8);
-    
-    for (const auto& vertex : vertices)
+    const auto GetPosition = [&](uint32 Index)
+    {
+        const FVertexSimple& Vertex = Vertices[Index];
+        return FVector(Vertex.x, Vertex.y, Vertex.z);
+    };
+
+    Triangles.SetNum(NumTriangles);
+    Centroids.SetNum(NumTriangles);
+    TriangleBounds.SetNum(NumTriangles);
+    for (uint32 i = 0; i < NumTriangles; ++i)
+    {
+        const uint32 I0 = bIndexed ? Indices[i * 3] : i * 3;
+        const uint32 I1 = bIndexed ? Indices[i * 3 + 1] : i * 3 + 1;
+        const uint32 I2 = bIndexed ? Indices[i * 3 + 2] : i * 3 + 2;
+
+        // UStaticMeshComponent::CheckRayIntersection과 같은 정점 순서로 저장해서 같은 거리가 나오게 함
+        FTriangle& Triangle = Triangles[i];
+        Triangle.V0 = GetPosition(I0);
+        Triangle.V1 = GetPosition(I2);
+        Triangle.V2 = GetPosition(I1);
+
+        const FVector Min(
+            FMath::Min(Triangle.V0.x, FMath::Min(Triangle.V1.x, Triangle.V2.x)),
+            FMath::Min(Triangle.V0.y, FMath::Min(Triangle.V1.y, Triangle.V2.y)),
+            FMath::Min(Triangle.V0.z, FMath::Min(Triangle.V1.z, Triangle.V2.z))
+        );
+        const FVector Max(
+            FMath::Max(Triangle.V0.x, FMath::Max(Triangle.V1.x, Triangle.V2.x)),
+            FMath::Max(Triangle.V0.y, FMath::Max(Triangle.V1.y, Triangle.V2.y)),
+            FMath::Max(Triangle.V0.z, FMath::Max(Triangle.V1.z, Triangle.V2.z))
+        );
+        TriangleBounds[i] = FBoundingBox(Min, Max);
+        Centroids[i] = (Triangle.V0 + Triangle.V1 + Triangle.V2) * (1.f / 3.f);
+    }
+
+    // 이진 트리이므로 노드는 최대 2N - 1개. 미리 잡아두면 분할 중에 재할당되지 않음
+    Nodes.Reserve(NumTriangles * 2 - 1);
+    FBVHNode Root = {};
+    Root.LeftOrFirst = 0;
+    Root.TriangleCount = NumTriangles;
+    Nodes.Add(Root);
+    UpdateNodeBounds(0);
+    Subdivide(0, 0);
+
+    // 빌드에만 필요하므로 메모리까지 해제
+    Centroids = TArray<FVector>();
+    TriangleBounds = TArray<FBoundingBox>();
+}
+
+void FTriangleBVH::Empty()
+{
+    Nodes.Empty();
+    Triangles.Empty();
+    Centroids.Empty();
+    TriangleBounds.Empty();
+}
+
+void FTriangleBVH::UpdateNodeBounds(uint32 NodeIndex)
+{
+    FBVHNode& Node = Nodes[NodeIndex];
+    FBoundingBox Bounds = MakeEmptyBox();
+    const uint32 End = Node.LeftOrFirst + Node.TriangleCount;
+    for (uint32 i = Node.LeftOrFirst; i < End; ++i)
     {
-        FVector point(vertex.x, vertex.y, vertex.z);
-        
-        // 정점이 어떤 자식 노드에 속하는지 확인
-        for (int i = 0; i < 8; i++)
+        Bounds = Bounds.Union(TriangleBounds[i]);
+    }
+    Node.Min = Bounds.min;
+    Node.Max = Bounds.max;
+}
+
+void FTriangleBVH::Subdivide(uint32 NodeIndex, uint32 Depth)
+{
+    const uint32 First = Nodes[NodeIndex].LeftOrFirst;
+    const uint32 Count = Nodes[NodeIndex].TriangleCount;
+    if (Count <= 1 || Depth >= MaxDepth)
+    {
+        return;
+    }
+
+    FBoundingBox CentroidBounds = MakeEmptyBox();
+    for (uint32 i = First; i < First + Count; ++i)
+    {
+        CentroidBounds = CentroidBounds.Union(FBoundingBox(Centroids[i], Centroids[i]));
+    }
+
+    struct FBin
+    {
+        FBoundingBox Bounds = MakeEmptyBox();
+        uint32 Count = 0;
+    };
+
+    // 축마다 중심을 NumSAHBins 구간으로 나누고, 구간 경계 중 SAH 비용이 가장 낮은 곳을 고름
+    float BestCost = FLT_MAX;
+    int32 BestAxis = -1;
+    uint32 BestSplit = 0;
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        const float AxisMin = GetAxis(CentroidBounds.min, Axis);
+        const float AxisExtent = GetAxis(CentroidBounds.max, Axis) - AxisMin;
+        if (AxisExtent <= 0.f)
+        {
+            continue;
+        }
+
+        FBin Bins[NumSAHBins];
+        const float Scale = NumSAHBins / AxisExtent;
+        for (uint32 i = First; i < First + Count; ++i)
+        {
+            const uint32 Bin = FMath::Min(NumSAHBins - 1, static_cast<uint32>((GetAxis(Centroids[i], Axis) - AxisMin) * Scale));
+            Bins[Bin].Bounds = Bins[Bin].Bounds.Union(TriangleBounds[i]);
+            ++Bins[Bin].Count;
+        }
+
+        // 왼쪽/오른쪽에서 누적한 면적과 개수
+        float LeftArea[NumSAHBins - 1];
+        uint32 LeftCount[NumSAHBins - 1];
+        FBoundingBox LeftBox = MakeEmptyBox();
+        uint32 LeftSum = 0;
+        for (uint32 b = 0; b < NumSAHBins - 1; ++b)
         {
-            if (Children[i]->BoundBox.ContainsPoint(point))
+            LeftSum += Bins[b].Count;
+            LeftBox = LeftBox.Union(Bins[b].Bounds);
+            LeftCount[b] = LeftSum;
+            LeftArea[b] = LeftSum > 0 ? GetSurfaceArea(LeftBox) : 0.f;
+        }
+
+        FBoundingBox RightBox = MakeEmptyBox();
+        uint32 RightSum = 0;
+        for (uint32 b = NumSAHBins - 1; b > 0; --b)
+        {
+            RightSum += Bins[b].Count;
+            RightBox = RightBox.Union(Bins[b].Bounds);
+            const float RightArea = RightSum > 0 ? GetSurfaceArea(RightBox) : 0.f;
+            const float Cost = LeftArea[b - 1] * LeftCount[b - 1] + RightArea * RightSum;
+            if (LeftCount[b - 1] > 0 && RightSum > 0 && Cost < BestCost)
             {
-                childVertices[i].Add(vertex);
-                break; // 한 정점은 하나의 자식 노드에만 속함
+                BestCost = Cost;
+                BestAxis = Axis;
+                BestSplit = b;
             }
         }
     }
-    
-    // 각 자식 노드에 대해 재귀적으로 BVH 생성
-    for (int i = 0; i < 8; i++)
+
+    if (BestAxis < 0)
+    {
+        // 중심이 모두 같은 점이라 나눌 수 없음
+        return;
+    }
+
+    // 노드를 한 번 지나는 비용을 삼각형 하나 검사 비용과 같다고 보고, 나누는 쪽이 싸지 않으면 리프로 둠
+    const FBVHNode& Node = Nodes[NodeIndex];
+    const float ParentArea = GetSurfaceArea(FBoundingBox(Node.Min, Node.Max));
+    const float SplitCost = 1.f + (ParentArea > 0.f ? BestCost / ParentArea : 0.f);
+    if (Count <= MaxTrianglesPerLeaf && SplitCost >= static_cast<float>(Count))
+    {
+        return;
+    }
+
+    // 고른 구간 경계를 기준으로 삼각형을 제자리에서 나눔
+    const float AxisMin = GetAxis(CentroidBounds.min, BestAxis);
+    const float Scale = NumSAHBins / (GetAxis(CentroidBounds.max, BestAxis) - AxisMin);
+    uint32 i = First;
+    uint32 j = First + Count;
+    while (i < j)
     {
-        if (childVertices[i].Num() == 0)
+        const uint32 Bin = FMath::Min(NumSAHBins - 1, static_cast<uint32>((GetAxis(Centroids[i], BestAxis) - AxisMin) * Scale));
+        if (Bin < BestSplit)
         {
-            Children[i] = nullptr;
-            continue;
+            ++i;
+        }
+        else
+        {
+            --j;
+            std::swap(Triangles[i], Triangles[j]);
+            std::swap(Centroids[i], Centroids[j]);
+            std::swap(TriangleBounds[i], TriangleBounds[j]);
         }
-        
-        Children[i]->CreateVertexBVH(childVertices[i], depth + 1, maxDepth);
     }
+
+    const uint32 LeftCount = i - First;
+    if (LeftCount == 0 || LeftCount == Count)
+    {
+        return;
+    }
+
+    const uint32 LeftIndex = Nodes.Num();
+    FBVHNode Left = {};
+    Left.LeftOrFirst = First;
+    Left.TriangleCount = LeftCount;
+    FBVHNode Right = {};
+    Right.LeftOrFirst = i;
+    Right.TriangleCount = Count - LeftCount;
+    Nodes.Add(Left);
+    Nodes.Add(Right);
+
+    Nodes[NodeIndex].LeftOrFirst = LeftIndex;
+    Nodes[NodeIndex].TriangleCount = 0;
+
+    UpdateNodeBounds(LeftIndex);
+    UpdateNodeBounds(LeftIndex + 1);
+    Subdivide(LeftIndex, Depth + 1);
+    Subdivide(LeftIndex + 1, Depth + 1);
 }
 
-bool FBVHNode::RayIntersectsBVH(const FVector& RayOrigin, const FVector& RayDirection, float& OutHitDistance) const
+float FTriangleBVH::IntersectBox(const FBVHNode& Node, const FVector& RayOrigin, const FVector& InvDirection, float MaxDistance)
 {
-    // 현재 노드의 바운딩 박스와 레이의 교차 여부 검사
-    float tMin = FLT_MAX;
-    if (!BoundBox.Intersect(RayOrigin, RayDirection, tMin))
+    const float Tx0 = (Node.Min.x - RayOrigin.x) * InvDirection.x;
+    const float Tx1 = (Node.Max.x - RayOrigin.x) * InvDirection.x;
+    float TMin = FMath::Min(Tx0, Tx1);
+    float TMax = FMath::Max(Tx0, Tx1);
+
+    const float Ty0 = (Node.Min.y - RayOrigin.y) * InvDirection.y;
+    const float Ty1 = (Node.Max.y - RayOrigin.y) * InvDirection.y;
+    TMin = FMath::Max(TMin, FMath::Min(Ty0, Ty1));
+    TMax = FMath::Min(TMax, FMath::Max(Ty0, Ty1));
+
+    const float Tz0 = (Node.Min.z - RayOrigin.z) * InvDirection.z;
+    const float Tz1 = (Node.Max.z - RayOrigin.z) * InvDirection.z;
+    TMin = FMath::Max(TMin, FMath::Min(Tz0, Tz1));
+    TMax = FMath::Min(TMax, FMath::Max(Tz0, Tz1));
+
+    if (TMax >= TMin && TMax > 0.f && TMin < MaxDistance)
     {
-        return false; // 바운딩 박스와 교차하지 않으면 제외
+        return TMin;
     }
-    
-    // 리프 노드인 경우 정점 기반 검사 수행
-    if (Children.Num() == 0 || bIsLeaf)
+    return FLT_MAX;
+}
+
+bool FTriangleBVH::RayIntersects(const FVector& RayOrigin, const FVector& RayDirection, float& OutHitDistance) const
+{
+    if (Nodes.IsEmpty())
+    {
+        return false;
+    }
+
+    // 0으로 나누지 않도록 축에 평행한 성분은 아주 큰 값으로 둠
+    const FVector InvDirection(
+        RayDirection.x != 0.f ? 1.f / RayDirection.x : (std::signbit(RayDirection.x) ? -FLT_MAX : FLT_MAX),
+        RayDirection.y != 0.f ? 1.f / RayDirection.y : (std::signbit(RayDirection.y) ? -FLT_MAX : FLT_MAX),
+        RayDirection.z != 0.f ? 1.f / RayDirection.z : (std::signbit(RayDirection.z) ? -FLT_MAX : FLT_MAX)
+    );
+
+    float ClosestDistance = FLT_MAX;
+    if (IntersectBox(Nodes[0], RayOrigin, InvDirection, ClosestDistance) == FLT_MAX)
     {
-        bool hitFound = false;
-        float closestDistance = FLT_MAX;
-        
-        // 정점과의 거리 계산
-        for (const auto& Vertex : Vertices)
+        return false;
+    }
+
+    struct FStackEntry
+    {
+        uint32 NodeIndex;
+        float Distance; // 노드 박스까지의 거리. 그 사이에 더 가까운 삼각형을 찾았으면 건너뜀
+    };
+
+    // 꺼낸 노드마다 자식을 최대 2개 쌓으므로 스택은 MaxDepth + 1을 넘지 않음
+    FStackEntry Stack[MaxDepth + 1];
+    uint32 StackSize = 0;
+    Stack[StackSize++] = { 0, 0.f };
+
+    constexpr float Epsilon = 1e-6f;
+    while (StackSize > 0)
+    {
+        const FStackEntry Entry = Stack[--StackSize];
+        if (Entry.Distance >= ClosestDistance)
+        {
+            continue;
+        }
+
+        const FBVHNode& Node = Nodes[Entry.NodeIndex];
+        if (Node.IsLeaf())
         {
-            FVector point(Vertex.x, Vertex.y, Vertex.z);
-            float distance = point.DistanceFromPointToRay(RayOrigin, RayDirection);
-            
-            const float VertexThreshold = 0.1f;
-            if (distance < VertexThreshold)
+            // Möller–Trumbore. UPrimitiveComponent::IntersectRayTriangle과 같은 계산을 FVector 연산 없이 풀어 씀
+            const uint32 End = Node.LeftOrFirst + Node.TriangleCount;
+            for (uint32 t = Node.LeftOrFirst; t < End; ++t)
             {
-                // 레이 방향으로의 거리 계산
-                FVector toVertex = point - RayOrigin;
-                float rayDistance = toVertex.Dot(RayDirection);
-                
-                if (rayDistance > 0.0f && rayDistance < closestDistance)
+                const FTriangle& Triangle = Triangles[t];
+                const FVector Edge1 = Triangle.V1 - Triangle.V0;
+                const FVector Edge2 = Triangle.V2 - Triangle.V0;
+
+                const FVector H(
+                    RayDirection.y * Edge2.z - RayDirection.z * Edge2.y,
+                    RayDirection.z * Edge2.x - RayDirection.x * Edge2.z,
+                    RayDirection.x * Edge2.y - RayDirection.y * Edge2.x
+                );
+                const float A = Edge1.x * H.x + Edge1.y * H.y + Edge1.z * H.z;
+                if (std::fabs(A) < Epsilon)
+                {
+                    continue; // Ray와 삼각형이 평행한 경우
+                }
+
+                const float F = 1.f / A;
+                const FVector S = RayOrigin - Triangle.V0;
+                const float U = F * (S.x * H.x + S.y * H.y + S.z * H.z);
+                if (U < 0.f || U > 1.f)
+                {
+                    continue;
+                }
+
+                const FVector Q(
+                    S.y * Edge1.z - S.z * Edge1.y,
+                    S.z * Edge1.x - S.x * Edge1.z,
+                    S.x * Edge1.y - S.y * Edge1.x
+                );
+                const float V = F * (RayDirection.x * Q.x + RayDirection.y * Q.y + RayDirection.z * Q.z);
+                if (V < 0.f || U + V > 1.f)
+                {
+                    continue;
+                }
+
+                const float Distance = F * (Edge2.x * Q.x + Edge2.y * Q.y + Edge2.z * Q.z);
+                if (Distance > Epsilon && Distance < ClosestDistance)
                 {
-                    closestDistance = rayDistance;
-                    hitFound = true;
+                    ClosestDistance = Distance;
                 }
             }
+            continue;
         }
-        
-        if (hitFound)
+
+        // 가까운 자식을 나중에 쌓아서 먼저 꺼내지게 함
+        uint32 Near = Node.LeftOrFirst;
+        uint32 Far = Node.LeftOrFirst + 1;
+        float NearDistance = IntersectBox(Nodes[Near], RayOrigin, InvDirection, ClosestDistance);
+        float FarDistance = IntersectBox(Nodes[Far], RayOrigin, InvDirection, ClosestDistance);
+        if (FarDistance < NearDistance)
         {
-            OutHitDistance = closestDistance;
-            return true;
+            std::swap(Near, Far);
+            std::swap(NearDistance, FarDistance);
         }
-        
-        return false;
-    }
-    
-    // 자식 노드 순회 (원래 코드와 동일하게 유지)
-    bool hit = false;
-    float closestDistance = FLT_MAX;
-    
-    // 거리에 따라 자식 노드 정렬
-    struct ChildDistance { int ChildIndex; float Distance; };
-    TArray<ChildDistance> SortedChildren;
-    
-    for (int i = 0; i < Children.Num(); ++i)
-    {
-        if (Children[i] != nullptr)
+        if (FarDistance != FLT_MAX)
         {
-            float distance;
-            if (Children[i]->BoundBox.Intersect(RayOrigin, RayDirection, distance))
-            {
-                SortedChildren.Add({i, distance});
-            }
+            Stack[StackSize++] = { Far, FarDistance };
         }
-    }
-    
-    // 가까운 노드부터 순회
-    SortedChildren.Sort([](const ChildDistance& A, const ChildDistance& B) {
-        return A.Distance < B.Distance;
-    });
-    
-    for (const auto& SortedChild : SortedChildren)
-    {
-        float childHitDistance = FLT_MAX;
-        if (Children[SortedChild.ChildIndex]->RayIntersectsBVH(RayOrigin, RayDirection, childHitDistance))
+        if (NearDistance != FLT_MAX)
         {
-            if (childHitDistance < closestDistance)
-            {
-                closestDistance = childHitDistance;
-                hit = true;
-            }
+            Stack[StackSize++] = { Near, NearDistance };
         }
     }
-    
-    if (hit)
+
+    if (ClosestDistance == FLT_MAX)
     {
-        OutHitDistance = closestDistance;
-        return true;
+        return false;
     }
-    
-    return false;
+    OutHitDistance = ClosestDistance;
+    return true;
 }
 
-void FBVHNode::SubDivide()
+uint64 FTriangleBVH::GetAllocatedSize() const
 {
-    if (!bIsLeaf) return; // leaf node일 때만 쪼개기
-    
-    const FVector Center = BoundBox.GetCenter();
-    const FVector Extent = BoundBox.GetExtent();
-    const FVector Half = Extent * 0.5f;
-
-    for (int32 i = 0; i < 8; ++i)
-    {
-        FVector Offset(
-            (i & 1) ? Half.x : -Half.x,
-            (i & 2) ? Half.y : -Half.y,
-            (i & 4) ? Half.z : -Half.z
-        );
-        FVector ChildCenter = Center + Offset;
-        FVector Min = ChildCenter - Half;
-        FVector Max = ChildCenter + Half;
+    return static_cast<uint64>(Nodes.Len()) * sizeof(FBVHNode)
+        + static_cast<uint64>(Triangles.Len()) * sizeof(FTriangle)
+        + static_cast<uint64>(Centroids.Len()) * sizeof(FVector)
+        + static_cast<uint64>(TriangleBounds.Len()) * sizeof(FBoundingBox);
+}
+
+void FTriangleBVH::Serialize(TArray<uint8>& Out) const
+{
+    const uint32 Counts[2] = { static_cast<uint32>(Nodes.Num()), static_cast<uint32>(Triangles.Num()) };
+    const uint64 NodeBytes = static_cast<uint64>(Counts[0]) * sizeof(FBVHNode);
+    const uint64 TriangleBytes = static_cast<uint64>(Counts[1]) * sizeof(FTriangle);
+
+    const uint64 Offset = Out.Num();
+    Out.SetNum(static_cast<int32>(Offset + sizeof(Counts) + NodeBytes + TriangleBytes));
+    uint8* Dest = Out.GetData() + Offset;
+    std::memcpy(Dest, Counts, sizeof(Counts));
+    std::memcpy(Dest + sizeof(Counts), Nodes.GetData(), NodeBytes);
+    std::memcpy(Dest + sizeof(Counts) + NodeBytes, Triangles.GetData(), TriangleBytes);
+}
+
+bool FTriangleBVH::Deserialize(const uint8* Data, uint64 Size)
+{
+    Empty();
 
-        Children[i] = new FBVHNode(Min, Max);
+    uint32 Counts[2];
+    if (Size < sizeof(Counts))
+    {
+        return false;
+    }
+    std::memcpy(Counts, Data, sizeof(Counts));
+
+    const uint64 NodeBytes = static_cast<uint64>(Counts[0]) * sizeof(FBVHNode);
+    const uint64 TriangleBytes = static_cast<uint64>(Counts[1]) * sizeof(FTriangle);
+    if (Size != sizeof(Counts) + NodeBytes + TriangleBytes)
+    {
+        return false;
     }
-    bIsLeaf = false;
-}
\ No newline at end of file
+
+    Nodes.SetNum(Counts[0]);
+    Triangles.SetNum(Counts[1]);
+    std::memcpy(Nodes.GetData(), Data + sizeof(Counts), NodeBytes);
+    std::memcpy(Triangles.GetData(), Data + sizeof(Counts) + NodeBytes, TriangleBytes);
+    return true;
+}
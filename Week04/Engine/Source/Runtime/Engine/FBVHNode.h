@@ -1,17 +1,83 @@
 #pragma once
 #include "Define.h"
 
-class FBVHNode
+/**
+ * 평탄화된 BVH 노드 (32바이트).
+ * 내부 노드의 두 자식은 배열에서 연속해 있으므로 왼쪽 자식 인덱스만 저장합니다.
+ */
+struct FBVHNode
+{
+    FVector Min;
+    uint32 LeftOrFirst;   // 내부 노드면 왼쪽 자식 인덱스 (오른쪽은 +1), 리프면 첫 삼각형 인덱스
+    FVector Max;
+    uint32 TriangleCount; // 0이면 내부 노드
+
+    bool IsLeaf() const { return TriangleCount > 0; }
+};
+
+/**
+ * 스태틱 메시의 삼각형 BVH. 메시 로컬 공간에서 레이 피킹에 사용합니다.
+ * SAH(Surface Area Heuristic)로 분할하고, 삼각형 정점은 리프 순서로 복사해서 순회 중에 인덱스를 따라가지 않습니다.
+ */
+class FTriangleBVH
 {
 public:
-    FBVHNode(FVector Min, FVector Max);
-    
-    void CreateVertexBVH(const TArray<FVertexSimple>& vertices, int depth, int maxDepth);
-    bool RayIntersectsBVH(const FVector& RayOrigin, const FVector& RayDirection, float& OutHitDistance) const;
+    /** Indices의 삼각형 3개씩으로 트리를 새로 만듭니다. NumIndices가 0이면 Vertices를 3개씩 묶습니다. */
+    void Build(const FVertexSimple* Vertices, uint32 NumVertices, const uint32* Indices, uint32 NumIndices);
+
+    void Empty();
+
+    /**
+     * 레이와 가장 가까운 삼각형의 거리를 찾습니다. 판정은 UPrimitiveComponent::IntersectRayTriangle과 같습니다.
+     * @param RayDirection 정규화되어 있으면 OutHitDistance가 실제 거리
+     */
+    bool RayIntersects(const FVector& RayOrigin, const FVector& RayDirection, float& OutHitDistance) const;
+
+    uint32 GetNumNodes() const { return Nodes.Num(); }
+    uint32 GetNumTriangles() const { return Triangles.Num(); }
+
+    /** 노드와 삼각형 배열이 차지하는 바이트 수 */
+    uint64 GetAllocatedSize() const;
+
+    /** 노드 수, 삼각형 수, 노드 배열, 삼각형 배열 순서로 Out 뒤에 붙입니다. DDC에 넣어 다음 로드에서 Build를 건너뜀 */
+    void Serialize(TArray<uint8>& Out) const;
+
+    /** Serialize한 데이터로 트리를 채웁니다. 크기가 맞지 않으면 비우고 false */
+    bool Deserialize(const uint8* Data, uint64 Size);
+
+    /** 이보다 많은 삼각형을 가진 노드는 SAH 비용과 상관없이 나눔 */
+    static constexpr uint32 MaxTrianglesPerLeaf = 4;
+
+    /** 순회 스택 크기를 고정하기 위한 최대 깊이. 이 깊이에서는 삼각형 수와 상관없이 리프가 됨 */
+    static constexpr uint32 MaxDepth = 48;
+
+    /** SAH 분할 후보를 고를 때 축마다 나누는 구간 수 */
+    static constexpr uint32 NumSAHBins = 12;
+
+    /** 빌드 방식이나 직렬화 형식이 바뀌면 올려서 DDC의 이전 BVH를 무시함 */
+    static constexpr uint32 CookVersion = 1;
+
 private:
-    TArray<FBVHNode*> Children;
-    TArray<FVertexSimple> Vertices;
-    const FBoundingBox BoundBox; //현재 노드의 공간 범위
-    bool bIsLeaf;
-    void SubDivide();
+    struct FTriangle
+    {
+        FVector V0;
+        FVector V1;
+        FVector V2;
+    };
+
+    /** Nodes[NodeIndex]가 맡은 삼각형 구간을 SAH로 나눕니다. 빌드 중에만 사용하는 Centroids/TriangleBounds를 씁니다. */
+    void Subdivide(uint32 NodeIndex, uint32 Depth);
+
+    void UpdateNodeBounds(uint32 NodeIndex);
+
+    /** 레이가 박스와 만나는 가장 가까운 t. 만나지 않거나 MaxDistance보다 멀면 FLT_MAX */
+    static float IntersectBox(const FBVHNode& Node, const FVector& RayOrigin, const FVector& InvDirection, float MaxDistance);
+
+    TArray<FBVHNode> Nodes;
+
+    /** 리프 순서로 정렬된 삼각형 */
+    TArray<FTriangle> Triangles;
+
+    TArray<FVector> Centroids;
+    TArray<FBoundingBox> TriangleBounds;
 };
@@ -0,0 +1,513 @@
+#include "FrustumCulling.h"
+
+#include <bit>
+#include <random>
+#include <immintrin.h>
+#include <intrin.h>
+
+#include "UnrealEd/EditorViewportClient.h"
+#include "FWindowsPlatformTime.h"
+
+void FBoundsSoA::Add(const FBoundingBox& Box)
+{
+    MinX.Add(Box.min.x);
+    MinY.Add(Box.min.y);
+    MinZ.Add(Box.min.z);
+    MaxX.Add(Box.max.x);
+    MaxY.Add(Box.max.y);
+    MaxZ.Add(Box.max.z);
+}
+
+void FBoundsSoA::Set(uint32 Index, const FBoundingBox& Box)
+{
+    MinX[Index] = Box.min.x;
+    MinY[Index] = Box.min.y;
+    MinZ[Index] = Box.min.z;
+    MaxX[Index] = Box.max.x;
+    MaxY[Index] = Box.max.y;
+    MaxZ[Index] = Box.max.z;
+}
+
+FBoundingBox FBoundsSoA::Get(uint32 Index) const
+{
+    return FBoundingBox(FVector(MinX[Index], MinY[Index], MinZ[Index]), FVector(MaxX[Index], MaxY[Index], MaxZ[Index]));
+}
+
+void FBoundsSoA::RemoveAtSwap(uint32 Index)
+{
+    MinX.RemoveAtSwap(Index);
+    MinY.RemoveAtSwap(Index);
+    MinZ.RemoveAtSwap(Index);
+    MaxX.RemoveAtSwap(Index);
+    MaxY.RemoveAtSwap(Index);
+    MaxZ.RemoveAtSwap(Index);
+}
+
+void FBoundsSoA::Reserve(uint32 Number)
+{
+    MinX.Reserve(Number);
+    MinY.Reserve(Number);
+    MinZ.Reserve(Number);
+    MaxX.Reserve(Number);
+    MaxY.Reserve(Number);
+    MaxZ.Reserve(Number);
+}
+
+void FBoundsSoA::Empty()
+{
+    MinX.Empty();
+    MinY.Empty();
+    MinZ.Empty();
+    MaxX.Empty();
+    MaxY.Empty();
+    MaxZ.Empty();
+}
+
+uint64 FBoundsSoA::GetAllocatedSize() const
+{
+    return static_cast<uint64>(MinX.Len() + MinY.Len() + MinZ.Len() + MaxX.Len() + MaxY.Len() + MaxZ.Len()) * sizeof(float);
+}
+
+namespace
+{
+    /**
+     * 평면마다 Positive Vertex로 쓸 성분 배열을 미리 골라둠.
+     * 법선 부호는 평면마다 고정이므로 박스별로 분기할 필요가 없음
+     */
+    struct FPlaneSources
+    {
+        const float* X[6];
+        const float* Y[6];
+        const float* Z[6];
+
+        /** SkipPlaneMask에 없는, 실제로 검사할 평면 번호 */
+        int32 Planes[6];
+        int32 NumPlanes;
+    };
+
+    FPlaneSources MakePlaneSources(const Frustum& Frustum, const FBoundsSoA& Bounds, uint8 SkipPlaneMask)
+    {
+        FPlaneSources Sources;
+        Sources.NumPlanes = 0;
+        for (int32 p = 0; p < 6; ++p)
+        {
+            if ((SkipPlaneMask & (1 << p)) == 0)
+            {
+                Sources.Planes[Sources.NumPlanes++] = p;
+            }
+
+            const FVector& Normal = Frustum.planes[p].normal;
+            Sources.X[p] = Normal.x >= 0 ? Bounds.MaxX.GetData() : Bounds.MinX.GetData();
+            Sources.Y[p] = Normal.y >= 0 ? Bounds.MaxY.GetData() : Bounds.MinY.GetData();
+            Sources.Z[p] = Normal.z >= 0 ? Bounds.MaxZ.GetData() : Bounds.MinZ.GetData();
+        }
+        return Sources;
+    }
+
+    uint32 CullRangeScalar(const Frustum& Frustum, const FPlaneSources& Sources, uint32 Start, uint32 End, uint32* OutVisibleIndices)
+    {
+        uint32 NumVisible = 0;
+        for (uint32 i = Start; i < End; ++i)
+        {
+            bool bVisible = true;
+            for (int32 k = 0; k < Sources.NumPlanes; ++k)
+            {
+                const int32 p = Sources.Planes[k];
+                const Plane& Plane = Frustum.planes[p];
+                const float Dist = Sources.X[p][i] * Plane.normal.x + Sources.Y[p][i] * Plane.normal.y + Sources.Z[p][i] * Plane.normal.z + Plane.d;
+                if (Dist < Frustum::CullMargin)
+                {
+                    bVisible = false;
+                    break;
+                }
+            }
+            if (bVisible)
+            {
+                OutVisibleIndices[NumVisible++] = i;
+            }
+        }
+        return NumVisible;
+    }
+
+    bool DetectAVX2()
+    {
+        int32 Info[4];
+        __cpuid(Info, 0);
+        if (Info[0] < 7)
+        {
+            return false;
+        }
+
+        __cpuid(Info, 1);
+        const bool bOSXSave = (Info[2] & (1 << 27)) != 0;
+        const bool bAVX = (Info[2] & (1 << 28)) != 0;
+        if (!bOSXSave || !bAVX)
+        {
+            return false;
+        }
+
+        // OS가 YMM 레지스터를 저장해주는지 확인
+        if ((_xgetbv(0) & 0x6) != 0x6)
+        {
+            return false;
+        }
+
+        __cpuidex(Info, 7, 0);
+        return (Info[1] & (1 << 5)) != 0;
+    }
+}
+
+uint32 FFrustumCulling::CullBoxesScalar(const Frustum& Frustum, const FBoundsSoA& Bounds, uint32 Start, uint32 Count, uint32* OutVisibleIndices, uint8 SkipPlaneMask)
+{
+    return CullRangeScalar(Frustum, MakePlaneSources(Frustum, Bounds, SkipPlaneMask), Start, Start + Count, OutVisibleIndices);
+}
+
+uint32 FFrustumCulling::CullBoxesSSE(const Frustum& Frustum, const FBoundsSoA& Bounds, uint32 Start, uint32 Count, uint32* OutVisibleIndices, uint8 SkipPlaneMask)
+{
+    const FPlaneSources Sources = MakePlaneSources(Frustum, Bounds, SkipPlaneMask);
+
+    __m128 NX[6], NY[6], NZ[6], D[6];
+    for (int32 p = 0; p < 6; ++p)
+    {
+        NX[p] = _mm_set1_ps(Frustum.planes[p].normal.x);
+        NY[p] = _mm_set1_ps(Frustum.planes[p].normal.y);
+        NZ[p] = _mm_set1_ps(Frustum.planes[p].normal.z);
+        D[p] = _mm_set1_ps(Frustum.planes[p].d);
+    }
+    const __m128 Margin = _mm_set1_ps(Frustum::CullMargin);
+    const __m128 AllVisible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+    const uint32 End = Start + Count;
+    uint32 NumVisible = 0;
+    uint32 i = Start;
+    for (; i + 4 <= End; i += 4)
+    {
+        __m128 Visible = AllVisible;
+        for (int32 k = 0; k < Sources.NumPlanes; ++k)
+        {
+            const int32 p = Sources.Planes[k];
+            // 스칼라와 같은 순서로 더해서 결과가 똑같이 나오게 함
+            __m128 Dist = _mm_mul_ps(_mm_loadu_ps(Sources.X[p] + i), NX[p]);
+            Dist = _mm_add_ps(Dist, _mm_mul_ps(_mm_loadu_ps(Sources.Y[p] + i), NY[p]));
+            Dist = _mm_add_ps(Dist, _mm_mul_ps(_mm_loadu_ps(Sources.Z[p] + i), NZ[p]));
+            Dist = _mm_add_ps(Dist, D[p]);
+
+            // !(Dist < Margin). NaN 처리도 스칼라와 같음
+            Visible = _mm_and_ps(Visible, _mm_cmpnlt_ps(Dist, Margin));
+            if (_mm_movemask_ps(Visible) == 0)
+            {
+                break;
+            }
+        }
+
+        uint32 Mask = static_cast<uint32>(_mm_movemask_ps(Visible));
+        while (Mask)
+        {
+            OutVisibleIndices[NumVisible++] = i + std::countr_zero(Mask);
+            Mask &= Mask - 1;
+        }
+    }
+
+    return NumVisible + CullRangeScalar(Frustum, Sources, i, End, OutVisibleIndices + NumVisible);
+}
+
+uint32 FFrustumCulling::CullBoxesAVX2(const Frustum& Frustum, const FBoundsSoA& Bounds, uint32 Start, uint32 Count, uint32* OutVisibleIndices, uint8 SkipPlaneMask)
+{
+    const FPlaneSources Sources = MakePlaneSources(Frustum, Bounds, SkipPlaneMask);
+
+    __m256 NX[6], NY[6], NZ[6], D[6];
+    for (int32 p = 0; p < 6; ++p)
+    {
+        NX[p] = _mm256_set1_ps(Frustum.planes[p].normal.x);
+        NY[p] = _mm256_set1_ps(Frustum.planes[p].normal.y);
+        NZ[p] = _mm256_set1_ps(Frustum.planes[p].normal.z);
+        D[p] = _mm256_set1_ps(Frustum.planes[p].d);
+    }
+    const __m256 Margin = _mm256_set1_ps(Frustum::CullMargin);
+    const __m256 AllVisible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+    const uint32 End = Start + Count;
+    uint32 NumVisible = 0;
+    uint32 i = Start;
+    for (; i + 8 <= End; i += 8)
+    {
+        __m256 Visible = AllVisible;
+        for (int32 k = 0; k < Sources.NumPlanes; ++k)
+        {
+            const int32 p = Sources.Planes[k];
+            // FMA를 쓰면 스칼라와 결과가 달라질 수 있으므로 mul/add로 계산
+            __m256 Dist = _mm256_mul_ps(_mm256_loadu_ps(Sources.X[p] + i), NX[p]);
+            Dist = _mm256_add_ps(Dist, _mm256_mul_ps(_mm256_loadu_ps(Sources.Y[p] + i), NY[p]));
+            Dist = _mm256_add_ps(Dist, _mm256_mul_ps(_mm256_loadu_ps(Sources.Z[p] + i), NZ[p]));
+            Dist = _mm256_add_ps(Dist, D[p]);
+
+            Visible = _mm256_and_ps(Visible, _mm256_cmp_ps(Dist, Margin, _CMP_NLT_UQ));
+            if (_mm256_movemask_ps(Visible) == 0)
+            {
+                break;
+            }
+        }
+
+        uint32 Mask = static_cast<uint32>(_mm256_movemask_ps(Visible));
+        while (Mask)
+        {
+            OutVisibleIndices[NumVisible++] = i + std::countr_zero(Mask);
+            Mask &= Mask - 1;
+        }
+    }
+    _mm256_zeroupper();
+
+    return NumVisible + CullRangeScalar(Frustum, Sources, i, End, OutVisibleIndices + NumVisible);
+}
+
+FFrustumCulling::EKernel FFrustumCulling::GetBestKernel()
+{
+    // x64는 SSE2를 항상 지원하므로 AVX2만 확인
+    static const EKernel BestKernel = DetectAVX2() ? EKernel::AVX2 : EKernel::SSE;
+    return BestKernel;
+}
+
+const char* FFrustumCulling::GetKernelName(EKernel Kernel)
+{
+    switch (Kernel)
+    {
+    case EKernel::Scalar: return "Scalar";
+    case EKernel::SSE: return "SSE";
+    case EKernel::AVX2: return "AVX2";
+    }
+    return "Unknown";
+}
+
+uint32 FFrustumCulling::CullBoxes(const Frustum& Frustum, const FBoundsSoA& Bounds, uint32 Start, uint32 Count, uint32* OutVisibleIndices, uint8 SkipPlaneMask)
+{
+    return CullBoxes(GetBestKernel(), Frustum, Bounds, Start, Count, OutVisibleIndices, SkipPlaneMask);
+}
+
+uint32 FFrustumCulling::CullBoxes(EKernel Kernel, const Frustum& Frustum, const FBoundsSoA& Bounds, uint32 Start, uint32 Count, uint32* OutVisibleIndices, uint8 SkipPlaneMask)
+{
+    switch (Kernel)
+    {
+    case EKernel::AVX2: return CullBoxesAVX2(Frustum, Bounds, Start, Count, OutVisibleIndices, SkipPlaneMask);
+    case EKernel::SSE: return CullBoxesSSE(Frustum, Bounds, Start, Count, OutVisibleIndices, SkipPlaneMask);
+    default: return CullBoxesScalar(Frustum, Bounds, Start, Count, OutVisibleIndices, SkipPlaneMask);
+    }
+}
+
+bool FFrustumCulling::IntersectsMasked(const Frustum& Frustum, const FBoundingBox& Box, uint8& InOutInsideMask, FCullStats& Stats)
+{
+    for (int32 p = 0; p < 6; ++p)
+    {
+        if (InOutInsideMask & (1 << p))
+        {
+            ++Stats.PlaneTestsSkipped;
+            continue;
+        }
+        ++Stats.PlaneTests;
+
+        const Plane& Plane = Frustum.planes[p];
+        const float PositiveDist = Box.GetPositiveVertex(Plane.normal).Dot(Plane.normal) + Plane.d;
+        if (PositiveDist < Frustum::CullMargin)
+        {
+            return false;
+        }
+
+        // 반대쪽 꼭짓점도 안쪽이면 자식들은 이 평면을 검사할 필요가 없음
+        const FVector NegativeVertex(
+            Plane.normal.x >= 0 ? Box.min.x : Box.max.x,
+            Plane.normal.y >= 0 ? Box.min.y : Box.max.y,
+            Plane.normal.z >= 0 ? Box.min.z : Box.max.z
+        );
+        if (NegativeVertex.Dot(Plane.normal) + Plane.d >= Frustum::CullMargin)
+        {
+            InOutInsideMask |= static_cast<uint8>(1 << p);
+        }
+    }
+    return true;
+}
+
+void FFrustumCulling::RunBenchmark(const Frustum& Frustum, uint32 NumBoxes)
+{
+    constexpr int32 NumIterations = 50;
+
+    // 옥트리 범위 안에 작은 박스를 고르게 뿌림
+    std::mt19937 Random(1234);
+    std::uniform_real_distribution<float> Position(-100.f, 100.f);
+    std::uniform_real_distribution<float> Extent(0.1f, 2.f);
+
+    FBoundsSoA Bounds;
+    Bounds.Reserve(NumBoxes);
+    for (uint32 i = 0; i < NumBoxes; ++i)
+    {
+        const FVector Center(Position(Random), Position(Random), Position(Random));
+        const float E = Extent(Random);
+        Bounds.Add(FBoundingBox(Center - FVector(E, E, E), Center + FVector(E, E, E)));
+    }
+
+    TArray<uint32> Reference;
+    Reference.SetNum(NumBoxes);
+    const uint32 NumReference = CullBoxes(EKernel::Scalar, Frustum, Bounds, 0, NumBoxes, Reference.GetData());
+
+    UE_LOG(LogLevel::Display, "Frustum cull benchmark: %u boxes, %u visible, best kernel %s", NumBoxes, NumReference, GetKernelName(GetBestKernel()));
+
+    TArray<uint32> Visible;
+    Visible.SetNum(NumBoxes);
+    double ScalarMs = 0.0;
+    for (EKernel Kernel : { EKernel::Scalar, EKernel::SSE, EKernel::AVX2 })
+    {
+        if (Kernel == EKernel::AVX2 && GetBestKernel() != EKernel::AVX2)
+        {
+            UE_LOG(LogLevel::Display, " - %s: not supported", GetKernelName(Kernel));
+            continue;
+        }
+
+        uint32 NumVisible = 0;
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+        {
+            NumVisible = CullBoxes(Kernel, Frustum, Bounds, 0, NumBoxes, Visible.GetData());
+        }
+        const double Ms = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles) / NumIterations;
+
+        bool bMatches = NumVisible == NumReference;
+        for (uint32 i = 0; bMatches && i < NumVisible; ++i)
+        {
+            bMatches = Visible[i] == Reference[i];
+        }
+
+        if (Kernel == EKernel::Scalar)
+        {
+            ScalarMs = Ms;
+        }
+        UE_LOG(LogLevel::Display, " - %s: %.4f ms (x%.2f), %s", GetKernelName(Kernel), Ms, Ms > 0.0 ? ScalarMs / Ms : 0.0, bMatches ? "match" : "MISMATCH");
+    }
+}
+
+void FVisibilityCache::BeginCull(const Frustum& Frustum)
+{
+    // 0은 "판정한 적 없음"이므로 건너뜀
+    if (++CullIndex == 0)
+    {
+        CullIndex = 1;
+    }
+
+    NormalDelta = 0.f;
+    DistanceDelta = 0.f;
+    for (int32 p = 0; p < 6; ++p)
+    {
+        const Plane& Plane = Frustum.planes[p];
+        const FVector Delta(Plane.normal.x - PrevPlanes[p][0], Plane.normal.y - PrevPlanes[p][1], Plane.normal.z - PrevPlanes[p][2]);
+        NormalDelta = FMath::Max(NormalDelta, Delta.Magnitude());
+        DistanceDelta = FMath::Max(DistanceDelta, std::abs(Plane.d - PrevPlanes[p][3]));
+
+        PrevPlanes[p][0] = Plane.normal.x;
+        PrevPlanes[p][1] = Plane.normal.y;
+        PrevPlanes[p][2] = Plane.normal.z;
+        PrevPlanes[p][3] = Plane.d;
+    }
+
+    LastHits.store(0, std::memory_order_relaxed);
+    LastMisses.store(0, std::memory_order_relaxed);
+    LastPlaneTests.store(0, std::memory_order_relaxed);
+    LastPlaneTestsSkipped.store(0, std::memory_order_relaxed);
+}
+
+bool FVisibilityCache::Classify(const Frustum& Frustum, const FBoundingBox& Box, FCullCacheEntry& Entry, FCullStats& Stats) const
+{
+    // 같은 컬링 안에서 다시 물어보면 그대로 돌려줌 (작업을 모을 때와 작업 안에서 두 번 검사하는 노드)
+    if (Entry.CullIndex == CullIndex)
+    {
+        return Entry.bVisible;
+    }
+
+    // 직전 컬링에서 판정한 노드만 재사용. 그 사이에 건너뛴 컬링의 평면 변화는 알 수 없음
+    if (Entry.CullIndex != 0 && Entry.CullIndex + 1 == CullIndex)
+    {
+        // 박스 꼭짓점 중 원점에서 가장 먼 점까지의 거리
+        const FVector Far(
+            FMath::Max(std::abs(Box.min.x), std::abs(Box.max.x)),
+            FMath::Max(std::abs(Box.min.y), std::abs(Box.max.y)),
+            FMath::Max(std::abs(Box.min.z), std::abs(Box.max.z))
+        );
+        // float 반올림 오차만큼 여유를 더 줌
+        const float Change = (NormalDelta * Far.Magnitude() + DistanceDelta) * 1.001f + 1e-5f;
+        if (Change < Entry.Slack)
+        {
+            // 남은 여유는 다음 컬링에서 누적된 변화에 대해 다시 씀
+            Entry.Slack -= Change;
+            Entry.CullIndex = CullIndex;
+            ++Stats.Hits;
+            return Entry.bVisible;
+        }
+    }
+
+    Evaluate(Frustum, Box, Entry);
+    Entry.CullIndex = CullIndex;
+    ++Stats.Misses;
+    Stats.PlaneTests += 6;
+    return Entry.bVisible;
+}
+
+void FVisibilityCache::Evaluate(const Frustum& Frustum, const FBoundingBox& Box, FCullCacheEntry& Entry)
+{
+    // 보이는 박스는 모든 평면에서 판정 경계까지의 최소 거리,
+    // 안 보이는 박스는 바깥으로 판정된 평면 중 가장 멀리 벗어난 거리가 여유가 됨
+    float VisibleSlack = FLT_MAX;
+    float OutsideSlack = 0.f;
+    bool bVisible = true;
+    uint8 InsideMask = 0;
+    for (int32 p = 0; p < 6; ++p)
+    {
+        const Plane& Plane = Frustum.planes[p];
+        const float PositiveDist = Box.GetPositiveVertex(Plane.normal).Dot(Plane.normal) + Plane.d;
+        if (PositiveDist < Frustum::CullMargin)
+        {
+            bVisible = false;
+            OutsideSlack = FMath::Max(OutsideSlack, Frustum::CullMargin - PositiveDist);
+            continue;
+        }
+
+        // 반대쪽 꼭짓점도 안쪽이면 이 평면에 대해서는 박스 전체가 안쪽
+        const FVector NegativeVertex(
+            Plane.normal.x >= 0 ? Box.min.x : Box.max.x,
+            Plane.normal.y >= 0 ? Box.min.y : Box.max.y,
+            Plane.normal.z >= 0 ? Box.min.z : Box.max.z
+        );
+        const float NegativeDist = NegativeVertex.Dot(Plane.normal) + Plane.d;
+        if (NegativeDist >= Frustum::CullMargin)
+        {
+            InsideMask |= static_cast<uint8>(1 << p);
+        }
+        VisibleSlack = FMath::Min(VisibleSlack, FMath::Min(PositiveDist - Frustum::CullMargin, std::abs(NegativeDist - Frustum::CullMargin)));
+    }
+
+    Entry.bVisible = bVisible;
+    Entry.InsideMask = bVisible ? InsideMask : 0;
+    Entry.Slack = bVisible ? VisibleSlack : OutsideSlack;
+}
+
+void FVisibilityCache::AddStats(const FCullStats& Stats)
+{
+    LastHits.fetch_add(Stats.Hits, std::memory_order_relaxed);
+    LastMisses.fetch_add(Stats.Misses, std::memory_order_relaxed);
+    LastPlaneTests.fetch_add(Stats.PlaneTests, std::memory_order_relaxed);
+    LastPlaneTestsSkipped.fetch_add(Stats.PlaneTestsSkipped, std::memory_order_relaxed);
+    TotalHits.fetch_add(Stats.Hits, std::memory_order_relaxed);
+    TotalMisses.fetch_add(Stats.Misses, std::memory_order_relaxed);
+}
+
+FCullStats FVisibilityCache::GetLastStats() const
+{
+    FCullStats Stats;
+    Stats.Hits = LastHits.load(std::memory_order_relaxed);
+    Stats.Misses = LastMisses.load(std::memory_order_relaxed);
+    Stats.PlaneTests = LastPlaneTests.load(std::memory_order_relaxed);
+    Stats.PlaneTestsSkipped = LastPlaneTestsSkipped.load(std::memory_order_relaxed);
+    return Stats;
+}
+
+double FVisibilityCache::GetTotalHitRate() const
+{
+    const uint64 Hits = TotalHits.load(std::memory_order_relaxed);
+    const uint64 Total = Hits + TotalMisses.load(std::memory_order_relaxed);
+    return Total > 0 ? static_cast<double>(Hits) / static_cast<double>(Total) : 0.0;
+}
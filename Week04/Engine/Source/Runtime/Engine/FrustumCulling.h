@@ -0,0 +1,154 @@
+#pragma once
+#include <atomic>
+#include <functional>
+
+#include "Define.h"
+
+class UPrimitiveComponent;
+struct Frustum;
+
+/**
+ * 병렬 컬링에서 보이는 컴포넌트마다 호출됩니다.
+ * ThreadIndex는 FJobSystem::GetThreadIndex()이므로 스레드별 버퍼를 락 없이 쓸 수 있습니다.
+ */
+using FCullVisitor = std::function<void(int32 ThreadIndex, UPrimitiveComponent* Component)>;
+
+/**
+ * AABB 여러 개를 축별 배열(SoA)로 저장합니다.
+ * SIMD로 박스 4/8개의 같은 성분을 한 번에 읽기 위함입니다.
+ */
+struct FBoundsSoA
+{
+    TArray<float> MinX;
+    TArray<float> MinY;
+    TArray<float> MinZ;
+    TArray<float> MaxX;
+    TArray<float> MaxY;
+    TArray<float> MaxZ;
+
+    uint32 Num() const { return MinX.Num(); }
+
+    void Add(const FBoundingBox& Box);
+    void Set(uint32 Index, const FBoundingBox& Box);
+    FBoundingBox Get(uint32 Index) const;
+
+    /** Index의 박스를 마지막 박스와 바꾼 뒤 제거합니다. TArray::RemoveAtSwap과 짝을 맞춰 씁니다. */
+    void RemoveAtSwap(uint32 Index);
+
+    void Reserve(uint32 Number);
+    void Empty();
+
+    uint64 GetAllocatedSize() const;
+};
+
+/** 한 번의 컬링 통계. 워커마다 따로 세고 FVisibilityCache::AddStats로 합칩니다. */
+struct FCullStats
+{
+    uint32 Hits = 0;              // 노드 판정을 직전 컬링에서 재사용한 횟수
+    uint32 Misses = 0;            // 노드 판정을 다시 계산한 횟수
+    uint32 PlaneTests = 0;        // 박스 하나와 평면 하나를 검사한 횟수
+    uint32 PlaneTestsSkipped = 0; // 부모가 이미 안쪽에 있는 평면이라 건너뛴 횟수
+};
+
+/** 여러 AABB를 한 번에 Frustum 컬링하는 커널 */
+class FFrustumCulling
+{
+public:
+    enum class EKernel : uint8
+    {
+        Scalar,
+        SSE,
+        AVX2,
+    };
+
+    /** 6개 평면이 모두 켜진 평면 마스크 (좌우 상하 near far 순) */
+    static constexpr uint8 AllPlanesMask = 0x3F;
+
+    /**
+     * Bounds[Start, Start + Count) 중 Frustum과 겹치는 박스의 인덱스를 OutVisibleIndices에 앞에서부터 채웁니다.
+     * 판정은 Frustum::Intersects와 같습니다. CPU가 지원하는 가장 넓은 커널을 사용합니다.
+     * @param OutVisibleIndices 최소 Count개를 담을 수 있어야 함
+     * @param SkipPlaneMask 검사하지 않을 평면 비트. 박스들을 모두 감싸는 부모가 그 평면 안쪽에 있을 때만 결과가 같음
+     * @return 보이는 박스 개수
+     */
+    static uint32 CullBoxes(const Frustum& Frustum, const FBoundsSoA& Bounds, uint32 Start, uint32 Count, uint32* OutVisibleIndices, uint8 SkipPlaneMask = 0);
+
+    static uint32 CullBoxes(EKernel Kernel, const Frustum& Frustum, const FBoundsSoA& Bounds, uint32 Start, uint32 Count, uint32* OutVisibleIndices, uint8 SkipPlaneMask = 0);
+
+    /**
+     * Box를 InOutInsideMask에 없는 평면으로만 판정합니다. 켜진 비트의 평면은 Box가 완전히 안쪽에 있다고 보고 건너뜁니다.
+     * 보이면 Box가 새로 완전히 안쪽에 들어간 평면의 비트를 InOutInsideMask에 더합니다.
+     * 마스크가 맞다면 결과는 Frustum::Intersects와 같습니다.
+     */
+    static bool IntersectsMasked(const Frustum& Frustum, const FBoundingBox& Box, uint8& InOutInsideMask, FCullStats& Stats);
+
+    static EKernel GetBestKernel();
+
+    static const char* GetKernelName(EKernel Kernel);
+
+    /** 임의의 박스 NumBoxes개로 커널별 시간을 재고 결과가 같은지 확인해서 로그로 남깁니다. */
+    static void RunBenchmark(const Frustum& Frustum, uint32 NumBoxes = 100000);
+
+private:
+    static uint32 CullBoxesScalar(const Frustum& Frustum, const FBoundsSoA& Bounds, uint32 Start, uint32 Count, uint32* OutVisibleIndices, uint8 SkipPlaneMask);
+    static uint32 CullBoxesSSE(const Frustum& Frustum, const FBoundsSoA& Bounds, uint32 Start, uint32 Count, uint32* OutVisibleIndices, uint8 SkipPlaneMask);
+    static uint32 CullBoxesAVX2(const Frustum& Frustum, const FBoundsSoA& Bounds, uint32 Start, uint32 Count, uint32* OutVisibleIndices, uint8 SkipPlaneMask);
+};
+
+/** 노드 박스 하나의 직전 판정 결과. 노드마다 하나씩 두고 FVisibilityCache로 읽고 씁니다. */
+struct FCullCacheEntry
+{
+    uint32 CullIndex = 0;   // 판정한 컬링 번호. 0이면 판정한 적 없음
+    float Slack = 0.f;      // 박스 위 점의 평면 거리가 이만큼 바뀌기 전에는 판정이 바뀌지 않음
+    uint8 InsideMask = 0;   // 박스가 완전히 안쪽에 있는 평면 비트 (좌우 상하 near far 순)
+    bool bVisible = false;
+};
+
+/**
+ * 프레임 사이의 노드 가시성 캐시.
+ * 직전 컬링의 평면과 이번 평면의 차이로 박스 위 점의 평면 거리가 바뀔 수 있는 최대값을 구하고,
+ * 직전 판정의 여유(Slack)가 그보다 크면 평면 검사 없이 판정과 InsideMask를 재사용합니다.
+ * 카메라가 조금만 움직이면 경계에서 먼 노드는 다시 검사하지 않습니다.
+ */
+class FVisibilityCache
+{
+public:
+    /** 컬링을 시작할 때 한 번 호출합니다. 직전 평면과의 차이를 구하고 이번 컬링의 통계를 새로 셉니다. */
+    void BeginCull(const Frustum& Frustum);
+
+    /**
+     * Box가 Frustum과 겹치는지 판정합니다. 결과는 Frustum::Intersects와 같습니다.
+     * Entry가 직전 컬링에서 판정된 것이고 여유가 남아 있으면 재사용하고, 아니면 다시 계산해서 Entry에 저장합니다.
+     * Entry는 한 스레드만 건드려야 하고, 통계는 Stats에 쌓았다가 AddStats로 합칩니다.
+     */
+    bool Classify(const Frustum& Frustum, const FBoundingBox& Box, FCullCacheEntry& Entry, FCullStats& Stats) const;
+
+    /** 워커마다 센 통계를 더합니다. */
+    void AddStats(const FCullStats& Stats);
+
+    /** 마지막 컬링의 통계. 캐시를 쓰지 않은 FrustumCull 호출은 포함되지 않음 */
+    FCullStats GetLastStats() const;
+
+    /** 처음부터 누적된 통계의 적중률 [0, 1] */
+    double GetTotalHitRate() const;
+
+private:
+    /** 판정을 새로 계산합니다. */
+    static void Evaluate(const Frustum& Frustum, const FBoundingBox& Box, FCullCacheEntry& Entry);
+
+    uint32 CullIndex = 0;
+
+    /** 직전 컬링의 평면 (normal.xyz, d) */
+    float PrevPlanes[6][4] = {};
+
+    /** 이번 컬링에서 평면 법선과 d가 바뀐 최대량. 점 x의 거리 변화는 NormalDelta * |x| + DistanceDelta 이하 */
+    float NormalDelta = 0.f;
+    float DistanceDelta = 0.f;
+
+    std::atomic<uint32> LastHits = 0;
+    std::atomic<uint32> LastMisses = 0;
+    std::atomic<uint32> LastPlaneTests = 0;
+    std::atomic<uint32> LastPlaneTestsSkipped = 0;
+    std::atomic<uint64> TotalHits = 0;
+    std::atomic<uint64> TotalMisses = 0;
+};
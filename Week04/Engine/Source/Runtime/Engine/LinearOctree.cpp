@@ -0,0 +1,345 @@
+#include "LinearOctree.h"
+
+#include <bit>
+
+#include "OctreeNode.h"
+#include "FrustumCulling.h"
+#include "UnrealEd/EditorViewportClient.h"
+#include "Engine/Classes/Components/PrimitiveComponent.h"
+#include "Math/MathUtility.h"
+#include "Core/Async/JobSystem.h"
+
+namespace
+{
+    // 10비트 값을 3비트 간격으로 벌림
+    uint32 ExpandBits(uint32 Value)
+    {
+        Value &= 0x000003ff;
+        Value = (Value | (Value << 16)) & 0x030000ff;
+        Value = (Value | (Value << 8)) & 0x0300f00f;
+        Value = (Value | (Value << 4)) & 0x030c30c3;
+        Value = (Value | (Value << 2)) & 0x09249249;
+        return Value;
+    }
+}
+
+uint32 FLinearOctree::EncodeMorton(uint32 X, uint32 Y, uint32 Z)
+{
+    // 자식 인덱스 규칙(x = 1, y = 2, z = 4)을 FOctreeNode::SubDivide와 맞춤
+    return ExpandBits(X) | (ExpandBits(Y) << 1) | (ExpandBits(Z) << 2);
+}
+
+void FLinearOctree::Build(const TArray<UPrimitiveComponent*>& Components, const FBoundingBox& InBounds)
+{
+    Empty();
+    Bounds = InBounds;
+
+    const uint32 NumComponents = Components.Num();
+    if (NumComponents == 0)
+    {
+        return;
+    }
+
+    const float CellsPerAxis = static_cast<float>(1 << MortonBitsPerAxis);
+    const FVector Size = Bounds.max - Bounds.min;
+    const FVector Scale(
+        Size.x > 0.f ? CellsPerAxis / Size.x : 0.f,
+        Size.y > 0.f ? CellsPerAxis / Size.y : 0.f,
+        Size.z > 0.f ? CellsPerAxis / Size.z : 0.f
+    );
+    const float MaxCell = CellsPerAxis - 1.f;
+
+    struct FMortonEntry
+    {
+        uint32 Code;
+        uint32 Index;
+    };
+
+    // 물체가 움직일 때마다 다시 만들므로 임시 배열은 프레임 할당자에서 받음
+    TFrameArray<FBoundingBox> Boxes;
+    TFrameArray<FMortonEntry> Entries;
+    Boxes.SetNum(NumComponents);
+    Entries.SetNum(NumComponents);
+
+    for (uint32 i = 0; i < NumComponents; ++i)
+    {
+        Boxes[i] = Components[i]->GetWorldBoundingBox();
+
+        // 범위 밖의 물체는 가장자리 셀로 들어감. 노드 AABB는 아이템으로 맞추므로 컬링은 정확함
+        const FVector Local = Boxes[i].GetCenter() - Bounds.min;
+        Entries[i].Code = EncodeMorton(
+            static_cast<uint32>(FMath::Clamp(Local.x * Scale.x, 0.f, MaxCell)),
+            static_cast<uint32>(FMath::Clamp(Local.y * Scale.y, 0.f, MaxCell)),
+            static_cast<uint32>(FMath::Clamp(Local.z * Scale.z, 0.f, MaxCell))
+        );
+        Entries[i].Index = i;
+    }
+
+    Entries.Sort([](const FMortonEntry& A, const FMortonEntry& B) { return A.Code < B.Code; });
+
+    Items.SetNum(NumComponents);
+    ItemBounds.Reserve(NumComponents);
+    ItemCodes.SetNum(NumComponents);
+    for (uint32 i = 0; i < NumComponents; ++i)
+    {
+        Items[i] = Components[Entries[i].Index];
+        ItemBounds.Add(Boxes[Entries[i].Index]);
+        ItemCodes[i] = Entries[i].Code;
+    }
+
+    // 대략 리프 하나당 MaxItemsPerLeaf / 4 개 정도로 잡음
+    Nodes.Reserve(NumComponents * 4 / MaxItemsPerLeaf + 1);
+    BuildNode(0, NumComponents, 0, 0);
+    NodeCullCache.SetNum(Nodes.Num());
+
+    // 빌드에만 필요하므로 메모리까지 해제
+    ItemCodes = TArray<uint32>();
+}
+
+uint32 FLinearOctree::BuildNode(uint32 Start, uint32 End, uint32 Depth, uint32 Prefix)
+{
+    // 재귀 중에 Nodes가 재할당될 수 있으므로 참조 대신 인덱스로 접근
+    const uint32 NodeIndex = Nodes.Num();
+    FLinearOctreeNode NewNode = {};
+    NewNode.MortonCode = Prefix;
+    NewNode.ItemStart = Start;
+    NewNode.ItemCount = End - Start;
+    NewNode.Depth = static_cast<uint8>(Depth);
+    NewNode.bIsLeaf = (End - Start <= MaxItemsPerLeaf) || Depth >= MortonBitsPerAxis;
+    Nodes.Add(NewNode);
+
+    FBoundingBox NodeBounds = ItemBounds.Get(Start);
+    if (Nodes[NodeIndex].bIsLeaf)
+    {
+        for (uint32 i = Start + 1; i < End; ++i)
+        {
+            NodeBounds = NodeBounds.Union(ItemBounds.Get(i));
+        }
+    }
+    else
+    {
+        // 정렬되어 있으므로 같은 자식 자리(3비트)를 가진 아이템은 연속해 있음
+        const uint32 Shift = 3 * (MortonBitsPerAxis - 1 - Depth);
+        uint32 ChildStart = Start;
+        while (ChildStart < End)
+        {
+            const uint32 ChildDigit = (ItemCodes[ChildStart] >> Shift) & 7;
+            uint32 ChildEnd = ChildStart + 1;
+            while (ChildEnd < End && ((ItemCodes[ChildEnd] >> Shift) & 7) == ChildDigit)
+            {
+                ++ChildEnd;
+            }
+
+            const uint32 ChildIndex = BuildNode(ChildStart, ChildEnd, Depth + 1, (Prefix << 3) | ChildDigit);
+            NodeBounds = NodeBounds.Union(Nodes[ChildIndex].Bounds);
+            ChildStart = ChildEnd;
+        }
+    }
+
+    Nodes[NodeIndex].Bounds = NodeBounds;
+    Nodes[NodeIndex].SubtreeEnd = Nodes.Num();
+    return NodeIndex;
+}
+
+void FLinearOctree::Empty()
+{
+    Nodes.Empty();
+    NodeCullCache.Empty();
+    Items.Empty();
+    ItemBounds.Empty();
+    ItemCodes.Empty();
+}
+
+template <typename FuncType>
+void FLinearOctree::CullSubtree(const Frustum& Frustum, uint32 Root, uint8 RootInsideMask, const FVisibilityCache* Cache, FCullStats& Stats, const FuncType& Func) const
+{
+    // 전위 순서이므로 노드의 부모는 가장 최근에 방문한 한 단계 얕은 노드. 깊이별로 마스크를 쌓아둠
+    uint8 MaskStack[MortonBitsPerAxis + 1];
+    const uint32 RootDepth = Nodes[Root].Depth;
+    const uint32 End = Nodes[Root].SubtreeEnd;
+    uint32 NodeIndex = Root;
+    while (NodeIndex < End)
+    {
+        const FLinearOctreeNode& Node = Nodes[NodeIndex];
+        const uint32 Level = Node.Depth - RootDepth;
+        uint8 InsideMask = RootInsideMask;
+        if (NodeIndex != Root)
+        {
+            InsideMask = MaskStack[Level - 1];
+            if (!IsNodeVisible(Frustum, NodeIndex, Cache, InsideMask, Stats))
+            {
+                NodeIndex = Node.SubtreeEnd;
+                continue;
+            }
+        }
+        MaskStack[Level] = InsideMask;
+
+        if (InsideMask == FFrustumCulling::AllPlanesMask)
+        {
+            // 서브트리의 아이템은 연속해 있으므로 검사 없이 한 번에 받아들임
+            Stats.PlaneTestsSkipped += 6 * (Node.SubtreeEnd - NodeIndex - 1 + Node.ItemCount);
+            const uint32 ItemEnd = Node.ItemStart + Node.ItemCount;
+            for (uint32 i = Node.ItemStart; i < ItemEnd; ++i)
+            {
+                Func(Items[i]);
+            }
+            NodeIndex = Node.SubtreeEnd;
+            continue;
+        }
+
+        if (Node.bIsLeaf)
+        {
+            // 노드 AABB가 아이템을 모두 감싸므로 노드가 안쪽에 있는 평면은 아이템도 안쪽
+            const uint32 NumSkipped = std::popcount(static_cast<uint32>(InsideMask));
+            Stats.PlaneTestsSkipped += Node.ItemCount * NumSkipped;
+            Stats.PlaneTests += Node.ItemCount * (6 - NumSkipped);
+
+            // 최대 깊이의 리프는 MaxItemsPerLeaf보다 많을 수 있으므로 나눠서 처리
+            uint32 VisibleIndices[CullBatchSize];
+            const uint32 ItemEnd = Node.ItemStart + Node.ItemCount;
+            for (uint32 BatchStart = Node.ItemStart; BatchStart < ItemEnd; BatchStart += CullBatchSize)
+            {
+                const uint32 BatchCount = FMath::Min(CullBatchSize, ItemEnd - BatchStart);
+                const uint32 NumVisible = FFrustumCulling::CullBoxes(Frustum, ItemBounds, BatchStart, BatchCount, VisibleIndices, InsideMask);
+                for (uint32 i = 0; i < NumVisible; ++i)
+                {
+                    Func(Items[VisibleIndices[i]]);
+                }
+            }
+        }
+        ++NodeIndex;
+    }
+}
+
+bool FLinearOctree::IsNodeVisible(const Frustum& Frustum, uint32 NodeIndex, const FVisibilityCache* Cache, uint8& InOutInsideMask, FCullStats& Stats) const
+{
+    if (InOutInsideMask == FFrustumCulling::AllPlanesMask)
+    {
+        Stats.PlaneTestsSkipped += 6;
+        return true;
+    }
+
+    if (Cache)
+    {
+        if (!Cache->Classify(Frustum, Nodes[NodeIndex].Bounds, NodeCullCache[NodeIndex], Stats))
+        {
+            return false;
+        }
+        InOutInsideMask |= NodeCullCache[NodeIndex].InsideMask;
+        return true;
+    }
+
+    return FFrustumCulling::IntersectsMasked(Frustum, Nodes[NodeIndex].Bounds, InOutInsideMask, Stats);
+}
+
+void FLinearOctree::FrustumCull(const Frustum& Frustum, TArray<UPrimitiveComponent*>& OutComponents, FCullStats* OutStats) const
+{
+    if (Nodes.IsEmpty())
+    {
+        return;
+    }
+
+    FCullStats Stats;
+    uint8 InsideMask = 0;
+    if (IsNodeVisible(Frustum, 0, nullptr, InsideMask, Stats))
+    {
+        CullSubtree(Frustum, 0, InsideMask, nullptr, Stats, [&](UPrimitiveComponent* Comp) { OutComponents.Add(Comp); });
+    }
+
+    if (OutStats)
+    {
+        OutStats->PlaneTests += Stats.PlaneTests;
+        OutStats->PlaneTestsSkipped += Stats.PlaneTestsSkipped;
+    }
+}
+
+void FLinearOctree::FrustumCullParallel(const Frustum& Frustum, const FCullVisitor& Visitor, FVisibilityCache* Cache) const
+{
+    struct FCullTask
+    {
+        uint32 Node;
+        uint8 InsideMask;
+    };
+
+    // 얕은 노드만 순회하면서 Frustum과 겹치는 서브트리의 시작 노드를 모음
+    TFrameArray<FCullTask> Tasks;
+    FCullStats CollectStats;
+    uint8 MaskStack[ParallelSplitDepth + 1];
+    const uint32 NumNodes = Nodes.Num();
+    uint32 NodeIndex = 0;
+    while (NodeIndex < NumNodes)
+    {
+        const FLinearOctreeNode& Node = Nodes[NodeIndex];
+        uint8 InsideMask = Node.Depth > 0 ? MaskStack[Node.Depth - 1] : 0;
+        if (!IsNodeVisible(Frustum, NodeIndex, Cache, InsideMask, CollectStats))
+        {
+            NodeIndex = Node.SubtreeEnd;
+            continue;
+        }
+
+        // 중간 노드는 아이템을 직접 갖지 않으므로 리프이거나 충분히 깊은 노드만 작업이 됨
+        if (Node.bIsLeaf || Node.Depth >= ParallelSplitDepth)
+        {
+            Tasks.Add({ NodeIndex, InsideMask });
+            NodeIndex = Node.SubtreeEnd;
+            continue;
+        }
+        MaskStack[Node.Depth] = InsideMask;
+        ++NodeIndex;
+    }
+
+    FJobSystem::ParallelFor(Tasks.Num(), [&](int32 TaskIndex)
+    {
+        const int32 ThreadIndex = FJobSystem::GetThreadIndex();
+        const FCullTask& Task = Tasks[TaskIndex];
+        FCullStats TaskStats;
+        CullSubtree(Frustum, Task.Node, Task.InsideMask, Cache, TaskStats, [&](UPrimitiveComponent* Comp) { Visitor(ThreadIndex, Comp); });
+        if (Cache)
+        {
+            Cache->AddStats(TaskStats);
+        }
+    });
+
+    if (Cache)
+    {
+        Cache->AddStats(CollectStats);
+    }
+}
+
+void FLinearOctree::QueryByRay(const FVector& PickPosition, const FVector& PickOrigin, TArray<UPrimitiveComponent*>& OutComps) const
+{
+    const uint32 NumNodes = Nodes.Num();
+    uint32 NodeIndex = 0;
+    while (NodeIndex < NumNodes)
+    {
+        const FLinearOctreeNode& Node = Nodes[NodeIndex];
+        if (!FOctreeNode::RayIntersectsBox(Node.Bounds, PickPosition, PickOrigin))
+        {
+            NodeIndex = Node.SubtreeEnd;
+            continue;
+        }
+
+        if (Node.bIsLeaf)
+        {
+            const uint32 ItemEnd = Node.ItemStart + Node.ItemCount;
+            for (uint32 i = Node.ItemStart; i < ItemEnd; ++i)
+            {
+                if (FOctreeNode::RayIntersectsBox(ItemBounds.Get(i), PickPosition, PickOrigin))
+                {
+                    OutComps.Add(Items[i]);
+                }
+            }
+        }
+        ++NodeIndex;
+    }
+}
+
+uint64 FLinearOctree::GetAllocatedSize() const
+{
+    return sizeof(FLinearOctree)
+        + static_cast<uint64>(Nodes.Len()) * sizeof(FLinearOctreeNode)
+        + static_cast<uint64>(NodeCullCache.Len()) * sizeof(FCullCacheEntry)
+        + static_cast<uint64>(Items.Len()) * sizeof(UPrimitiveComponent*)
+        + ItemBounds.GetAllocatedSize()
+        + static_cast<uint64>(ItemCodes.Len()) * sizeof(uint32);
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "Define.h"
+#include "FrustumCulling.h"
+
+class UPrimitiveComponent;
+struct Frustum;
+
+/**
+ * 포인터 없는 옥트리 노드.
+ * 노드들은 Morton 순서(전위 순회)로 한 배열에 연속해서 저장되고,
+ * 각 노드의 서브트리에 속한 아이템은 Items 배열에서 연속된 구간을 차지합니다.
+ */
+struct FLinearOctreeNode
+{
+    FBoundingBox Bounds;  // 서브트리의 아이템을 모두 감싸는 AABB
+    uint32 MortonCode;    // 셀의 Morton prefix (Depth * 3 비트)
+    uint32 SubtreeEnd;    // 이 노드의 서브트리 바로 다음 노드 인덱스. 컬링 시 서브트리를 건너뛸 때 사용
+    uint32 ItemStart;     // 서브트리 아이템 구간 시작
+    uint32 ItemCount;     // 서브트리 아이템 개수
+    uint8 Depth;
+    bool bIsLeaf;
+};
+
+/**
+ * FOctreeNode 대신 사용할 수 있는 선형 옥트리.
+ * 각 컴포넌트는 AABB 중심의 Morton 코드로 정렬되어 정확히 하나의 리프에 들어가므로
+ * 컬링 결과에 중복이 없습니다. 부분 갱신은 지원하지 않고, 바뀐 것이 있으면 통째로 다시 빌드합니다.
+ */
+class FLinearOctree
+{
+public:
+    FLinearOctree() = default;
+
+    /** Components를 Bounds 범위의 Morton 코드로 정렬해서 트리를 새로 만듭니다. */
+    void Build(const TArray<UPrimitiveComponent*>& Components, const FBoundingBox& InBounds);
+
+    void Empty();
+
+    /** 보이는 컴포넌트를 OutComponents에 모읍니다. OutStats가 있으면 평면 검사 횟수를 더합니다. */
+    void FrustumCull(const Frustum& Frustum, TArray<UPrimitiveComponent*>& OutComponents, FCullStats* OutStats = nullptr) const;
+
+    /**
+     * ParallelSplitDepth 깊이의 서브트리들을 잡 시스템의 워커에 나눠서 컬링하고, 보이는 컴포넌트마다 Visitor를 호출합니다.
+     * Cache가 있으면 노드 판정에 직전 컬링 결과를 재사용합니다. Cache->BeginCull은 호출하는 쪽에서 합니다.
+     */
+    void FrustumCullParallel(const Frustum& Frustum, const FCullVisitor& Visitor, FVisibilityCache* Cache = nullptr) const;
+
+    void QueryByRay(const FVector& PickPosition, const FVector& PickOrigin, TArray<UPrimitiveComponent*>& OutComps) const;
+
+    uint32 GetNumNodes() const { return Nodes.Num(); }
+    uint32 GetNumItems() const { return Items.Num(); }
+
+    /** 노드 배열과 아이템 버퍼가 차지하는 바이트 수 */
+    uint64 GetAllocatedSize() const;
+
+    /** 축마다 사용하는 Morton 비트 수. 최대 깊이이기도 합니다. */
+    static constexpr uint32 MortonBitsPerAxis = 10;
+    static constexpr uint32 MaxItemsPerLeaf = 32;
+
+    /** 리프 컬링 시 한 번에 커널에 넘기는 아이템 수 */
+    static constexpr uint32 CullBatchSize = 64;
+
+    /** 병렬 컬링 시 이 깊이의 노드 하나가 작업 하나가 됨 */
+    static constexpr uint32 ParallelSplitDepth = 2;
+
+private:
+    uint32 BuildNode(uint32 Start, uint32 End, uint32 Depth, uint32 Prefix);
+
+    /**
+     * 보인다고 판정된 Root의 서브트리를 순회하며 보이는 아이템마다 Func(Component)를 호출합니다.
+     * 부모가 완전히 안쪽에 있는 평면은 자식과 아이템에서 건너뛰고, 모든 평면 안쪽인 서브트리는 검사 없이 받아들입니다.
+     * @param RootInsideMask Root가 완전히 안쪽에 있는 평면 비트
+     */
+    template <typename FuncType>
+    void CullSubtree(const Frustum& Frustum, uint32 Root, uint8 RootInsideMask, const FVisibilityCache* Cache, FCullStats& Stats, const FuncType& Func) const;
+
+    /**
+     * Nodes[NodeIndex]의 Bounds가 Frustum과 겹치는지 판정합니다. Cache가 있으면 NodeCullCache를 재사용합니다.
+     * InOutInsideMask에 부모의 마스크를 넘기면 그 평면은 건너뛰고, 보이면 이 노드의 마스크로 바꿔 돌려줍니다.
+     */
+    bool IsNodeVisible(const Frustum& Frustum, uint32 NodeIndex, const FVisibilityCache* Cache, uint8& InOutInsideMask, FCullStats& Stats) const;
+
+    static uint32 EncodeMorton(uint32 X, uint32 Y, uint32 Z);
+
+    FBoundingBox Bounds;
+
+    TArray<FLinearOctreeNode> Nodes;
+
+    /** Morton 순서로 정렬된 컴포넌트. 리프는 이 배열의 구간을 가리킵니다. */
+    TArray<UPrimitiveComponent*> Items;
+
+    /** Items와 같은 순서의 월드 AABB. 컬링 중에 컴포넌트를 따라가지 않고 SIMD로 읽기 위해 SoA로 복사해 둡니다. */
+    FBoundsSoA ItemBounds;
+
+    /** Nodes와 같은 순서의 직전 컬링 판정. 노드 구조체를 작게 두려고 따로 저장하고, 빌드할 때마다 새로 만듭니다. */
+    mutable TArray<FCullCacheEntry> NodeCullCache;
+
+    /** 빌드 중에만 사용하는 Morton 코드 */
+    TArray<uint32> ItemCodes;
+};
@@ -1,19 +1,33 @@
 #include "OctreeNode.h"
 
+#include <bit>
 #include <filesystem>
 
 #include "UnrealEd/EditorViewportClient.h"
 #include "UObject/Casts.h"
 #include "Engine/Classes/Components/PrimitiveComponent.h"
 #include "Engine/Classes/Components/StaticMeshComponent.h"
-#include <thread>
+#include "Core/Async/JobSystem.h"
 
-FOctreeNode::FOctreeNode(FVector Min, FVector Max)
+FOctreeNode::FOctreeNode(FVector Min, FVector Max, bool bInLoose, FOctreeNode* InParent, int32 InDepth)
     : BoundBox(Min, Max)
+    , LooseBoundBox(Min, Max)
     , Components(TArray<UPrimitiveComponent*>())
     , Children(TArray<std::unique_ptr<FOctreeNode>>(8))
+    , Parent(InParent)
+    , Depth(InDepth)
     , bIsLeaf(true)
-{}
+    , bIsLoose(bInLoose)
+{
+    if (bIsLoose)
+    {
+        // 루트는 자식들의 느슨한 범위를 합친 만큼 넓힘. 자식 범위 중심이 Extent / 2만큼 떨어져 있으므로 (1 + LooseFactor) / 2배
+        // 자손의 느슨한 범위는 모두 이 안에 들어가고, 더 밖의 물체는 InsertLoose에서 그만큼 늘림
+        const FVector Center = BoundBox.GetCenter();
+        const FVector LooseExtent = BoundBox.GetExtent() * (Parent ? LooseFactor : (1.f + LooseFactor) * 0.5f);
+        LooseBoundBox = FBoundingBox(Center - LooseExtent, Center + LooseExtent);
+    }
+}
 
 void FOctreeNode::SubDivide()
 {
@@ -34,15 +48,29 @@ void FOctreeNode::SubDivide()
         FVector Min = ChildCenter - Half;
         FVector Max = ChildCenter + Half;
 
-        Children[i] = std::make_unique<FOctreeNode>(Min, Max);
+        Children[i] = std::make_unique<FOctreeNode>(Min, Max, bIsLoose, this, Depth + 1);
     }
     bIsLeaf = false;
 }
 
-void FOctreeNode::Insert(UPrimitiveComponent* Component, int32 Depth)
+int32 FOctreeNode::GetChildIndex(const FVector& Point) const
+{
+    const FVector Center = BoundBox.GetCenter();
+    return (Point.x >= Center.x ? 1 : 0) | (Point.y >= Center.y ? 2 : 0) | (Point.z >= Center.z ? 4 : 0);
+}
+
+void FOctreeNode::Insert(UPrimitiveComponent* Component)
 {
+    const FBoundingBox WorldBox = Component->GetWorldBoundingBox();
+
+    if (bIsLoose)
+    {
+        InsertLoose(Component, WorldBox);
+        return;
+    }
+
     // 경계 상자 교차 확인
-    if (!BoundBox.IntersectsAABB(Component->GetWorldBoundingBox()))
+    if (!BoundBox.IntersectsAABB(WorldBox))
     {
         return;
     }
@@ -52,109 +80,437 @@ void FOctreeNode::Insert(UPrimitiveComponent* Component, int32 Depth)
     {
         for (int32 i = 0; i < 8; ++i)
         {
-            if (Children[i]->BoundBox.IntersectsAABB(Component->GetWorldBoundingBox()))
+            if (Children[i]->BoundBox.IntersectsAABB(WorldBox))
             {
-                Children[i]->Insert(Component, Depth + 1);
+                Children[i]->Insert(Component);
             }
         }
         return;
     }
     
     // 리프 노드에 컴포넌트 추가
-    Components.Add(Component);
+    AddComponent(Component, WorldBox);
     
     // 분할 조건 확인
-    if (Components.Num() > 32 && Depth < 4)
+    if (Components.Num() > MaxComponentsPerLeaf && Depth < MaxDepth)
     {
         SubDivide();
         
         // 기존 컴포넌트를 적절한 자식 노드에만 재분배
         for (UPrimitiveComponent* Comp : Components)
         {
+            Comp->OctreeNodes.RemoveSingleSwap(this);
             for (int32 i = 0; i < 8; ++i)
             {
                 if (Children[i]->BoundBox.IntersectsAABB(Comp->GetWorldBoundingBox()))
                 {
-                    Children[i]->Insert(Comp, Depth + 1);
+                    Children[i]->Insert(Comp);
                 }
             }
         }
         
         // 리프 노드가 아니므로 컴포넌트 목록 비우기
         Components.Empty();
+        ComponentBounds.Empty();
     }
 }
 
-void FOctreeNode::FrustumCull(const Frustum& Frustum, TArray<UPrimitiveComponent*>& OutComponents)
+void FOctreeNode::InsertLoose(UPrimitiveComponent* Component, const FBoundingBox& WorldBox)
 {
-    if (!Frustum.Intersects(BoundBox))
+    // 중심이 속한 자식의 느슨한 범위에 완전히 들어가면 내려보내고, 아니면 이 노드가 가짐
+    if (!bIsLeaf)
     {
-        return;
+        FOctreeNode* Child = Children[GetChildIndex(WorldBox.GetCenter())].get();
+        if (Child->LooseBoundBox.ContainsAABB(WorldBox))
+        {
+            Child->InsertLoose(Component, WorldBox);
+            return;
+        }
     }
-    
-    if (bIsLeaf)
+
+    // 루트는 모든 물체를 받으므로 범위 밖 물체만큼 컬링 범위를 늘림
+    if (Parent == nullptr && !LooseBoundBox.ContainsAABB(WorldBox))
     {
-        for (UPrimitiveComponent* Comp : Components)
+        LooseBoundBox = LooseBoundBox.Union(WorldBox);
+        CullCache = FCullCacheEntry(); // 범위가 바뀌었으므로 직전 판정은 쓸 수 없음
+    }
+
+    AddComponent(Component, WorldBox);
+
+    if (bIsLeaf && Components.Num() > MaxComponentsPerLeaf && Depth < MaxDepth)
+    {
+        SubDivide();
+
+        // 자식에 들어가는 것만 내려보내고 나머지는 이 노드에 남김
+        TArray<UPrimitiveComponent*> Remaining;
+        FBoundsSoA RemainingBounds;
+        for (uint32 i = 0; i < Components.Num(); ++i)
         {
-            if (Frustum.Intersects(Comp->GetWorldBoundingBox()))
+            UPrimitiveComponent* Comp = Components[i];
+            const FBoundingBox CompBox = ComponentBounds.Get(i);
+            FOctreeNode* Child = Children[GetChildIndex(CompBox.GetCenter())].get();
+            if (Child->LooseBoundBox.ContainsAABB(CompBox))
             {
-                OutComponents.Add(Comp);
+                Comp->OctreeNodes.RemoveSingleSwap(this);
+                Child->InsertLoose(Comp, CompBox);
+            }
+            else
+            {
+                Remaining.Add(Comp);
+                RemainingBounds.Add(CompBox);
             }
         }
+        Components = std::move(Remaining);
+        ComponentBounds = std::move(RemainingBounds);
+    }
+}
+
+void FOctreeNode::Remove(UPrimitiveComponent* Component)
+{
+    if (Component->OctreeNodes.IsEmpty())
+    {
         return;
     }
-    
+
+    // 병합하면서 자식 노드가 사라질 수 있으므로 부모를 먼저 모아둠
+    TArray<FOctreeNode*> Parents;
+    for (FOctreeNode* Node : Component->OctreeNodes)
+    {
+        Node->RemoveComponent(Component);
+
+        // 느슨한 모드에서는 중간 노드에서 빠질 수도 있음. 그 노드 자체가 병합 후보
+        FOctreeNode* MergeCandidate = Node->bIsLeaf ? Node->Parent : Node;
+        if (MergeCandidate)
+        {
+            Parents.AddUnique(MergeCandidate);
+        }
+    }
+    Component->OctreeNodes.Empty();
+
+    // 깊은 노드부터 병합해야 이미 사라진 노드를 다시 건드리지 않음
+    while (!Parents.IsEmpty())
+    {
+        int32 DeepestIndex = 0;
+        for (int32 i = 1; i < Parents.Num(); ++i)
+        {
+            if (Parents[i]->Depth > Parents[DeepestIndex]->Depth)
+            {
+                DeepestIndex = i;
+            }
+        }
+        FOctreeNode* Node = Parents[DeepestIndex];
+        Parents.RemoveAtSwap(DeepestIndex);
+
+        if (Node->TryMerge() && Node->Parent)
+        {
+            Parents.AddUnique(Node->Parent);
+        }
+    }
+}
+
+void FOctreeNode::Update(UPrimitiveComponent* Component)
+{
+    const FBoundingBox WorldBox = Component->GetWorldBoundingBox();
+
+    // 노드 하나에 완전히 들어가 있고 더 내려갈 자식이 없으면 위치를 옮길 필요가 없음
+    if (Component->OctreeNodes.Num() == 1)
+    {
+        FOctreeNode* Node = Component->OctreeNodes[0];
+        if (Node->LooseBoundBox.ContainsAABB(WorldBox) &&
+            (Node->bIsLeaf || !Node->Children[Node->GetChildIndex(WorldBox.GetCenter())]->LooseBoundBox.ContainsAABB(WorldBox)))
+        {
+            // 컬링에 쓰는 AABB만 갱신
+            Node->ComponentBounds.Set(Node->Components.Find(Component), WorldBox);
+            return;
+        }
+    }
+
+    Remove(Component);
+    Insert(Component);
+}
+
+bool FOctreeNode::TryMerge()
+{
+    if (bIsLeaf) return false;
+
+    int32 Total = Components.Num();
     for (int32 i = 0; i < 8; ++i)
     {
-        if (Children[i])
+        if (!Children[i]->bIsLeaf)
+        {
+            return false;
+        }
+        Total += Children[i]->Components.Num();
+    }
+
+    // 분할 기준보다 여유를 둬서 경계에서 분할/병합이 반복되지 않게 함
+    if (Total > MaxComponentsPerLeaf / 2)
+    {
+        return false;
+    }
+
+    for (int32 i = 0; i < 8; ++i)
+    {
+        FOctreeNode* Child = Children[i].get();
+        for (uint32 j = 0; j < Child->Components.Num(); ++j)
         {
-            Children[i]->FrustumCull(Frustum, OutComponents);
+            UPrimitiveComponent* Comp = Child->Components[j];
+            Comp->OctreeNodes.RemoveSingleSwap(Child);
+            if (!Components.Contains(Comp))
+            {
+                AddComponent(Comp, Child->ComponentBounds.Get(j));
+            }
         }
+        Children[i].reset();
+    }
+    bIsLeaf = true;
+    return true;
+}
+
+void FOctreeNode::FrustumCull(const Frustum& Frustum, TArray<UPrimitiveComponent*>& OutComponents, FCullStats* OutStats) const
+{
+    FCullStats Stats;
+    uint8 InsideMask = 0;
+    if (IsNodeVisible(Frustum, nullptr, InsideMask, Stats))
+    {
+        VisitVisible(Frustum, InsideMask, nullptr, Stats, [&](UPrimitiveComponent* Comp) { OutComponents.Add(Comp); });
+    }
+
+    if (OutStats)
+    {
+        OutStats->PlaneTests += Stats.PlaneTests;
+        OutStats->PlaneTestsSkipped += Stats.PlaneTestsSkipped;
     }
 }
 
 // 물체가 너무 적음.
 void FOctreeNode::FrustumCullThreaded(const Frustum& Frustum, TArray<UPrimitiveComponent*>& OutComponents)
 {
-    if (!Frustum.Intersects(BoundBox))
+    FCullStats Stats;
+    uint8 InsideMask = 0;
+    if (!IsNodeVisible(Frustum, nullptr, InsideMask, Stats))
     {
         return;
     }
     
+    CullComponents(Frustum, InsideMask, Stats, [&](UPrimitiveComponent* Comp) { OutComponents.Add(Comp); });
+
     if (bIsLeaf)
+    {
+        return;
+    }
+    TArray<UPrimitiveComponent*> OutComponentsThreaded[8];
+    FJobSystem::ParallelFor(8, [&](int32 i)
+    {
+        FCullStats ChildStats;
+        uint8 ChildMask = InsideMask;
+        if (Children[i] && Children[i]->IsNodeVisible(Frustum, nullptr, ChildMask, ChildStats))
+        {
+            Children[i]->VisitVisible(Frustum, ChildMask, nullptr, ChildStats, [&](UPrimitiveComponent* Comp) { OutComponentsThreaded[i].Add(Comp); });
+        }
+    });
+
+    for (int32 i = 0; i < 8; ++i)
+    {
+        OutComponents += OutComponentsThreaded[i];
+    }
+
+}
+
+void FOctreeNode::AddComponent(UPrimitiveComponent* Component, const FBoundingBox& WorldBox)
+{
+    Components.Add(Component);
+    ComponentBounds.Add(WorldBox);
+    Component->OctreeNodes.Add(this);
+}
+
+void FOctreeNode::RemoveComponent(UPrimitiveComponent* Component)
+{
+    int32 Index;
+    if (!Components.Find(Component, Index))
+    {
+        return;
+    }
+
+    // 두 배열이 같은 순서를 유지하도록 둘 다 마지막 원소와 바꿔서 제거
+    Components.RemoveAtSwap(Index);
+    ComponentBounds.RemoveAtSwap(Index);
+}
+
+template <typename FuncType>
+void FOctreeNode::CullComponents(const Frustum& Frustum, uint8 InsideMask, FCullStats& Stats, const FuncType& Func) const
+{
+    const uint32 NumComponents = Components.Num();
+    const uint32 NumSkipped = std::popcount(static_cast<uint32>(InsideMask));
+    Stats.PlaneTestsSkipped += NumComponents * NumSkipped;
+
+    if (InsideMask == FFrustumCulling::AllPlanesMask)
     {
         for (UPrimitiveComponent* Comp : Components)
         {
-            if (Frustum.Intersects(Comp->GetWorldBoundingBox()))
-            {
-                OutComponents.Add(Comp);
-            }
+            Func(Comp);
         }
         return;
     }
-    TArray<std::thread> threads;
-    TArray<UPrimitiveComponent*> OutComponentsThreaded[8];
+    Stats.PlaneTests += NumComponents * (6 - NumSkipped);
+
+    uint32 VisibleIndices[CullBatchSize];
+    for (uint32 BatchStart = 0; BatchStart < NumComponents; BatchStart += CullBatchSize)
+    {
+        const uint32 BatchCount = FMath::Min(CullBatchSize, NumComponents - BatchStart);
+        const uint32 NumVisible = FFrustumCulling::CullBoxes(Frustum, ComponentBounds, BatchStart, BatchCount, VisibleIndices, InsideMask);
+        for (uint32 i = 0; i < NumVisible; ++i)
+        {
+            Func(Components[VisibleIndices[i]]);
+        }
+    }
+}
+
+void FOctreeNode::FrustumCullParallel(const Frustum& Frustum, const FCullVisitor& Visitor, FVisibilityCache* Cache) const
+{
+    TFrameArray<FCullTask> Tasks;
+    FCullStats CollectStats;
+    CollectCullTasks(Frustum, Cache, 0, CollectStats, Tasks);
+
+    FJobSystem::ParallelFor(Tasks.Num(), [&](int32 TaskIndex)
+    {
+        const int32 ThreadIndex = FJobSystem::GetThreadIndex();
+        const FCullTask& Task = Tasks[TaskIndex];
+        const auto Visit = [&](UPrimitiveComponent* Comp) { Visitor(ThreadIndex, Comp); };
+
+        FCullStats TaskStats;
+        if (Task.bRecursive)
+        {
+            Task.Node->VisitVisible(Frustum, Task.InsideMask, Cache, TaskStats, Visit);
+        }
+        else
+        {
+            Task.Node->CullComponents(Frustum, Task.InsideMask, TaskStats, Visit);
+        }
+
+        if (Cache)
+        {
+            Cache->AddStats(TaskStats);
+        }
+    });
+
+    if (Cache)
+    {
+        Cache->AddStats(CollectStats);
+    }
+}
+
+bool FOctreeNode::IsNodeVisible(const Frustum& Frustum, const FVisibilityCache* Cache, uint8& InOutInsideMask, FCullStats& Stats) const
+{
+    // 부모가 모든 평면 안쪽이면 자식도 그렇다
+    if (InOutInsideMask == FFrustumCulling::AllPlanesMask)
+    {
+        Stats.PlaneTestsSkipped += 6;
+        return true;
+    }
+
+    if (Cache)
+    {
+        // 캐시의 마스크는 부모와 상관없이 6개 평면 모두로 구한 것
+        if (!Cache->Classify(Frustum, LooseBoundBox, CullCache, Stats))
+        {
+            return false;
+        }
+        InOutInsideMask |= CullCache.InsideMask;
+        return true;
+    }
+
+    return FFrustumCulling::IntersectsMasked(Frustum, LooseBoundBox, InOutInsideMask, Stats);
+}
+
+void FOctreeNode::CollectCullTasks(const Frustum& Frustum, const FVisibilityCache* Cache, uint8 ParentInsideMask, FCullStats& Stats, TFrameArray<FCullTask>& OutTasks) const
+{
+    uint8 InsideMask = ParentInsideMask;
+    if (!IsNodeVisible(Frustum, Cache, InsideMask, Stats))
+    {
+        return;
+    }
+
+    if (bIsLeaf || Depth >= ParallelSplitDepth)
+    {
+        OutTasks.Add({ this, InsideMask, true });
+        return;
+    }
+
+    // 위쪽 노드가 가진 컴포넌트는 따로 작업으로 만들고 자식으로 내려감
+    if (!Components.IsEmpty())
+    {
+        OutTasks.Add({ this, InsideMask, false });
+    }
     for (int32 i = 0; i < 8; ++i)
     {
         if (Children[i])
         {
-            threads.Add(std::thread(&FOctreeNode::FrustumCull, Children[i].get(), std::ref(Frustum), std::ref(OutComponentsThreaded[i])));
+            Children[i]->CollectCullTasks(Frustum, Cache, InsideMask, Stats, OutTasks);
         }
     }
+}
 
-    for (auto& thread : threads)
+template <typename FuncType>
+void FOctreeNode::VisitVisible(const Frustum& Frustum, uint8 InsideMask, const FVisibilityCache* Cache, FCullStats& Stats, const FuncType& Func) const
+{
+    if (InsideMask == FFrustumCulling::AllPlanesMask)
     {
-        thread.join();
+        AcceptSubtree(Stats, Func);
+        return;
+    }
+
+    // 일반 모드에서는 리프만, 느슨한 모드에서는 중간 노드도 컴포넌트를 가짐
+    CullComponents(Frustum, InsideMask, Stats, Func);
+
+    if (bIsLeaf)
+    {
+        return;
     }
 
     for (int32 i = 0; i < 8; ++i)
     {
-        OutComponents += OutComponentsThreaded[i];
+        if (Children[i])
+        {
+            uint8 ChildMask = InsideMask;
+            if (Children[i]->IsNodeVisible(Frustum, Cache, ChildMask, Stats))
+            {
+                Children[i]->VisitVisible(Frustum, ChildMask, Cache, Stats, Func);
+            }
+        }
+    }
+}
+
+template <typename FuncType>
+void FOctreeNode::AcceptSubtree(FCullStats& Stats, const FuncType& Func) const
+{
+    Stats.PlaneTestsSkipped += Components.Num() * 6;
+    for (UPrimitiveComponent* Comp : Components)
+    {
+        Func(Comp);
+    }
+
+    if (bIsLeaf)
+    {
+        return;
     }
 
+    for (int32 i = 0; i < 8; ++i)
+    {
+        if (Children[i])
+        {
+            Stats.PlaneTestsSkipped += 6;
+            Children[i]->AcceptSubtree(Stats, Func);
+        }
+    }
 }
 
 bool FOctreeNode::RayIntersectsOctree(const FVector& PickPosition, const FVector& PickOrigin) const
+{
+    return RayIntersectsBox(LooseBoundBox, PickPosition, PickOrigin);
+}
+
+bool FOctreeNode::RayIntersectsBox(const FBoundingBox& Box, const FVector& PickPosition, const FVector& PickOrigin)
 {
     float tmin = -FLT_MAX;
     float tmax = FLT_MAX;
@@ -167,8 +523,8 @@ bool FOctreeNode::RayIntersectsOctree(const FVector& PickPosition, const FVector
     if (RayDir.x != 0.f)
     {
         invD = 1.0f / RayDir.x;
-        t0 = (BoundBox.min.x - PickOrigin.x) * invD;
-        t1 = (BoundBox.max.x - PickOrigin.x) * invD;
+        t0 = (Box.min.x - PickOrigin.x) * invD;
+        t1 = (Box.max.x - PickOrigin.x) * invD;
         if (invD < 0.0f)
         {
             std::swap(t0, t1);
@@ -184,8 +540,8 @@ bool FOctreeNode::RayIntersectsOctree(const FVector& PickPosition, const FVector
     if (RayDir.y != 0.f)
     {
         invD = 1.0f / RayDir.y;
-        t0 = (BoundBox.min.y - PickOrigin.y) * invD;
-        t1 = (BoundBox.max.y - PickOrigin.y) * invD;
+        t0 = (Box.min.y - PickOrigin.y) * invD;
+        t1 = (Box.max.y - PickOrigin.y) * invD;
         if (invD < 0.0f)
         {
             std::swap(t0, t1);
@@ -201,8 +557,8 @@ bool FOctreeNode::RayIntersectsOctree(const FVector& PickPosition, const FVector
     if (RayDir.z != 0.f)
     {
         invD = 1.0f / RayDir.z;
-        t0 = (BoundBox.min.z - PickOrigin.z) * invD;
-        t1 = (BoundBox.max.z - PickOrigin.z) * invD;
+        t0 = (Box.min.z - PickOrigin.z) * invD;
+        t1 = (Box.max.z - PickOrigin.z) * invD;
         if (invD < 0.0f)
         {
             std::swap(t0, t1);
@@ -222,14 +578,11 @@ void FOctreeNode::QueryByRay(const FVector& PickPosition, const FVector& PickOri
 {
     if (!RayIntersectsOctree(PickPosition, PickOrigin))
         return;
-    if (bIsLeaf)
+    for (UPrimitiveComponent* Comp : Components)
     {
-        for (UPrimitiveComponent* Comp : Components)
-        {
-            OutComps.Add(Comp);
-        }
+        OutComps.Add(Comp);
     }
-    else
+    if (!bIsLeaf)
     {
         for (int i = 0; i < 8; ++i)
         {
@@ -256,3 +609,73 @@ uint32 FOctreeNode::CountAllComponents() const
     }
     return Count;
 }
+
+uint32 FOctreeNode::ValidateOctree() const
+{
+    // 일반 모드는 경계에 걸친 물체가 범위를 넘는 것이 정상이므로 검사하지 않음
+    if (!bIsLoose)
+    {
+        return 0;
+    }
+
+    // 루트의 느슨한 범위가 모든 컴포넌트를 감싸야 컬링과 피킹에서 루트 판정으로 잘못 걸러내지 않음
+    const FOctreeNode* Root = this;
+    while (Root->Parent)
+    {
+        Root = Root->Parent;
+    }
+
+    uint32 NumErrors = 0;
+    for (uint32 i = 0; i < Components.Num(); ++i)
+    {
+        const FBoundingBox CompBox = ComponentBounds.Get(i);
+        if (!Root->LooseBoundBox.ContainsAABB(CompBox) || !LooseBoundBox.ContainsAABB(CompBox))
+        {
+            ++NumErrors;
+        }
+    }
+
+    if (!bIsLeaf)
+    {
+        for (int32 i = 0; i < 8; ++i)
+        {
+            NumErrors += Children[i]->ValidateOctree();
+        }
+    }
+    return NumErrors;
+}
+
+uint32 FOctreeNode::CountAllNodes() const
+{
+    uint32 Count = 1;
+    if (!bIsLeaf)
+    {
+        for (int32 i = 0; i < 8; ++i)
+        {
+            if (Children[i])
+            {
+                Count += Children[i]->CountAllNodes();
+            }
+        }
+    }
+    return Count;
+}
+
+uint64 FOctreeNode::GetAllocatedSize() const
+{
+    uint64 Size = sizeof(FOctreeNode)
+        + static_cast<uint64>(Components.Len()) * sizeof(UPrimitiveComponent*)
+        + ComponentBounds.GetAllocatedSize()
+        + static_cast<uint64>(Children.Len()) * sizeof(std::unique_ptr<FOctreeNode>);
+    if (!bIsLeaf)
+    {
+        for (int32 i = 0; i < 8; ++i)
+        {
+            if (Children[i])
+            {
+                Size += Children[i]->GetAllocatedSize();
+            }
+        }
+    }
+    return Size;
+}
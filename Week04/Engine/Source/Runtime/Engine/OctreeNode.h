@@ -1,32 +1,146 @@
 #pragma once
 #include "Define.h"
+#include "FrustumCulling.h"
 
 class UPrimitiveComponent;
 struct Frustum;
 
+/**
+ * 옥트리 노드. 두 가지 모드가 있습니다.
+ * - 일반: 물체를 겹치는 모든 리프에 넣음. 경계에 걸친 물체는 여러 리프에 중복으로 들어감
+ * - 느슨한(Loose): 자식 범위를 LooseFactor 배로 넓혀서, 물체를 중심이 속한 자식 하나에만 넣음.
+ *   자식에 다 들어가지 않으면 현재 노드가 가지므로 중간 노드도 컴포넌트를 가질 수 있고, 컬링 결과에 중복이 없음
+ */
 struct FOctreeNode
 {
-    FOctreeNode(FVector Min, FVector Max);
+    FOctreeNode(FVector Min, FVector Max, bool bInLoose = false, FOctreeNode* InParent = nullptr, int32 InDepth = 0);
 
     void SubDivide();
 
-    void Insert(UPrimitiveComponent* Component, int32 Depth = 0);
+    void Insert(UPrimitiveComponent* Component);
 
-    void FrustumCull(const Frustum& Frustum, TArray<UPrimitiveComponent*>& OutComponents);
+    /** Point가 속하는 자식 인덱스 (x = 1, y = 2, z = 4) */
+    int32 GetChildIndex(const FVector& Point) const;
+
+    /** Component가 들어있는 노드(Component->OctreeNodes)에서만 제거합니다. 트리 전체를 순회하지 않습니다. */
+    void Remove(UPrimitiveComponent* Component);
+
+    /**
+     * Component의 월드 AABB가 바뀐 뒤 호출합니다.
+     * 기존 리프 안에 그대로 들어가면 아무것도 하지 않고, 아니면 루트에서 다시 삽입합니다.
+     * 루트 노드에서 호출해야 합니다.
+     */
+    void Update(UPrimitiveComponent* Component);
+
+    /**
+     * 자식들이 모두 리프이고 합친 개수가 충분히 작으면 자식을 없애고 다시 리프가 됩니다.
+     * @return 병합되었으면 true
+     */
+    bool TryMerge();
+
+    /**
+     * 보이는 컴포넌트를 OutComponents에 모읍니다.
+     * 부모가 완전히 안쪽에 있는 평면은 자식과 컴포넌트에서 다시 검사하지 않고, OutStats가 있으면 검사 횟수를 더합니다.
+     */
+    void FrustumCull(const Frustum& Frustum, TArray<UPrimitiveComponent*>& OutComponents, FCullStats* OutStats = nullptr) const;
 
     void FrustumCullThreaded(const Frustum& Frustum, TArray<UPrimitiveComponent*>& OutComponents);
 
+    /**
+     * ParallelSplitDepth 깊이의 서브트리들을 잡 시스템의 워커에 나눠서 컬링하고,
+     * 보이는 컴포넌트마다 Visitor를 호출합니다. 끝날 때까지 기다립니다.
+     * Cache가 있으면 노드 판정에 직전 컬링 결과를 재사용합니다. Cache->BeginCull은 호출하는 쪽에서 합니다.
+     */
+    void FrustumCullParallel(const Frustum& Frustum, const FCullVisitor& Visitor, FVisibilityCache* Cache = nullptr) const;
+
     bool RayIntersectsOctree(const FVector& PickPosition, const FVector& PickOrigin) const;
 
+    /** PickOrigin에서 PickPosition 방향의 직선이 Box와 만나는지 검사합니다. */
+    static bool RayIntersectsBox(const FBoundingBox& Box, const FVector& PickPosition, const FVector& PickOrigin);
+
     void QueryByRay(const FVector& PickPosition, const FVector& PickOrigin, TArray<UPrimitiveComponent*>& OutComps);
 
     uint32 CountAllComponents() const;
 
+    /**
+     * 느슨한 모드의 서브트리에서 루트나 자기 노드의 LooseBoundBox 밖에 있는 컴포넌트 수를 셉니다. 0이어야 정상
+     * 일반 모드는 경계에 걸친 물체가 범위를 넘으므로 항상 0
+     */
+    uint32 ValidateOctree() const;
+
+    uint32 CountAllNodes() const;
+
+    /** 서브트리의 노드와 컴포넌트 배열이 차지하는 바이트 수 */
+    uint64 GetAllocatedSize() const;
+
     FBoundingBox BoundBox; //현재 노드의 공간 범위
+
+    FBoundingBox LooseBoundBox; // 컬링에 쓰는 범위. 느슨한 모드에서는 BoundBox를 넓힌 것, 일반 모드에서는 BoundBox와 같음
     
     TArray<UPrimitiveComponent*> Components; //현재 노드에 포함된 물체 리스트
+
+    FBoundsSoA ComponentBounds; // Components와 같은 순서의 월드 AABB. SIMD 컬링용
     
     TArray<std::unique_ptr<FOctreeNode>> Children; //자식 옥트리
     
+    FOctreeNode* Parent; // 루트면 nullptr
+
+    int32 Depth;
+
     bool bIsLeaf;
+
+    bool bIsLoose;
+
+    /** 직전 컬링에서 LooseBoundBox를 판정한 결과. 병렬 컬링 중 이 노드를 맡은 스레드만 갱신 */
+    mutable FCullCacheEntry CullCache;
+
+    static constexpr int32 MaxComponentsPerLeaf = 32;
+    static constexpr int32 MaxDepth = 4;
+
+    /** 느슨한 모드에서 자식 범위를 몇 배로 넓힐지 */
+    static constexpr float LooseFactor = 2.0f;
+
+    /** 컴포넌트 컬링 시 한 번에 커널에 넘기는 개수 */
+    static constexpr uint32 CullBatchSize = 64;
+
+    /** 병렬 컬링 시 이 깊이의 노드 하나가 작업 하나가 됨 (최대 8^2 = 64개) */
+    static constexpr int32 ParallelSplitDepth = 2;
+
+private:
+    /** Components와 ComponentBounds, 역참조(OctreeNodes)를 함께 갱신합니다. */
+    void AddComponent(UPrimitiveComponent* Component, const FBoundingBox& WorldBox);
+    void RemoveComponent(UPrimitiveComponent* Component);
+
+    /**
+     * Components 중 Frustum과 겹치는 것마다 Func(Component)를 호출합니다.
+     * InsideMask는 이 노드가 완전히 안쪽에 있는 평면 비트입니다. 컴포넌트는 노드 범위와 겹치므로 그 평면에서는 항상 통과하고,
+     * 검사를 건너뜁니다. 모든 평면이 켜져 있으면 검사 없이 전부 받아들입니다.
+     */
+    template <typename FuncType>
+    void CullComponents(const Frustum& Frustum, uint8 InsideMask, FCullStats& Stats, const FuncType& Func) const;
+
+    struct FCullTask
+    {
+        const FOctreeNode* Node;
+        uint8 InsideMask; // Node를 판정한 뒤의 평면 마스크
+        bool bRecursive; // false면 이 노드의 컴포넌트만, true면 서브트리 전체
+    };
+
+    /**
+     * LooseBoundBox가 Frustum과 겹치는지 판정합니다. Cache가 있으면 CullCache를 재사용합니다.
+     * InOutInsideMask에 부모의 마스크를 넘기면 그 평면은 건너뛰고, 보이면 이 노드의 마스크로 바꿔 돌려줍니다.
+     */
+    bool IsNodeVisible(const Frustum& Frustum, const FVisibilityCache* Cache, uint8& InOutInsideMask, FCullStats& Stats) const;
+
+    void CollectCullTasks(const Frustum& Frustum, const FVisibilityCache* Cache, uint8 ParentInsideMask, FCullStats& Stats, TFrameArray<FCullTask>& OutTasks) const;
+
+    /** 보인다고 판정된 이 노드의 서브트리를 내려가면서 보이는 컴포넌트마다 Func(Component)를 호출합니다. */
+    template <typename FuncType>
+    void VisitVisible(const Frustum& Frustum, uint8 InsideMask, const FVisibilityCache* Cache, FCullStats& Stats, const FuncType& Func) const;
+
+    /** 모든 평면 안쪽에 있는 서브트리의 컴포넌트를 검사 없이 Func에 넘깁니다. */
+    template <typename FuncType>
+    void AcceptSubtree(FCullStats& Stats, const FuncType& Func) const;
+
+    void InsertLoose(UPrimitiveComponent* Component, const FBoundingBox& WorldBox);
 };
\ No newline at end of file
@@ -1,11 +1,22 @@
 #include "Console.h"
 #include <cstdarg>
 #include <cstdio>
+#include <cstdlib>
 
 #include "UnrealEd/EditorViewportClient.h"
 
 #include "World.h"
 #include "Actors/Player.h"
+#include "LevelEditor/SLevelEditor.h"
+#include "FrustumCulling.h"
+#include "Engine/FLoaderOBJ.h"
+#include "Engine/DerivedDataCache.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectIterator.h"
+#include "BaseGizmos/GizmoBaseComponent.h"
+#include "Components/UBillboardComponent.h"
+#include "Components/UParticleSubUVComp.h"
+#include "Components/UText.h"
 
 // 싱글톤 인스턴스 반환
 Console& Console::GetInstance() {
@@ -63,6 +74,27 @@ void StatOverlay::Render(ID3D11DeviceContext* context, UINT width, UINT height)
             ImGui::Text("Allocated Object Memory: %llu B", FPlatformMemory::GetAllocationBytes<EAT_Object>());
             ImGui::Text("Allocated Container Count: %llu", FPlatformMemory::GetAllocationCount<EAT_Container>());
             ImGui::Text("Allocated Container memory: %llu B", FPlatformMemory::GetAllocationBytes<EAT_Container>());
+            ImGui::Text("Frame Allocator Used / Reserved: %llu B / %llu B", FFrameAllocator::GetLastFrameBytes(), FFrameAllocator::GetReservedBytes());
+        }
+
+        if (showCulling)
+        {
+            const FVisibilityCache& VisibilityCache = GEngineLoop.GetWorld()->GetVisibilityCache();
+            const FCullStats LastStats = VisibilityCache.GetLastStats();
+            const uint32 LastTotal = LastStats.Hits + LastStats.Misses;
+            ImGui::Text("Visibility Cache: last cull %u / %u nodes reused (%.1f%%), total hit rate %.1f%%",
+                        LastStats.Hits, LastTotal, LastTotal > 0 ? 100.0 * LastStats.Hits / LastTotal : 0.0,
+                        100.0 * VisibilityCache.GetTotalHitRate());
+            ImGui::Text("Plane Tests: %u tested, %u skipped by parent plane masks", LastStats.PlaneTests, LastStats.PlaneTestsSkipped);
+        }
+
+        if (showLOD)
+        {
+            const FRenderer::FLODStats LODStats = FEngineLoop::Renderer.GetLastLODStats();
+            for (int LOD = 0; LOD < IM_ARRAYSIZE(LODStats.Meshes); ++LOD)
+            {
+                ImGui::Text("LOD%d: %u meshes, %llu triangles", LOD, LODStats.Meshes[LOD], LODStats.Triangles[LOD]);
+            }
         }
         ImGui::PopStyleColor();
         ImGui::End();
@@ -215,11 +247,87 @@ void Console::ExecuteCommand(const std::string& command)
         AddLog(LogLevel::Display, " - help: Shows available commands");
         AddLog(LogLevel::Display, " - stat fps: Toggle FPS display");
         AddLog(LogLevel::Display, " - stat memory: Toggle Memory display");
+        AddLog(LogLevel::Display, " - stat culling: Show visibility cache and plane test counts");
+        AddLog(LogLevel::Display, " - stat lod: Show meshes and triangles drawn per LOD");
         AddLog(LogLevel::Display, " - stat none: Hide all stat overlays");
+        AddLog(LogLevel::Display, " - octree [pointer|linear]: Switch the octree used for culling and picking (shows the current one if omitted)");
+        AddLog(LogLevel::Display, " - bench octree: Compare pointer and linear octree");
+        AddLog(LogLevel::Display, " - bench cull: Compare scalar and SIMD frustum culling kernels");
+        AddLog(LogLevel::Display, " - bench obj [path]: Compare OBJ parsers (generates a grid OBJ if no path)");
+        AddLog(LogLevel::Display, " - bench weld [path]: Compare hashed and string-keyed vertex welding (default apple_mid.obj)");
+        AddLog(LogLevel::Display, " - bench vertex [path]: Compare full and compact vertex size and error (default apple_mid.obj)");
+        AddLog(LogLevel::Display, " - bench vcache [path]: Show vertex cache ACMR/ATVR before and after mesh optimization (default apple_mid.obj)");
+        AddLog(LogLevel::Display, " - bench lod [path]: Generate simplified LODs and show triangle counts and errors (default apple_mid.obj)");
+        AddLog(LogLevel::Display, " - bench alloc: Compare heap and pooled allocation of static mesh component sized blocks");
+        AddLog(LogLevel::Display, " - bench objects [count]: Time adding, iterating and removing objects (default 1000000)");
+        AddLog(LogLevel::Display, " - bench cast: Compare super chain and interval IsChildOf over the render prep casts of all primitives");
+        AddLog(LogLevel::Display, " - ddc: Show derived data cache size and hit/miss per asset type");
+        AddLog(LogLevel::Display, " - test bvh: Validate mesh BVH picking against brute force");
+        AddLog(LogLevel::Display, " - test octree: Check that every octree component lies inside the loose bounds");
     }
     else if (command.rfind("stat ", 0) == 0) { // stat 명령어 처리
         overlay.ToggleStat(command);
     }
+    else if (command == "octree pointer") {
+        GEngineLoop.GetWorld()->SetOctreeType(EOctreeType::Pointer);
+        AddLog(LogLevel::Display, "Octree: pointer");
+    }
+    else if (command == "octree linear") {
+        GEngineLoop.GetWorld()->SetOctreeType(EOctreeType::Linear);
+        AddLog(LogLevel::Display, "Octree: linear");
+    }
+    else if (command == "octree") {
+        AddLog(LogLevel::Display, "Octree: %s", GEngineLoop.GetWorld()->GetOctreeType() == EOctreeType::Linear ? "linear" : "pointer");
+    }
+    else if (command == "bench octree") {
+        GEngineLoop.GetWorld()->BenchmarkOctrees(GEngineLoop.GetLevelEditor()->GetActiveViewportClient()->GetFrustum());
+    }
+    else if (command == "bench cull") {
+        FFrustumCulling::RunBenchmark(GEngineLoop.GetLevelEditor()->GetActiveViewportClient()->GetFrustum());
+    }
+    else if (command == "bench obj" || command.rfind("bench obj ", 0) == 0) {
+        FLoaderOBJ::BenchmarkParseOBJ(command.size() > 10 ? FString(command.substr(10)) : FString());
+    }
+    else if (command == "bench weld" || command.rfind("bench weld ", 0) == 0) {
+        FLoaderOBJ::BenchmarkConvertToStaticMesh(command.size() > 11 ? FString(command.substr(11)) : FString());
+    }
+    else if (command == "bench vertex" || command.rfind("bench vertex ", 0) == 0) {
+        FLoaderOBJ::BenchmarkVertexCompression(command.size() > 13 ? FString(command.substr(13)) : FString());
+    }
+    else if (command == "bench vcache" || command.rfind("bench vcache ", 0) == 0) {
+        FLoaderOBJ::BenchmarkMeshOptimization(command.size() > 13 ? FString(command.substr(13)) : FString());
+    }
+    else if (command == "bench lod" || command.rfind("bench lod ", 0) == 0) {
+        FLoaderOBJ::BenchmarkLODGeneration(command.size() > 10 ? FString(command.substr(10)) : FString());
+    }
+    else if (command == "bench alloc") {
+        FObjectPool::RunBenchmark(UStaticMeshComponent::StaticClass()->GetClassSize());
+    }
+    else if (command == "bench cast") {
+        // FRenderer가 컴포넌트마다 하는 Cast의 대상 클래스
+        TArray<UObject*> Primitives;
+        for (UPrimitiveComponent* Primitive : TObjectRange<UPrimitiveComponent>())
+        {
+            Primitives.Add(Primitive);
+        }
+        const TArray<UClass*> Classes = {
+            UStaticMeshComponent::StaticClass(), UGizmoBaseComponent::StaticClass(), UBillboardComponent::StaticClass(),
+            UParticleSubUVComp::StaticClass(), UText::StaticClass()
+        };
+        UClass::RunCastBenchmark(Primitives, Classes);
+    }
+    else if (command == "bench objects" || command.rfind("bench objects ", 0) == 0) {
+        BenchmarkObjectIteration(command.size() > 14 ? static_cast<uint32>(std::strtoul(command.c_str() + 14, nullptr, 10)) : 1000000);
+    }
+    else if (command == "ddc") {
+        FDerivedDataCache::LogReport();
+    }
+    else if (command == "test bvh") {
+        GEngineLoop.GetWorld()->ValidateMeshBVH();
+    }
+    else if (command == "test octree") {
+        GEngineLoop.GetWorld()->ValidateOctree();
+    }
     else {
         AddLog(LogLevel::Error, "Unknown command: %s", command.c_str());
     }
@@ -9,13 +9,19 @@ class StatOverlay {
 public:
     bool showFPS = true;
     bool showMemory = false;
+    bool showCulling = false;
+    bool showLOD = false;
     bool showRender = true;
     void ToggleStat(const std::string& command) {
         if (command == "stat fps") {showFPS = true; showRender = true;}
         else if (command == "stat memory") {showMemory = true; showRender = true;}
+        else if (command == "stat culling") {showCulling = true; showRender = true;}
+        else if (command == "stat lod") {showLOD = true; showRender = true;}
         else if (command == "stat none") {
             showFPS = false;
             showMemory = false;
+            showCulling = false;
+            showLOD = false;
             showRender = false;
         }
     }
@@ -10,12 +10,28 @@
 #include "Engine/StaticMeshActor.h"
 #include "Math/JungleMath.h"
 #include "UnrealEd/EditorViewportClient.h"
+#include "BaseGizmos/GizmoBaseComponent.h"
 #include <UObject/UObjectIterator.h>
 #include "OctreeNode.h"
+#include "LinearOctree.h"
+#include "FWindowsPlatformTime.h"
 
+#include <random>
 
-void UWorld::Initialize(HWND hWnd)
+namespace
 {
+    const FBoundingBox WorldOctreeBounds(FVector(-100, -100, -100), FVector(100, 100, 100));
+}
+
+UWorld::UWorld() = default;
+
+UWorld::~UWorld() = default;
+
+
+void UWorld::Initialize(HWND hWnd, EOctreeType InOctreeType)
+{
+    OctreeType = InOctreeType;
+
     CreateBaseObject(hWnd);
 
 #ifdef _DEBUG
@@ -45,21 +61,17 @@ void UWorld::Initialize(HWND hWnd)
     }
 #endif
     
-    if (RootOctree == nullptr)
+    if (OctreeType == EOctreeType::Linear)
     {
-        RootOctree = std::make_unique<FOctreeNode>(FVector(-100, -100, -100), FVector(100, 100, 100));
+        RebuildLinearOctree();
     }
-    
-    if (RootOctree)
+    else
     {
-        for (const auto& iter : TObjectRange<UPrimitiveComponent>())
-        {
-            if (iter)
-            {
-                RootOctree->Insert(iter);
-            }
-        }
+        RebuildPointerOctree();
     }
+
+    // 위에서 전부 삽입했으므로 초기화 중에 쌓인 대기열은 필요 없음
+    OctreeDirtyComponents.Empty();
 }
 
 void UWorld::CreateBaseObject(HWND hWnd)
@@ -115,7 +127,11 @@ void UWorld::ReleaseBaseObject()
 
 bool UWorld::Tick(float DeltaTime)
 {
-	return EditorPlayer->Input(DeltaTime); // TODO: W04 - 최적화 하기
+    bool bShouldUpdateRender = EditorPlayer->Input(DeltaTime); // TODO: W04 - 최적화 하기
+
+    // Input에서 옮긴 물체까지 이번 프레임에 반영
+    bShouldUpdateRender |= FlushOctreeUpdates();
+    return bShouldUpdateRender;
 	//camera->TickComponent(DeltaTime); // W04
 	// LocalGizmo->Tick(DeltaTime); // TODO: W04 - 기즈모 조작 필요하면 주석 제거
 
@@ -168,6 +184,10 @@ void UWorld::Release()
 	}
     ActorsArray.Empty();
 
+    OctreeDirtyComponents.Empty();
+    RootOctree.reset();
+    LinearOctree.reset();
+
 	pickingGizmo = nullptr;
 	ReleaseBaseObject();
 
@@ -224,6 +244,15 @@ bool UWorld::DestroyActor(AActor* ThisActor)
     TSet<UActorComponent*> Components = ThisActor->GetComponents();
     for (UActorComponent* Component : Components)
     {
+        if (UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Component))
+        {
+            OctreeDirtyComponents.Remove(Primitive);
+            if (RootOctree)
+            {
+                RootOctree->Remove(Primitive);
+            }
+            bLinearOctreeDirty |= (OctreeType == EOctreeType::Linear);
+        }
         Component->DestroyComponent();
     }
 
@@ -235,6 +264,347 @@ bool UWorld::DestroyActor(AActor* ThisActor)
     return true;
 }
 
+void UWorld::MarkOctreeDirty(UPrimitiveComponent* Component)
+{
+    if (IsOctreePrimitive(Component))
+    {
+        OctreeDirtyComponents.Add(Component);
+    }
+}
+
+bool UWorld::FlushOctreeUpdates()
+{
+    if (OctreeDirtyComponents.IsEmpty() && !bLinearOctreeDirty)
+    {
+        return false;
+    }
+
+    if (OctreeType == EOctreeType::Linear)
+    {
+        // 움직이기만 했으면 간격이 지날 때까지 대기열에 남겨 두고 모아서 한 번에 다시 빌드
+        if (!bLinearOctreeDirty &&
+            FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - LastLinearOctreeBuildCycles) < LinearOctreeRebuildInterval)
+        {
+            return false;
+        }
+        OctreeDirtyComponents.Empty();
+        RebuildLinearOctree();
+        return true;
+    }
+
+    if (RootOctree == nullptr)
+    {
+        return false;
+    }
+
+    for (UPrimitiveComponent* Component : OctreeDirtyComponents)
+    {
+        if (Component->OctreeNodes.IsEmpty())
+        {
+            // 새로 Spawn되었거나 이전에 옥트리 범위 밖에 있던 경우
+            RootOctree->Insert(Component);
+        }
+        else
+        {
+            RootOctree->Update(Component);
+        }
+    }
+    OctreeDirtyComponents.Empty();
+    return true;
+}
+
+void UWorld::RebuildLinearOctree()
+{
+    if (LinearOctree == nullptr)
+    {
+        LinearOctree = std::make_unique<FLinearOctree>();
+    }
+
+    TArray<UPrimitiveComponent*> Primitives;
+    GatherOctreePrimitives(Primitives);
+    LinearOctree->Build(Primitives, WorldOctreeBounds);
+    bLinearOctreeDirty = false;
+    LastLinearOctreeBuildCycles = FPlatformTime::Cycles64();
+}
+
+void UWorld::RebuildPointerOctree()
+{
+    TArray<UPrimitiveComponent*> Primitives;
+    GatherOctreePrimitives(Primitives);
+
+    // 이전 트리의 노드를 가리키는 역참조가 남으면 Remove/Update가 사라진 노드를 건드림
+    for (UPrimitiveComponent* Primitive : TObjectRange<UPrimitiveComponent>())
+    {
+        Primitive->OctreeNodes.Empty();
+    }
+
+    // 느슨한 모드로 만들어서 컬링 결과에 중복이 없게 함
+    RootOctree = std::make_unique<FOctreeNode>(WorldOctreeBounds.min, WorldOctreeBounds.max, true);
+    for (UPrimitiveComponent* Primitive : Primitives)
+    {
+        RootOctree->Insert(Primitive);
+    }
+}
+
+bool UWorld::IsOctreePrimitive(const UPrimitiveComponent* Component) const
+{
+    return Component && !Component->IsA<UGizmoBaseComponent>() && (LocalGizmo == nullptr || Component->GetOwner() != LocalGizmo);
+}
+
+void UWorld::GatherOctreePrimitives(TArray<UPrimitiveComponent*>& OutPrimitives) const
+{
+    for (UPrimitiveComponent* Primitive : TObjectRange<UPrimitiveComponent>())
+    {
+        if (IsOctreePrimitive(Primitive))
+        {
+            OutPrimitives.Add(Primitive);
+        }
+    }
+}
+
+void UWorld::SetOctreeType(EOctreeType InOctreeType)
+{
+    if (OctreeType == InOctreeType)
+    {
+        return;
+    }
+
+    // 쓰지 않는 트리는 갱신하지 않으므로 남겨 두지 않음
+    OctreeType = InOctreeType;
+    OctreeDirtyComponents.Empty();
+    if (OctreeType == EOctreeType::Linear)
+    {
+        RebuildLinearOctree();
+        for (UPrimitiveComponent* Primitive : TObjectRange<UPrimitiveComponent>())
+        {
+            Primitive->OctreeNodes.Empty();
+        }
+        RootOctree.reset();
+    }
+    else
+    {
+        RebuildPointerOctree();
+        LinearOctree.reset();
+        bLinearOctreeDirty = false;
+    }
+}
+
+void UWorld::FrustumCull(const Frustum& Frustum, TArray<UPrimitiveComponent*>& OutComponents) const
+{
+    if (OctreeType == EOctreeType::Linear)
+    {
+        if (LinearOctree)
+        {
+            LinearOctree->FrustumCull(Frustum, OutComponents);
+        }
+    }
+    else if (RootOctree)
+    {
+        RootOctree->FrustumCull(Frustum, OutComponents);
+    }
+}
+
+void UWorld::FrustumCullParallel(const Frustum& Frustum, const FCullVisitor& Visitor)
+{
+    VisibilityCache.BeginCull(Frustum);
+
+    if (OctreeType == EOctreeType::Linear)
+    {
+        if (LinearOctree)
+        {
+            LinearOctree->FrustumCullParallel(Frustum, Visitor, &VisibilityCache);
+        }
+    }
+    else if (RootOctree)
+    {
+        RootOctree->FrustumCullParallel(Frustum, Visitor, &VisibilityCache);
+    }
+}
+
+void UWorld::QueryByRay(const FVector& PickPosition, const FVector& PickOrigin, TArray<UPrimitiveComponent*>& OutComponents) const
+{
+    if (OctreeType == EOctreeType::Linear)
+    {
+        if (LinearOctree)
+        {
+            LinearOctree->QueryByRay(PickPosition, PickOrigin, OutComponents);
+        }
+    }
+    else if (RootOctree)
+    {
+        RootOctree->QueryByRay(PickPosition, PickOrigin, OutComponents);
+    }
+}
+
+void UWorld::BenchmarkOctrees(const Frustum& Frustum) const
+{
+    constexpr int32 NumCullIterations = 20;
+
+    TArray<UPrimitiveComponent*> Primitives;
+    GatherOctreePrimitives(Primitives);
+    
+    // 벤치마크용 트리에 Insert하면 역참조가 바뀌므로 원래 값을 잠시 빼둠
+    TArray<TArray<FOctreeNode*>> SavedOctreeNodes;
+    SavedOctreeNodes.SetNum(Primitives.Num());
+    for (uint32 i = 0; i < Primitives.Num(); ++i)
+    {
+        SavedOctreeNodes[i] = std::move(Primitives[i]->OctreeNodes);
+        Primitives[i]->OctreeNodes.Empty();
+    }
+
+    // Build
+    uint64 StartCycles = FPlatformTime::Cycles64();
+    FOctreeNode PointerTree(WorldOctreeBounds.min, WorldOctreeBounds.max, true);
+    for (UPrimitiveComponent* Primitive : Primitives)
+    {
+        PointerTree.Insert(Primitive);
+    }
+    const double PointerBuildMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+    StartCycles = FPlatformTime::Cycles64();
+    FLinearOctree LinearTree;
+    LinearTree.Build(Primitives, WorldOctreeBounds);
+    const double LinearBuildMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+    // Cull. 평면 검사 횟수는 반복마다 같으므로 마지막 한 번만 셈
+    FCullStats PointerStats;
+    FCullStats LinearStats;
+    TArray<UPrimitiveComponent*> PointerVisible;
+    StartCycles = FPlatformTime::Cycles64();
+    for (int32 i = 0; i < NumCullIterations; ++i)
+    {
+        PointerVisible.Empty();
+        PointerTree.FrustumCull(Frustum, PointerVisible, i == NumCullIterations - 1 ? &PointerStats : nullptr);
+    }
+    const double PointerCullMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles) / NumCullIterations;
+
+    TArray<UPrimitiveComponent*> LinearVisible;
+    StartCycles = FPlatformTime::Cycles64();
+    for (int32 i = 0; i < NumCullIterations; ++i)
+    {
+        LinearVisible.Empty();
+        LinearTree.FrustumCull(Frustum, LinearVisible, i == NumCullIterations - 1 ? &LinearStats : nullptr);
+    }
+    const double LinearCullMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles) / NumCullIterations;
+
+    // 두 트리 모두 중복이 없어야 하므로 고유 개수도 같이 확인
+    TSet<UPrimitiveComponent*> PointerUnique;
+    for (UPrimitiveComponent* Primitive : PointerVisible)
+    {
+        PointerUnique.Add(Primitive);
+    }
+
+    UE_LOG(LogLevel::Display, "Octree benchmark: %u primitives", Primitives.Num());
+    UE_LOG(LogLevel::Display, " - Pointer (loose): build %.3f ms, %u nodes, %llu B, cull %.3f ms, %u visible (%u unique), %u plane tests (%u skipped)",
+        PointerBuildMs, PointerTree.CountAllNodes(), PointerTree.GetAllocatedSize(), PointerCullMs, PointerVisible.Num(), PointerUnique.Num(),
+        PointerStats.PlaneTests, PointerStats.PlaneTestsSkipped);
+    UE_LOG(LogLevel::Display, " - Linear: build %.3f ms, %u nodes, %llu B, cull %.3f ms, %u visible, %u plane tests (%u skipped)",
+        LinearBuildMs, LinearTree.GetNumNodes(), LinearTree.GetAllocatedSize(), LinearCullMs, LinearVisible.Num(),
+        LinearStats.PlaneTests, LinearStats.PlaneTestsSkipped);
+
+    // 벤치마크용 트리가 남긴 역참조를 원래 트리 것으로 되돌림
+    for (uint32 i = 0; i < Primitives.Num(); ++i)
+    {
+        Primitives[i]->OctreeNodes = std::move(SavedOctreeNodes[i]);
+    }
+}
+
+void UWorld::ValidateOctree() const
+{
+    if (RootOctree == nullptr)
+    {
+        UE_LOG(LogLevel::Warning, "Octree validation: no pointer octree");
+        return;
+    }
+
+    const uint32 NumErrors = RootOctree->ValidateOctree();
+    UE_LOG(LogLevel::Display, "Octree validation: %u components, %u outside loose bounds, %s",
+        RootOctree->CountAllComponents(), NumErrors, NumErrors == 0 ? "OK" : "INVALID");
+}
+
+void UWorld::ValidateMeshBVH(uint32 NumRays) const
+{
+    // 같은 결과로 판정할 거리 오차. 삼각형 계산 순서가 같으므로 대부분 정확히 같음
+    constexpr float Tolerance = 1e-4f;
+
+    std::mt19937 Random(1234);
+    std::normal_distribution<float> Normal(0.f, 1.f);
+    std::uniform_real_distribution<float> Unit(0.f, 1.f);
+
+    TSet<UStaticMesh*> Validated;
+    uint32 TotalMismatches = 0;
+    for (UStaticMeshComponent* Component : TObjectRange<UStaticMeshComponent>())
+    {
+        UStaticMesh* StaticMesh = Component->GetStaticMesh();
+        if (StaticMesh == nullptr || Validated.Contains(StaticMesh))
+        {
+            continue;
+        }
+        Validated.Add(StaticMesh);
+
+        const OBJ::FStaticMeshRenderData* RenderData = StaticMesh->GetRenderData();
+        const FVector BoundsMin = RenderData->BoundingBoxMin;
+        const FVector BoundsSize = RenderData->BoundingBoxMax - BoundsMin;
+        const FVector Center = BoundsMin + BoundsSize * 0.5f;
+        const float Radius = BoundsSize.Magnitude() + 1.f;
+
+        // 메시를 감싸는 구 위에서 박스 안의 임의의 점을 향해 쏨
+        TArray<FVector> Origins;
+        TArray<FVector> Targets;
+        Origins.SetNum(NumRays);
+        Targets.SetNum(NumRays);
+        for (uint32 i = 0; i < NumRays; ++i)
+        {
+            const FVector Direction = FVector(Normal(Random), Normal(Random), Normal(Random)).Normalize();
+            Origins[i] = Center + Direction * Radius;
+            Targets[i] = BoundsMin + FVector(BoundsSize.x * Unit(Random), BoundsSize.y * Unit(Random), BoundsSize.z * Unit(Random));
+        }
+
+        TArray<float> BruteDistances;
+        BruteDistances.SetNum(NumRays);
+        uint64 StartCycles = FPlatformTime::Cycles64();
+        for (uint32 i = 0; i < NumRays; ++i)
+        {
+            FVector Origin = Origins[i];
+            FVector Direction = (Targets[i] - Origins[i]).Normalize();
+            float Distance = FLT_MAX;
+            BruteDistances[i] = Component->CheckRayIntersection(Origin, Direction, Distance) > 0 ? Distance : FLT_MAX;
+        }
+        const double BruteMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+        TArray<float> BVHDistances;
+        BVHDistances.SetNum(NumRays);
+        StartCycles = FPlatformTime::Cycles64();
+        for (uint32 i = 0; i < NumRays; ++i)
+        {
+            float Distance = FLT_MAX;
+            BVHDistances[i] = StaticMesh->CheckRayIntersect(Targets[i], Origins[i], Distance) ? Distance : FLT_MAX;
+        }
+        const double BVHMs = FPlatformTime::ToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+        uint32 NumHits = 0;
+        uint32 NumMismatches = 0;
+        for (uint32 i = 0; i < NumRays; ++i)
+        {
+            const bool bBruteHit = BruteDistances[i] != FLT_MAX;
+            NumHits += bBruteHit ? 1 : 0;
+            if (bBruteHit != (BVHDistances[i] != FLT_MAX) ||
+                (bBruteHit && std::abs(BruteDistances[i] - BVHDistances[i]) > Tolerance * FMath::Max(1.f, BruteDistances[i])))
+            {
+                ++NumMismatches;
+            }
+        }
+        TotalMismatches += NumMismatches;
+
+        const FTriangleBVH& BVH = StaticMesh->GetBVH();
+        UE_LOG(LogLevel::Display, " - %s: %u triangles, %u nodes, %llu B, %u/%u hits, brute %.3f ms, BVH %.3f ms (x%.1f), %u mismatches",
+            *RenderData->DisplayName, BVH.GetNumTriangles(), BVH.GetNumNodes(), BVH.GetAllocatedSize(), NumHits, NumRays,
+            BruteMs, BVHMs, BVHMs > 0.0 ? BruteMs / BVHMs : 0.0, NumMismatches);
+    }
+
+    UE_LOG(LogLevel::Display, "Mesh BVH validation: %u meshes, %u rays each, %s", Validated.Num(), NumRays, TotalMismatches == 0 ? "all match" : "MISMATCH");
+}
+
 void UWorld::SetPickingGizmo(UObject* Object)
 {
 	pickingGizmo = Cast<USceneComponent>(Object);
@@ -7,6 +7,7 @@
 #include "Engine/Classes/Components/StaticMeshComponent.h"
 #include "Editor/UnrealEd/EditorViewportClient.h"
 #include "CoreUObject/UObject/Casts.h"
+#include "FrustumCulling.h"
 
 class FObjectFactory;
 class AActor;
@@ -19,15 +20,25 @@ class UTransformGizmo;
 class SceneData;
 
 struct FOctreeNode;
+class FLinearOctree;
+struct Frustum;
+
+/** 컬링/피킹에 사용할 옥트리 구현 */
+enum class EOctreeType : uint8
+{
+    Pointer, // FOctreeNode. 노드마다 자식을 따로 할당하고 부분 갱신을 지원
+    Linear,  // FLinearOctree. Morton 순서의 연속 배열, 바뀌면 통째로 다시 빌드 (움직임은 LinearOctreeRebuildInterval마다 반영)
+};
 
 class UWorld : public UObject
 {
     DECLARE_CLASS(UWorld, UObject)
 
 public:
-    UWorld() = default;
+    UWorld();
+    virtual ~UWorld() override;
 
-    void Initialize(HWND hWnd);
+    void Initialize(HWND hWnd, EOctreeType InOctreeType = EOctreeType::Pointer);
     void CreateBaseObject(HWND hWnd);
     void ReleaseBaseObject();
     /**
@@ -49,6 +60,42 @@ public:
     /** World에 존재하는 Actor를 제거합니다. */
     bool DestroyActor(AActor* ThisActor);
 
+    /** 트랜스폼이 바뀌었거나 새로 생긴 Primitive를 옥트리 갱신 대기열에 넣습니다. */
+    void MarkOctreeDirty(UPrimitiveComponent* Component);
+
+    /**
+     * 대기열에 쌓인 Primitive들을 옥트리에 한 번에 반영합니다. 프레임당 한 번 호출됩니다.
+     * @return 반영된 Primitive가 있으면 true
+     */
+    bool FlushOctreeUpdates();
+
+    /** 컬링/피킹에 쓸 옥트리를 바꿉니다. 새 옥트리는 현재 Primitive들로 다시 빌드하고 이전 것은 버립니다. */
+    void SetOctreeType(EOctreeType InOctreeType);
+
+    /** 선택된 옥트리로 Frustum 컬링을 합니다. */
+    void FrustumCull(const Frustum& Frustum, TArray<UPrimitiveComponent*>& OutComponents) const;
+
+    /**
+     * 옥트리 서브트리를 워커 스레드에 나눠서 컬링하고, 보이는 컴포넌트마다 Visitor를 호출합니다.
+     * 옥트리 노드 판정은 VisibilityCache로 직전 호출의 결과를 재사용합니다.
+     */
+    void FrustumCullParallel(const Frustum& Frustum, const FCullVisitor& Visitor);
+
+    /** 선택된 옥트리로 Ray에 걸리는 Primitive 후보를 찾습니다. */
+    void QueryByRay(const FVector& PickPosition, const FVector& PickOrigin, TArray<UPrimitiveComponent*>& OutComponents) const;
+
+    /** 현재 Primitive들로 두 옥트리를 새로 빌드해서 빌드 시간, 메모리, 컬링 시간을 비교해 로그로 남깁니다. */
+    void BenchmarkOctrees(const Frustum& Frustum) const;
+
+    /**
+     * 월드에 있는 스태틱 메시마다 임의의 레이 NumRays개를 쏴서
+     * 삼각형 BVH의 결과와 시간을 UStaticMeshComponent::CheckRayIntersection(전수 검사)과 비교해 로그로 남깁니다.
+     */
+    void ValidateMeshBVH(uint32 NumRays = 1000) const;
+
+    /** 포인터 옥트리에 들어있는 컴포넌트가 모두 루트와 자기 노드의 느슨한 범위 안에 있는지 확인해서 로그로 남깁니다. */
+    void ValidateOctree() const;
+
 private:
     const FString defaultMapName = "Default";
 
@@ -64,7 +111,41 @@ private:
     UCameraComponent* camera = nullptr;
     AEditorPlayer* EditorPlayer = nullptr;
 
-    std::unique_ptr<FOctreeNode> RootOctree = nullptr;
+    std::unique_ptr<FOctreeNode> RootOctree;
+
+    std::unique_ptr<FLinearOctree> LinearOctree;
+
+    EOctreeType OctreeType = EOctreeType::Pointer;
+
+    /** 이번 프레임에 옥트리 위치를 다시 계산해야 하는 Primitive들 */
+    TSet<UPrimitiveComponent*> OctreeDirtyComponents;
+
+    /** FrustumCullParallel에서 옥트리 노드 판정을 프레임 사이에 재사용하기 위한 캐시 */
+    FVisibilityCache VisibilityCache;
+
+    /** 선형 옥트리는 부분 갱신이 안 되므로, Actor가 제거되면 다음 Flush에서 다시 빌드 */
+    bool bLinearOctreeDirty = false;
+
+    /** 마지막으로 선형 옥트리를 빌드한 시각 (FPlatformTime::Cycles64) */
+    uint64 LastLinearOctreeBuildCycles = 0;
+
+    /**
+     * 선형 옥트리는 물체 하나만 움직여도 Morton 정렬부터 통째로 다시 빌드하므로(O(N log N)), 움직임은 이 간격(ms)마다 한 번만 반영합니다.
+     * 그 사이에는 움직인 물체가 이전 위치의 AABB로 컬링됩니다. 제거는 지워진 컴포넌트를 가리키지 않도록 바로 반영
+     */
+    static constexpr double LinearOctreeRebuildInterval = 100.0;
+
+    /** 옥트리에 넣을 Primitive인지. 기즈모는 렌더러가 컬링 없이 따로 그리므로 두 옥트리 모두에서 뺌 */
+    bool IsOctreePrimitive(const UPrimitiveComponent* Component) const;
+
+    /** 옥트리에 넣을 Primitive를 모두 모읍니다. */
+    void GatherOctreePrimitives(TArray<UPrimitiveComponent*>& OutPrimitives) const;
+
+    /** Primitive를 모두 모아 선형 옥트리를 다시 빌드합니다. */
+    void RebuildLinearOctree();
+
+    /** 기존 역참조를 지우고 Primitive를 모두 모아 포인터 옥트리를 새로 만듭니다. */
+    void RebuildPointerOctree();
 
 public:
     // UObject* worldGizmo = nullptr; // W04
@@ -85,6 +166,9 @@ public:
     void SetPickingGizmo(UObject* Object);
 
     FOctreeNode* GetOctree() { return RootOctree.get(); }
+    FLinearOctree* GetLinearOctree() { return LinearOctree.get(); }
+    EOctreeType GetOctreeType() const { return OctreeType; }
+    const FVisibilityCache& GetVisibilityCache() const { return VisibilityCache; }
 };
 
 
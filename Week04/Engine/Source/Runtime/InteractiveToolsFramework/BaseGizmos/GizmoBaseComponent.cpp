@@ -11,13 +11,11 @@ int UGizmoBaseComponent::CheckRayIntersection(FVector& rayOrigin, FVector& rayDi
     int nIntersections = 0;
     if (staticMesh == nullptr) return 0;
     OBJ::FStaticMeshRenderData* renderData = staticMesh->GetRenderData();
-    FVertexSimple* vertices = renderData->Vertices.GetData();
-    int vCount = renderData->Vertices.Num();
-    UINT* indices = renderData->Indices.GetData();
-    int iCount = renderData->Indices.Num();
+    int vCount = renderData->GetNumVertices();
+    const UINT* indices = renderData->GetIndexData();
+    int iCount = renderData->GetNumBaseIndices();
 
-    if (!vertices) return 0;
-    BYTE* pbPositions = reinterpret_cast<BYTE*>(renderData->Vertices.GetData());
+    if (vCount == 0) return 0;
 
     int nPrimitives = (!indices) ? (vCount / 3) : (iCount / 3);
     float fNearHitDistance = FLT_MAX;
@@ -34,11 +32,10 @@ int UGizmoBaseComponent::CheckRayIntersection(FVector& rayOrigin, FVector& rayDi
             idx1 = indices[i * 3 + 2];
         }
 
-        // 각 삼각형의 버텍스 위치를 FVector로 불러옵니다.
-        uint32 stride = sizeof(FVertexSimple);
-        FVector v0 = *reinterpret_cast<FVector*>(pbPositions + idx0 * stride);
-        FVector v1 = *reinterpret_cast<FVector*>(pbPositions + idx1 * stride);
-        FVector v2 = *reinterpret_cast<FVector*>(pbPositions + idx2 * stride);
+        // 각 삼각형의 버텍스 위치를 FVector로 불러옵니다. 압축 정점이면 풀어서 가져옵니다.
+        FVector v0 = renderData->GetVertexPosition(idx0);
+        FVector v1 = renderData->GetVertexPosition(idx1);
+        FVector v2 = renderData->GetVertexPosition(idx2);
 
         float fHitDistance;
         if (IntersectRayTriangle(rayOrigin, rayDirection, v0, v1, v2, fHitDistance)) {
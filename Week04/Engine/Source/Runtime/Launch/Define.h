@@ -1,6 +1,7 @@
 #pragma once
 #include <cmath>
 #include <algorithm>
+#include <memory>
 #include "Core/Container/String.h"
 #include "Core/Container/Array.h"
 #include "UObject/NameTypes.h"
@@ -9,6 +10,8 @@
 #include "Math/Vector.h"
 #include "Math/Vector4.h"
 #include "Math/Matrix.h"
+#include "Math/PackedVector.h"
+#include "Misc/ContentHash.h"
 
 
 #define UE_LOG Console::GetInstance().AddLog
@@ -19,6 +22,7 @@
 #include "UserInterface/Console.h"
 
 class UStaticMeshComponent;
+class FMappedFile;
 
 struct FVertexSimple
 {
@@ -27,6 +31,23 @@ struct FVertexSimple
     float u=0, v=0;
 };
 
+enum class EStaticMeshVertexFormat : uint8
+{
+    Full,    // FVertexSimple
+    Compact, // FVertexCompact
+};
+
+/**
+ * 쿡된 스태틱 메시용 압축 정점 (12바이트, FVertexSimple의 1/3).
+ * 위치는 메시 바운딩 박스 안의 16비트 정수, UV는 half float입니다. 색은 항상 (0, 0, 0, 1)로 봅니다.
+ */
+struct FVertexCompact
+{
+    uint16 X, Y, Z;
+    uint16 Normal; // FOctahedralNormal. 원본에 법선이 없으면 0
+    uint16 U, V;   // FFloat16
+};
+
 // Material Subset
 struct FMaterialSubset
 {
@@ -36,6 +57,21 @@ struct FMaterialSubset
     FString MaterialName; // Material Name
 };
 
+/**
+ * 쿡할 때 만든 단순화 LOD. 인덱스는 LOD0 뒤에 이어 붙어 있고 정점 버퍼는 LOD0과 같이 씁니다.
+ * MaterialSubsets는 LOD0과 개수와 순서가 같아서 같은 머티리얼 인덱스로 그릴 수 있습니다.
+ */
+struct FStaticMeshLOD
+{
+    uint32 FirstIndex = 0;
+    uint32 NumIndices = 0;
+
+    /** 단순화로 표면이 가장 많이 벗어난 거리의 추정치 (메시 로컬 단위) */
+    float MaxError = 0.f;
+
+    TArray<FMaterialSubset> MaterialSubsets;
+};
+
 struct FStaticMaterial
 {
     class UMaterial* Material;
@@ -119,12 +155,123 @@ namespace OBJ
         TArray<FVertexSimple> Vertices;
         TArray<UINT> Indices;
 
+        /** Compact면 정점은 CompactVertices(또는 MappedCompactVertices)에만 있고 Vertices는 비어 있습니다. */
+        EStaticMeshVertexFormat VertexFormat = EStaticMeshVertexFormat::Full;
+        TArray<FVertexCompact> CompactVertices;
+        bool bHasVertexNormals = false;
+
+        /** 원본 .obj의 정점 법선. 쿡할 때 압축 정점에 넣는 데만 쓰고 비움 */
+        TArray<FVector> Normals;
+
+        /**
+         * 쿡 파일에서 읽었으면 정점과 인덱스는 매핑된 파일 안을 가리키고 Vertices/Indices는 비어 있습니다.
+         * 그래서 정점과 인덱스는 GetVertexData/GetIndexData로 읽습니다.
+         */
+        std::shared_ptr<FMappedFile> CookedFile;
+
+        /** DDC에서 쿡 결과를 찾은 키. BVH 같은 다음 단계 데이터의 키를 여기서 만들며, 0이면 DDC를 거치지 않은 메시 */
+        FContentHash DerivedDataKey;
+        const FVertexSimple* MappedVertices = nullptr;
+        const FVertexCompact* MappedCompactVertices = nullptr;
+        const UINT* MappedIndices = nullptr;
+        uint32 NumMappedVertices = 0;
+        uint32 NumMappedIndices = 0;
+
+        bool IsCompact() const { return VertexFormat == EStaticMeshVertexFormat::Compact; }
+
+        /** Full 형식일 때만 유효. Compact면 nullptr이므로 GetVertexPosition이나 DecodeVertices를 씀 */
+        const FVertexSimple* GetVertexData() const { return IsCompact() ? nullptr : (MappedVertices ? MappedVertices : Vertices.GetData()); }
+        const FVertexCompact* GetCompactVertexData() const { return IsCompact() ? (MappedCompactVertices ? MappedCompactVertices : CompactVertices.GetData()) : nullptr; }
+        uint32 GetNumVertices() const
+        {
+            if (MappedVertices || MappedCompactVertices)
+            {
+                return NumMappedVertices;
+            }
+            return IsCompact() ? CompactVertices.Num() : Vertices.Num();
+        }
+        const UINT* GetIndexData() const { return MappedIndices ? MappedIndices : Indices.GetData(); }
+        uint32 GetNumIndices() const { return MappedIndices ? NumMappedIndices : Indices.Num(); }
+
+        /** 형식에 맞는 정점 버퍼 내용과 정점 하나의 바이트 수 */
+        const void* GetVertexBufferData() const { return IsCompact() ? static_cast<const void*>(GetCompactVertexData()) : GetVertexData(); }
+        uint32 GetVertexStride() const { return IsCompact() ? sizeof(FVertexCompact) : sizeof(FVertexSimple); }
+
+        /** 메시 로컬 공간의 정점 위치. 형식과 상관없이 GPU가 그리는 위치와 같음 */
+        FVector GetVertexPosition(uint32 Index) const
+        {
+            if (!IsCompact())
+            {
+                const FVertexSimple& Vertex = GetVertexData()[Index];
+                return FVector(Vertex.x, Vertex.y, Vertex.z);
+            }
+            const FVertexCompact& Vertex = GetCompactVertexData()[Index];
+            const FVector Extent = BoundingBoxMax - BoundingBoxMin;
+            return FVector(
+                FQuantizedPosition::Decode(Vertex.X, BoundingBoxMin.x, Extent.x),
+                FQuantizedPosition::Decode(Vertex.Y, BoundingBoxMin.y, Extent.y),
+                FQuantizedPosition::Decode(Vertex.Z, BoundingBoxMin.z, Extent.z)
+            );
+        }
+
+        /** 모든 정점을 FVertexSimple로 풀어서 OutVertices에 씁니다. BVH 빌드처럼 CPU에서 정점 전체를 훑을 때 사용 */
+        void DecodeVertices(TArray<FVertexSimple>& OutVertices) const
+        {
+            const uint32 NumVertices = GetNumVertices();
+            OutVertices.SetNum(NumVertices);
+            if (!IsCompact())
+            {
+                std::copy(GetVertexData(), GetVertexData() + NumVertices, OutVertices.begin());
+                return;
+            }
+
+            const FVertexCompact* Compact = GetCompactVertexData();
+            for (uint32 i = 0; i < NumVertices; ++i)
+            {
+                const FVector Position = GetVertexPosition(i);
+                FVertexSimple& Vertex = OutVertices[i];
+                Vertex.x = Position.x; Vertex.y = Position.y; Vertex.z = Position.z;
+                Vertex.r = 0.0f; Vertex.g = 0.0f; Vertex.b = 0.0f; Vertex.a = 1.0f;
+                Vertex.u = FFloat16::Decode(Compact[i].U);
+                Vertex.v = FFloat16::Decode(Compact[i].V);
+            }
+        }
+
+        /**
+         * 압축 정점의 정수 위치를 메시 로컬 공간으로 옮기는 행렬 (행 벡터 기준, 월드 행렬 앞에 곱함).
+         * Full이면 단위 행렬
+         */
+        FMatrix GetDequantizeMatrix() const
+        {
+            FMatrix Result = FMatrix::Identity;
+            if (IsCompact())
+            {
+                const FVector Extent = BoundingBoxMax - BoundingBoxMin;
+                Result.M[0][0] = Extent.x / FQuantizedPosition::MaxValue;
+                Result.M[1][1] = Extent.y / FQuantizedPosition::MaxValue;
+                Result.M[2][2] = Extent.z / FQuantizedPosition::MaxValue;
+                Result.M[3][0] = BoundingBoxMin.x;
+                Result.M[3][1] = BoundingBoxMin.y;
+                Result.M[3][2] = BoundingBoxMin.z;
+            }
+            return Result;
+        }
+
         ID3D11Buffer* VertexBuffer;
         ID3D11Buffer* IndexBuffer;
         
         TArray<FObjMaterialInfo> Materials;
         TArray<FMaterialSubset> MaterialSubsets;
 
+        /** LOD1부터. 비어 있으면 LOD0만 있음 */
+        TArray<FStaticMeshLOD> LODs;
+
+        uint32 GetNumLODs() const { return 1 + LODs.Num(); }
+        const TArray<FMaterialSubset>& GetLODSubsets(uint32 LODIndex) const { return LODIndex == 0 ? MaterialSubsets : LODs[LODIndex - 1].MaterialSubsets; }
+
+        /** LOD0의 인덱스 수. 피킹과 BVH는 LOD0만 씀 */
+        uint32 GetNumBaseIndices() const { return LODs.IsEmpty() ? GetNumIndices() : LODs[0].FirstIndex; }
+
         FVector BoundingBoxMin;
         FVector BoundingBoxMax;
     };
@@ -194,6 +341,22 @@ struct FBoundingBox
     {
         return !(point.x < min.x || point.x > max.x || point.y < min.y || point.y > max.y || point.z < min.z || point.z > max.z);
     }
+
+    bool ContainsAABB(const FBoundingBox& other) const
+    {
+        return other.min.x >= min.x && other.max.x <= max.x &&
+            other.min.y >= min.y && other.max.y <= max.y &&
+            other.min.z >= min.z && other.max.z <= max.z;
+    }
+
+    /** 두 박스를 모두 감싸는 박스 */
+    FBoundingBox Union(const FBoundingBox& other) const
+    {
+        return FBoundingBox(
+            FVector(std::min(min.x, other.min.x), std::min(min.y, other.min.y), std::min(min.z, other.min.z)),
+            FVector(std::max(max.x, other.max.x), std::max(max.y, other.max.y), std::max(max.z, other.max.z))
+        );
+    }
     
     bool Intersect(const FVector& rayOrigin, const FVector& rayDir, float& outDistance) const
     {
@@ -12,6 +12,10 @@
 #include "LevelEditor/SLevelEditor.h"
 #include "UnrealEd\SceneMgr.h"
 #include "OctreeNode.h"
+#include "Core/Async/JobSystem.h"
+#include "Core/HAL/FrameAllocator.h"
+#include "Engine/AsyncLoader.h"
+#include "Engine/DerivedDataCache.h"
 
 
 extern LRESULT ImGui_ImplWin32_WndProcHandler(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam);
@@ -112,6 +116,10 @@ int32 FEngineLoop::PreInit()
 int32 FEngineLoop::Init(HINSTANCE hInstance)
 {
     WindowInit(hInstance);
+
+    FJobSystem::Initialize();
+    FDerivedDataCache::Initialize();
+    FAsyncLoader::Initialize();
     
     GraphicDevice.Initialize(hWnd);
     Renderer.Initialize(&GraphicDevice);
@@ -197,6 +205,7 @@ void FEngineLoop::Tick()
         }
 
         bool bShouldUpdateRender = false;
+        bShouldUpdateRender |= FAsyncLoader::ProcessCompletions(FAsyncLoader::FrameTimeBudgetMs) > 0;
         bShouldUpdateRender |= GWorld->Tick(ElapsedTime);
         bShouldUpdateRender |= LevelEditor->Tick(ElapsedTime);
         if (bShouldUpdateRender || bIsInhibitorEnabled)
@@ -215,6 +224,9 @@ void FEngineLoop::Tick()
 
         GraphicDevice.SwapBuffer();
 
+        // 이번 프레임의 임시 컨테이너는 모두 끝났으므로 한꺼번에 비움
+        FFrameAllocator::EndFrame();
+
         if (bShouldLimitFPS)
         {
             LimitFPS(StartTime, Frequency, TargetDeltaTime);
@@ -267,6 +279,8 @@ void FEngineLoop::Input()
 
 void FEngineLoop::Exit()
 {
+    FAsyncLoader::Shutdown();
+    FDerivedDataCache::Shutdown();
     LevelEditor->Release();
     GWorld->Release();
     delete GWorld;
@@ -275,6 +289,7 @@ void FEngineLoop::Exit()
     ResourceManager.Release(&Renderer);
     Renderer.Release();
     GraphicDevice.Release();
+    FJobSystem::Shutdown();
 }
 
 
@@ -24,7 +24,8 @@
 #include "BaseGizmos/TransformGizmo.h"
 #include "UObject/UObjectIterator.h"
 #include "BaseGizmos/GizmoBaseComponent.h"
-#include <future>
+#include "Core/Algo/RadixSort.h"
+#include "Core/Async/JobSystem.h"
 
 void FRenderer::Initialize(FGraphicsDevice* graphics)
 {
@@ -120,94 +121,114 @@ TArray<TArray<UStaticMeshComponent*>> FRenderer::AggregateMeshComponents(FOctree
     //}
 }
 
-void FRenderer::SortByMaterial(TArray<UPrimitiveComponent*> PrimComps)
+void FRenderer::RegisterDrawMesh(UStaticMesh* StaticMesh)
 {
-    //uint32 NumThreads = std::thread::hardware_concurrency() * 2; // big-little구조에선 잘 작동안함.
-    //if (NumThreads == 0) NumThreads = 8;
-    uint32 NumThreads = 8; 
-
-    TArray <std::future< 
-        std::unordered_map<UMaterial*,
-        std::unordered_map<UStaticMesh*, std::vector<FRenderer::FMeshData>>
-        >>>Futures;
-
-    int ChunkSize = PrimComps.Num() / (NumThreads - 1);
-    if (PrimComps.Num() < 128) ChunkSize = PrimComps.Num();
-    else if (PrimComps.Num() < 256) ChunkSize = PrimComps.Num()/2;
-    else if (PrimComps.Num() < 512) ChunkSize = PrimComps.Num()/4;
-    for (int i = 0; i < NumThreads; ++i)
+    const TArray<FMaterialSubset>& Subsets = StaticMesh->GetRenderData()->MaterialSubsets;
+    if (DrawMeshes.Num() >= (1 << FDrawKey::MeshBits) || Subsets.Num() > (1 << FDrawKey::SubMeshBits))
     {
-        int Start = i * ChunkSize;
-        int End = FMath::Min((i + 1) * ChunkSize, PrimComps.Num());
-        if (Start >= End) break;
-
-        // read only니깐 상관없음
-        Futures.Add(std::async(std::launch::async, &FRenderer::SortByMaterialThread, this,
-            std::ref(PrimComps), Start, End));
+        UE_LOG(LogLevel::Error, "Too many meshes or submeshes for draw sort keys");
+        return;
     }
 
-    // 모든 future 결과를 기다리기
-    for (auto& Future : Futures)
+    TArray<uint32> MaterialIds;
+    MaterialIds.SetNum(Subsets.Num());
+    for (int32 i = 0; i < Subsets.Num(); ++i)
     {
-        auto ChunkResult = Future.get(); // 결과 받아오기
+        UMaterial* Material = StaticMesh->GetMaterials()[Subsets[i].MaterialIndex]->Material;
 
-        // 반환된 ChunkResult를 기존 MaterialMeshMap에 병합
-        for (auto& [Material, DataMap] : ChunkResult)
+        // 등록은 메시당 한 번뿐이므로 선형 탐색으로 충분함
+        int32 MaterialId;
+        if (!DrawMaterials.Find(Material, MaterialId))
         {
-            for (auto& [StaticMesh, DataArray] : DataMap)
+            if (DrawMaterials.Num() >= (1 << FDrawKey::MaterialBits))
             {
-                // MaterialMeshMap에 이미 존재하는 키들에 데이터를 덧붙이기
-                MaterialMeshMap[Material][StaticMesh].insert(
-                    MaterialMeshMap[Material][StaticMesh].end(),
-                    DataArray.begin(),
-                    DataArray.end()
-                );
+                UE_LOG(LogLevel::Error, "Too many materials for draw sort keys");
+                return;
             }
+            MaterialId = DrawMaterials.Add(Material);
         }
+        MaterialIds[i] = MaterialId;
     }
 
+    StaticMesh->DrawMaterialIds = std::move(MaterialIds);
+    StaticMesh->DrawMeshId = DrawMeshes.Add(StaticMesh);
 }
 
-std::unordered_map<UMaterial*, std::unordered_map<UStaticMesh*, std::vector<FRenderer::FMeshData>>> 
-    FRenderer::SortByMaterialThread(TArray<UPrimitiveComponent*>& PrimComps, uint32 start, uint32 end)
+uint32 FRenderer::SelectLOD(float ScreenSize, uint32 NumLODs, uint32 PreviousLOD)
 {
-    AActor* SelectedActor = World->GetSelectedActor();
-    UTransformGizmo* GizmoActor = World->LocalGizmo;
+    static_assert(sizeof(FLODStats::Meshes) / sizeof(FLODStats::Meshes[0]) == MaxDrawLODs);
+
+    uint32 LOD = 0;
+    while (LOD + 1 < NumLODs && ScreenSize < LODScreenSizes[LOD + 1])
+    {
+        ++LOD;
+    }
 
-    std::unordered_map<UMaterial*, std::unordered_map<UStaticMesh*, std::vector<FMeshData>>> MaterialMeshMapLocal;
-    for(int i = start; i < end; ++i)
+    // 경계를 충분히 넘지 않았으면 직전 LOD 쪽으로 한 단계 되돌림
+    if (PreviousLOD < NumLODs)
     {
-        if (GizmoActor->GetComponents().Contains(PrimComps[i]))
+        if (LOD > PreviousLOD && ScreenSize > LODScreenSizes[LOD] * (1.f - LODHysteresis))
         {
-            // 기즈모는 Frustum 컬링이 적용되지 않게 따로 관리할 예정이므로 여기에서는 건너뜀.
+            return LOD - 1;
         }
-        // UGizmoBaseComponent가 UStaticMeshComponent를 상속받으므로, 정확히 구분하기 위함.
-        else if (UStaticMeshComponent* pStaticMeshComp = Cast<UStaticMeshComponent>(PrimComps[i]))
+        if (LOD < PreviousLOD && ScreenSize < LODScreenSizes[LOD + 1] * (1.f + LODHysteresis))
         {
-            UStaticMesh* StaticMesh = pStaticMeshComp->GetStaticMesh();
-            if (!StaticMesh)
-            {
-                continue;
-            }
+            return LOD + 1;
+        }
+    }
+    return LOD;
+}
 
-            int SubMeshIdx = 0;
+void FRenderer::AddDrawCommands(UStaticMeshComponent* StaticMeshComp, const AActor* SelectedActor, const FDrawView& View,
+    TArray<uint64>& OutKeys, TArray<FDrawInstance>& OutInstances, FLODStats& OutStats)
+{
+    const UStaticMesh* StaticMesh = StaticMeshComp->GetStaticMesh();
 
-            FMeshData Data;
-            Data.WorldMatrix = pStaticMeshComp->GetWorldMatrix();
-            Data.bIsSelected = SelectedActor == pStaticMeshComp->GetOwner();
+    const uint32 Instance = OutInstances.Num();
+    FDrawInstance& DrawInstance = OutInstances[OutInstances.Emplace()];
+    const FMatrix World = StaticMeshComp->GetWorldMatrix();
+    const OBJ::FStaticMeshRenderData* RenderData = StaticMesh->GetRenderData();
+    DrawInstance.WorldMatrix = RenderData->IsCompact() ? RenderData->GetDequantizeMatrix() * World : World; // 압축 정점의 역양자화를 월드 행렬에 합침
+    DrawInstance.bIsSelected = SelectedActor == StaticMeshComp->GetOwner();
 
-            for (const auto& subMesh : pStaticMeshComp->GetStaticMesh()->GetRenderData()->MaterialSubsets)
-            {
-                UMaterial* Material = pStaticMeshComp->GetStaticMesh()->GetMaterials()[0]->Material;
-                Data.IndexStart = subMesh.IndexStart;
-                Data.IndexCount = subMesh.IndexCount;
-                MaterialMeshMapLocal[Material][StaticMesh].push_back(Data);
-                SubMeshIdx++;
-            }
+    // 거리를 로그 스케일로 나눔. 2 * log2(1 + d^2) ~= 4 * log2(d) 이므로 버킷 하나가 대략 1/4 옥타브
+    const FVector ToCamera(World.M[3][0] - View.CameraLocation.x, World.M[3][1] - View.CameraLocation.y, World.M[3][2] - View.CameraLocation.z);
+    const float DistanceSquared = ToCamera.x * ToCamera.x + ToCamera.y * ToCamera.y + ToCamera.z * ToCamera.z;
+    const uint32 Depth = FMath::Min(static_cast<uint32>(std::log2(1.f + DistanceSquared) * 2.f), (1u << FDrawKey::DepthBits) - 1);
+
+    // 바운딩 구를 월드로 옮겨서 화면 크기를 구함. 반지름은 가장 큰 축 스케일로 늘림
+    uint32 LOD = 0;
+    const uint32 NumLODs = FMath::Min(RenderData->GetNumLODs(), MaxDrawLODs);
+    if (NumLODs > 1)
+    {
+        const FVector LocalCenter = (RenderData->BoundingBoxMin + RenderData->BoundingBoxMax) * 0.5f;
+        const float LocalRadius = (RenderData->BoundingBoxMax - RenderData->BoundingBoxMin).Magnitude() * 0.5f;
+        float MaxScaleSquared = 0.f;
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            MaxScaleSquared = FMath::Max(MaxScaleSquared, World.M[Axis][0] * World.M[Axis][0] + World.M[Axis][1] * World.M[Axis][1] + World.M[Axis][2] * World.M[Axis][2]);
+        }
+        const float Radius = LocalRadius * std::sqrt(MaxScaleSquared);
+
+        float ScreenSize = 2.f * Radius * View.ScreenMultiple;
+        if (View.bPerspective)
+        {
+            // 카메라가 구 안에 있으면 화면을 가득 채운 것으로 봄
+            const float Distance = (World.TransformPosition(LocalCenter) - View.CameraLocation).Magnitude();
+            ScreenSize /= FMath::Max(Distance, Radius);
         }
+        LOD = SelectLOD(ScreenSize, NumLODs, StaticMeshComp->LODIndex);
     }
+    StaticMeshComp->LODIndex = static_cast<uint8>(LOD);
 
-    return MaterialMeshMapLocal;
+    const TArray<FMaterialSubset>& Subsets = RenderData->GetLODSubsets(LOD);
+    const uint32 MeshId = StaticMesh->DrawMeshId;
+    for (int32 i = 0; i < StaticMesh->DrawMaterialIds.Num(); ++i)
+    {
+        OutKeys.Add(FDrawKey::Make(StaticMesh->DrawMaterialIds[i], MeshId, LOD, i, Depth, Instance));
+        OutStats.Triangles[LOD] += Subsets[i].IndexCount / 3;
+    }
+    ++OutStats.Meshes[LOD];
 }
 
 void FRenderer::Release()
@@ -244,6 +265,21 @@ void FRenderer::CreateShader()
     Stride = sizeof(FVertexSimple);
     VertexShaderCSO->Release();
     PixelShaderCSO->Release();
+
+    // 압축 정점: 위치(xyz)와 법선(w)은 16비트 정수 그대로, UV는 half로 읽음
+    D3DCompileFromFile(L"Shaders/StaticMeshVertexShader.hlsl", nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "mainVSCompact", "vs_5_0", 0, 0, &VertexShaderCSO, nullptr);
+    Graphics->Device->CreateVertexShader(VertexShaderCSO->GetBufferPointer(), VertexShaderCSO->GetBufferSize(), nullptr, &CompactVertexShader);
+
+    D3D11_INPUT_ELEMENT_DESC CompactLayout[] = {
+        {"POSITION", 0, DXGI_FORMAT_R16G16B16A16_UINT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+        {"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+    };
+
+    Graphics->Device->CreateInputLayout(
+        CompactLayout, ARRAYSIZE(CompactLayout), VertexShaderCSO->GetBufferPointer(), VertexShaderCSO->GetBufferSize(), &CompactInputLayout
+    );
+
+    VertexShaderCSO->Release();
 }
 
 void FRenderer::ReleaseShader()
@@ -263,6 +299,16 @@ void FRenderer::ReleaseShader()
         VertexShader->Release();
         VertexShader = nullptr;
     }
+    if (CompactInputLayout)
+    {
+        CompactInputLayout->Release();
+        CompactInputLayout = nullptr;
+    }
+    if (CompactVertexShader)
+    {
+        CompactVertexShader->Release();
+        CompactVertexShader = nullptr;
+    }
 }
 
 void FRenderer::PrepareShader() const
@@ -280,6 +326,13 @@ void FRenderer::PrepareShaderDeferred(ID3D11DeviceContext* Context) const
         Context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 }
 
+void FRenderer::PrepareVertexFormat(ID3D11DeviceContext* Context, EStaticMeshVertexFormat Format) const
+{
+    const bool bCompact = Format == EStaticMeshVertexFormat::Compact;
+    Context->VSSetShader(bCompact ? CompactVertexShader : VertexShader, nullptr, 0);
+    Context->IASetInputLayout(bCompact ? CompactInputLayout : InputLayout);
+}
+
 void FRenderer::ResetVertexShader() const
 {
     Graphics->DeviceContext->VSSetShader(nullptr, nullptr, 0);
@@ -356,8 +409,15 @@ void FRenderer::RenderPrimitive(ID3D11Buffer* pVertexBuffer, UINT numVertices, I
 
 void FRenderer::RenderPrimitive(OBJ::FStaticMeshRenderData* renderData, TArray<FStaticMaterial*> materials, TArray<UMaterial*> overrideMaterial, int selectedSubMeshIndex = -1) const
 {
+    // 압축 정점이면 호출한 쪽에서 GetDequantizeMatrix를 월드 행렬에 곱해 둬야 함
+    if (renderData->IsCompact())
+    {
+        PrepareVertexFormat(Graphics->DeviceContext, EStaticMeshVertexFormat::Compact);
+    }
+
     UINT offset = 0;
-    Graphics->DeviceContext->IASetVertexBuffers(0, 1, &renderData->VertexBuffer, &Stride, &offset);
+    const UINT VertexStride = renderData->GetVertexStride();
+    Graphics->DeviceContext->IASetVertexBuffers(0, 1, &renderData->VertexBuffer, &VertexStride, &offset);
 
     if (renderData->IndexBuffer)
         Graphics->DeviceContext->IASetIndexBuffer(renderData->IndexBuffer, DXGI_FORMAT_R32_UINT, 0);
@@ -365,7 +425,7 @@ void FRenderer::RenderPrimitive(OBJ::FStaticMeshRenderData* renderData, TArray<F
     if (renderData->MaterialSubsets.Num() == 0)
     {
         // no submesh
-        Graphics->DeviceContext->DrawIndexed(renderData->Indices.Num(), 0, 0);
+        Graphics->DeviceContext->DrawIndexed(renderData->GetNumIndices(), 0, 0);
     }
 
     for (int subMeshIndex = 0; subMeshIndex < renderData->MaterialSubsets.Num(); subMeshIndex++)
@@ -385,6 +445,11 @@ void FRenderer::RenderPrimitive(OBJ::FStaticMeshRenderData* renderData, TArray<F
             Graphics->DeviceContext->DrawIndexed(indexCount, startIndex, 0);
         }
     }
+
+    if (renderData->IsCompact())
+    {
+        PrepareVertexFormat(Graphics->DeviceContext, EStaticMeshVertexFormat::Full);
+    }
 }
 
 void FRenderer::RenderTexturedModelPrimitive(
@@ -410,7 +475,7 @@ void FRenderer::RenderTexturedModelPrimitive(
     Graphics->DeviceContext->DrawIndexed(numIndices, 0, 0);
 }
 
-ID3D11Buffer* FRenderer::CreateVertexBuffer(FVertexSimple* vertices, UINT byteWidth) const
+ID3D11Buffer* FRenderer::CreateVertexBuffer(const void* vertices, UINT byteWidth) const
 {
     // 2. Create a vertex buffer
     D3D11_BUFFER_DESC vertexbufferdesc = {};
@@ -450,7 +515,7 @@ ID3D11Buffer* FRenderer::CreateVertexBuffer(const TArray<FVertexSimple>& vertice
     return vertexBuffer;
 }
 
-ID3D11Buffer* FRenderer::CreateIndexBuffer(uint32* indices, UINT byteWidth) const
+ID3D11Buffer* FRenderer::CreateIndexBuffer(const uint32* indices, UINT byteWidth) const
 {
     D3D11_BUFFER_DESC indexbufferdesc = {};              // buffer�� ����, �뵵 ���� ����
     indexbufferdesc.Usage = D3D11_USAGE_IMMUTABLE;       // immutable: gpu�� �б� �������� ������ �� �ִ�.
@@ -1251,50 +1316,111 @@ void FRenderer::PrepareRender(bool bShouldUpdateRender)
     ClearRenderArr();
     
     Frustum Frustum = ActiveViewport->GetFrustum();
-    FOctreeNode* Octree = World->GetOctree();
 
-    TArray<UPrimitiveComponent*> Components;
-    Octree->FrustumCull(Frustum, Components);
+    AActor* SelectedActor = World->GetSelectedActor();
+    UTransformGizmo* GizmoActor = World->LocalGizmo;
+
+    FDrawView View;
+    View.CameraLocation = ActiveViewport->ViewTransformPerspective.GetLocation();
+    View.ScreenMultiple = 0.5f * FMath::Max(ActiveViewport->GetProjectionMatrix().M[0][0], ActiveViewport->GetProjectionMatrix().M[1][1]);
+    View.bPerspective = ActiveViewport->IsPerspective();
 
-    TSet<UPrimitiveComponent*> UniqueComponents;
-    for (const auto& Comp : Components) {
-        UniqueComponents.Add(Comp);
+    // 스레드별 버퍼를 만들어두고 매 프레임 재사용
+    const uint32 NumThreads = FJobSystem::GetNumThreads();
+    ThreadDrawKeys.SetNum(NumThreads);
+    ThreadDrawInstances.SetNum(NumThreads);
+    ThreadPendingComponents.SetNum(NumThreads);
+    ThreadLODStats.SetNum(NumThreads);
+    for (uint32 t = 0; t < NumThreads; ++t)
+    {
+        ThreadDrawKeys[t].Empty();
+        ThreadDrawInstances[t].Empty();
+        ThreadPendingComponents[t].Empty();
+        ThreadLODStats[t] = FLODStats();
     }
 
-    AActor* SelectedActor = World->GetSelectedActor();
-    UTransformGizmo* GizmoActor = World->LocalGizmo;
-    
-    for (const auto& Comp : UniqueComponents)
+    // 옥트리 서브트리를 워커가 나눠서 컬링하면서 바로 자기 스레드의 드로우 목록에 추가
+    World->FrustumCullParallel(Frustum, [&](int32 ThreadIndex, UPrimitiveComponent* Comp)
     {
-        if (GizmoActor->GetComponents().Contains(Comp))
+        if (Comp->GetOwner() == GizmoActor)
         {
             // 기즈모는 Frustum 컬링이 적용되지 않게 따로 관리할 예정이므로 여기에서는 건너뜀.
+            return;
         }
+
         // UGizmoBaseComponent가 UStaticMeshComponent를 상속받으므로, 정확히 구분하기 위함.
-        else if (UStaticMeshComponent* pStaticMeshComp = Cast<UStaticMeshComponent>(Comp))
+        UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(Comp);
+        if (!StaticMeshComp || !StaticMeshComp->GetStaticMesh())
+        {
+            return;
+        }
+
+        if (StaticMeshComp->GetStaticMesh()->DrawMeshId < 0)
+        {
+            ThreadPendingComponents[ThreadIndex].Add(StaticMeshComp);
+            return;
+        }
+        AddDrawCommands(StaticMeshComp, SelectedActor, View, ThreadDrawKeys[ThreadIndex], ThreadDrawInstances[ThreadIndex], ThreadLODStats[ThreadIndex]);
+    });
+
+    // 처음 보는 메시는 여기서 ID를 등록하고 메인 스레드(0번)의 버퍼에 추가
+    for (const TArray<UStaticMeshComponent*>& PendingComponents : ThreadPendingComponents)
+    {
+        for (UStaticMeshComponent* StaticMeshComp : PendingComponents)
         {
-            UStaticMesh* StaticMesh = pStaticMeshComp->GetStaticMesh();
-            if (!StaticMesh)
+            UStaticMesh* StaticMesh = StaticMeshComp->GetStaticMesh();
+            if (StaticMesh->DrawMeshId < 0)
             {
-                continue;
+                RegisterDrawMesh(StaticMesh);
             }
-            
-            int SubMeshIdx = 0;
-            
-            FMeshData Data;
-            Data.WorldMatrix = pStaticMeshComp->GetWorldMatrix();
-            Data.bIsSelected = SelectedActor == pStaticMeshComp->GetOwner();
-            
-            for (const FMaterialSubset& SubMesh : pStaticMeshComp->GetStaticMesh()->GetRenderData()->MaterialSubsets)
+            if (StaticMesh->DrawMeshId >= 0)
             {
-                UMaterial* Material = StaticMesh->GetMaterials()[SubMesh.MaterialIndex]->Material;
-                Data.IndexStart = SubMesh.IndexStart;
-                Data.IndexCount = SubMesh.IndexCount;
-                MaterialMeshMap[Material][StaticMesh].push_back(Data);
-                SubMeshIdx++;
+                AddDrawCommands(StaticMeshComp, SelectedActor, View, ThreadDrawKeys[0], ThreadDrawInstances[0], ThreadLODStats[0]);
             }
         }
     }
+
+    // 스레드별 결과를 이어붙이면서 키의 인스턴스 인덱스를 전체 배열 기준으로 옮김
+    uint32 TotalKeys = 0;
+    uint32 TotalInstances = 0;
+    LastLODStats = FLODStats();
+    for (uint32 t = 0; t < NumThreads; ++t)
+    {
+        TotalKeys += ThreadDrawKeys[t].Num();
+        TotalInstances += ThreadDrawInstances[t].Num();
+        for (uint32 LOD = 0; LOD < MaxDrawLODs; ++LOD)
+        {
+            LastLODStats.Meshes[LOD] += ThreadLODStats[t].Meshes[LOD];
+            LastLODStats.Triangles[LOD] += ThreadLODStats[t].Triangles[LOD];
+        }
+    }
+    // 전체 인스턴스 인덱스가 Instance 비트를 넘으면 Depth/SubMesh 비트로 올라가서 정렬이 깨짐
+    assert(TotalInstances <= (1u << FDrawKey::InstanceBits));
+    DrawKeys.SetNum(TotalKeys);
+    DrawInstances.SetNum(TotalInstances);
+
+    FJobSystem::ParallelFor(static_cast<int32>(NumThreads), [&](int32 Thread)
+    {
+        uint32 KeyOffset = 0;
+        uint32 InstanceOffset = 0;
+        for (int32 t = 0; t < Thread; ++t)
+        {
+            KeyOffset += ThreadDrawKeys[t].Num();
+            InstanceOffset += ThreadDrawInstances[t].Num();
+        }
+
+        // Instance가 키의 최하위 비트이므로 더하기만 하면 됨
+        const TArray<uint64>& Keys = ThreadDrawKeys[Thread];
+        for (int32 i = 0; i < Keys.Num(); ++i)
+        {
+            DrawKeys[KeyOffset + i] = Keys[i] + InstanceOffset;
+        }
+
+        const TArray<FDrawInstance>& Instances = ThreadDrawInstances[Thread];
+        std::copy(Instances.begin(), Instances.end(), DrawInstances.begin() + InstanceOffset);
+    });
+
+    FRadixSort::Sort(DrawKeys, DrawKeysScratch);
     
     if (SelectedActor)
     {
@@ -1347,14 +1473,9 @@ bool FRenderer::IsInsideFrustum(UStaticMeshComponent* StaticMeshComp) const
 void FRenderer::ClearRenderArr()
 {
     // SortedStaticMeshObjs.clear();
-    for (auto& [Material, DataMap] : MaterialMeshMap)
-    {
-        for (auto& [StaticMesh, DataArray] : DataMap)
-        {
-            // W04 - 이번 게임잼 특성상 사용되는 Material과 스태틱메시가 고정되어있으므로, 맵에서 Key를 삭제하지는 않음.
-            DataArray.clear();
-        }
-    }
+    // W04 - 용량은 유지되므로 다음 프레임에 다시 할당하지 않음
+    DrawKeys.Empty();
+    DrawInstances.Empty();
     GizmoObjs.Empty();
     //BillboardObjs.Empty();
     //LightObjs.Empty();
@@ -1392,41 +1513,18 @@ void FRenderer::RenderStaticMeshes()
     PrepareShader();
 
     ID3D11CommandList* CommandList[NUM_DEFERRED_CONTEXT];
-    for (auto& [Material, DataMap] : MaterialMeshMap)
-    {
-        // 이번에 사용하는 머티리얼을 GPU로 전달
-        UpdateMaterial(Material->GetMaterialInfo());
-        for (const auto& [StaticMesh, DataArray] : DataMap)
-        {
-            // Create a vector to store threads
-            TArray<std::thread> threads;
 
-            // Split the DataArray into chunks and process each chunk in a separate thread
-            size_t chunk_size = DataArray.size() / (NUM_DEFERRED_CONTEXT-1);  // Divide by number of hardware threads
-            
-            if (chunk_size < 512)
-            {
-                chunk_size = DataArray.size();
-            }
-            for (size_t i = 0; i < DataArray.size(); i += chunk_size)
-            {
-                // Calculate the end index of the chunk
-                size_t end = std::min(i + chunk_size, DataArray.size());
-
-                // Create a lambda that processes each chunk of FMeshData
-                size_t tid = i / chunk_size;
-                threads.Add(std::thread([this, &DataArray, i, end, tid, Material, StaticMesh, &CommandList]()
-                    {
-                    RenderStaticMeshesThread(DataArray, i, end, tid, Material, StaticMesh, CommandList[tid]);
-                    }));
-            }
-            // Wait for all threads to finish for the current StaticMesh
-            for (auto& t : threads)
-            {
-                t.join();
-            }
-        }
-    }
+    // 정렬된 키를 연속 구간으로 나눠 구간마다 deferred context 하나에 기록. 구간이 작으면 context를 덜 씀
+    const uint32 NumDraws = DrawKeys.Num();
+    const uint32 NumChunks = FMath::Clamp((NumDraws + MinDrawsPerContext - 1) / MinDrawsPerContext, 1u, static_cast<uint32>(NUM_DEFERRED_CONTEXT));
+    const uint32 ChunkSize = (NumDraws + NumChunks - 1) / NumChunks;
+
+    FJobSystem::ParallelFor(static_cast<int32>(NumChunks), [&](int32 tid)
+    {
+        const uint32 Begin = FMath::Min(tid * ChunkSize, NumDraws);
+        const uint32 End = FMath::Min(Begin + ChunkSize, NumDraws);
+        RenderStaticMeshesThread(Begin, End, tid);
+    });
 
     for (int i = 0; i < NUM_DEFERRED_CONTEXT; i++)
     {
@@ -1469,7 +1567,7 @@ void FRenderer::RenderGizmos()
             GizmoComp->GetWorldScale()
         );
         FVector4 UUIDColor = GizmoComp->EncodeUUID() / 255.0f;
-        FMatrix WorldMatrix = Model;
+        FMatrix WorldMatrix = renderData->GetDequantizeMatrix() * Model;
         UpdateConstant(WorldMatrix, UUIDColor, GizmoComp == World->GetPickingGizmo());
 
         RenderPrimitive(renderData, GizmoComp->GetStaticMesh()->GetMaterials(), GizmoComp->GetOverrideMaterials());
@@ -1525,45 +1623,68 @@ void FRenderer::RenderBillboards()
 }
 
 
-void FRenderer::RenderStaticMeshesThread(std::vector<FMeshData> DataArray, size_t i, size_t end, size_t tid,
-    UMaterial* Material, const UStaticMesh* StaticMesh, 
-    ID3D11CommandList* &CommandList)
+void FRenderer::RenderStaticMeshesThread(uint32 Begin, uint32 End, uint32 tid)
 {
+    if (Begin >= End)
     {
-        ID3D11DeviceContext* Context = Graphics->DeferredContexts[tid];
-        PrepareShaderDeferred(Context);
-        OBJ::FStaticMeshRenderData* RenderData = StaticMesh->GetRenderData();
-        UINT offset = 0;
-        // 버텍스 버퍼 업데이트
-        Context->IASetVertexBuffers(0, 1, &RenderData->VertexBuffer, &Stride, &offset);
-        if (RenderData->IndexBuffer)
-        {
-            Context->IASetIndexBuffer(RenderData->IndexBuffer, DXGI_FORMAT_R32_UINT, 0);
-        }
+        return;
+    }
 
-        Context->VSSetConstantBuffers(0, 1, &ConstantBuffer);
-        Context->VSSetConstantBuffers(5, 1, &ConstantBufferView);
-        Context->VSSetConstantBuffers(6, 1, &ConstantBufferProjection);
+    ID3D11DeviceContext* Context = Graphics->DeferredContexts[tid];
+    PrepareShaderDeferred(Context);
 
-        Context->PSSetConstantBuffers(0, 1, &ConstantBuffer);
-        Context->PSSetConstantBuffers(1, 1, &MaterialConstantBuffer);
+    Context->VSSetConstantBuffers(0, 1, &ConstantBuffer);
+    Context->VSSetConstantBuffers(5, 1, &ConstantBufferView);
+    Context->VSSetConstantBuffers(6, 1, &ConstantBufferProjection);
 
-        UpdateMaterialDeferred(Context, Material->GetMaterialInfo());
-        Context->RSSetViewports(1, &Graphics->Viewport);
-        Context->OMSetRenderTargets(1, &QuadRTV, Graphics->DepthStencilView);
+    Context->PSSetConstantBuffers(0, 1, &ConstantBuffer);
+    Context->PSSetConstantBuffers(1, 1, &MaterialConstantBuffer);
 
-        // Process each FMeshData in the chunk
-        for (size_t j = i; j < end; ++j)
+    Context->RSSetViewports(1, &Graphics->Viewport);
+    Context->OMSetRenderTargets(1, &QuadRTV, Graphics->DepthStencilView);
+
+    // 키가 머티리얼, 메시 순으로 정렬되어 있으므로 값이 바뀔 때만 상태를 바꿈
+    uint32 CurrentMaterialId = UINT32_MAX;
+    uint32 CurrentMeshId = UINT32_MAX;
+    EStaticMeshVertexFormat CurrentFormat = EStaticMeshVertexFormat::Full;
+    const OBJ::FStaticMeshRenderData* RenderData = nullptr;
+    for (uint32 i = Begin; i < End; ++i)
+    {
+        const uint64 Key = DrawKeys[i];
+
+        const uint32 MaterialId = FDrawKey::GetMaterialId(Key);
+        if (MaterialId != CurrentMaterialId)
         {
+            CurrentMaterialId = MaterialId;
+            UpdateMaterialDeferred(Context, DrawMaterials[MaterialId]->GetMaterialInfo());
+        }
 
-            const FMeshData& Data = DataArray[j];
-            FMatrix MVP = Data.WorldMatrix;
-            UpdateConstantDeferred(Context, MVP, FVector4(), Data.bIsSelected);
+        const uint32 MeshId = FDrawKey::GetMeshId(Key);
+        if (MeshId != CurrentMeshId)
+        {
+            CurrentMeshId = MeshId;
+            RenderData = DrawMeshes[MeshId]->GetRenderData();
 
-            // Draw
-            Context->DrawIndexed(Data.IndexCount, Data.IndexStart, 0);
+            if (RenderData->VertexFormat != CurrentFormat)
+            {
+                CurrentFormat = RenderData->VertexFormat;
+                PrepareVertexFormat(Context, CurrentFormat);
+            }
 
+            UINT offset = 0;
+            const UINT VertexStride = RenderData->GetVertexStride();
+            Context->IASetVertexBuffers(0, 1, &RenderData->VertexBuffer, &VertexStride, &offset);
+            if (RenderData->IndexBuffer)
+            {
+                Context->IASetIndexBuffer(RenderData->IndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+            }
         }
+
+        const FDrawInstance& Instance = DrawInstances[FDrawKey::GetInstance(Key)];
+        UpdateConstantDeferred(Context, Instance.WorldMatrix, FVector4(), Instance.bIsSelected);
+
+        const FMaterialSubset& Subset = RenderData->GetLODSubsets(FDrawKey::GetLOD(Key))[FDrawKey::GetSubMesh(Key)];
+        Context->DrawIndexed(Subset.IndexCount, Subset.IndexStart, 0);
     }
 }
 
@@ -22,6 +22,7 @@ class UBillboardComponent;
 class UStaticMeshComponent;
 class UGizmoBaseComponent;
 class UPrimitiveComponent;
+class AActor;
 class FOctreeNode;
 
 class FRenderer 
@@ -36,6 +37,10 @@ public:
     ID3D11InputLayout* InputLayout = nullptr;
     ID3D11Buffer* ConstantBuffer = nullptr;
 
+    /** FVertexCompact 정점용. 픽셀 셰이더는 같은 것을 씀 */
+    ID3D11VertexShader* CompactVertexShader = nullptr;
+    ID3D11InputLayout* CompactInputLayout = nullptr;
+
     ID3D11Buffer* ConstantBufferView = nullptr;
     ID3D11Buffer* ConstantBufferProjection = nullptr;
     
@@ -55,6 +60,9 @@ public:
    
     void PrepareShader() const;
     void PrepareShaderDeferred(ID3D11DeviceContext* Context) const;
+
+    /** 스태틱 메시 정점 형식에 맞는 버텍스 셰이더와 입력 레이아웃으로 바꿉니다. 픽셀 셰이더는 그대로 */
+    void PrepareVertexFormat(ID3D11DeviceContext* Context, EStaticMeshVertexFormat Format) const;
     
     //Render
     void RenderPrimitive(ID3D11Buffer* pBuffer, UINT numVertices) const;
@@ -81,9 +89,9 @@ public:
     void CreateConstantBuffer();
     void CreateLightingBuffer();
     void CreateLitUnlitBuffer();
-    ID3D11Buffer* CreateVertexBuffer(FVertexSimple* vertices, UINT byteWidth) const;
+    ID3D11Buffer* CreateVertexBuffer(const void* vertices, UINT byteWidth) const;
     ID3D11Buffer* CreateVertexBuffer(const TArray<FVertexSimple>& vertices, UINT byteWidth) const;
-    ID3D11Buffer* CreateIndexBuffer(uint32* indices, UINT byteWidth) const;
+    ID3D11Buffer* CreateIndexBuffer(const uint32* indices, UINT byteWidth) const;
     ID3D11Buffer* CreateIndexBuffer(const TArray<uint32>& indices, UINT byteWidth) const;
 
     // Setup
@@ -167,28 +175,126 @@ public: // line shader
     void RenderLight();
     void RenderBillboards();
 
+    /** LOD마다 직전 PrepareRender에서 그리기로 한 메시 수와 삼각형 수 */
+    struct FLODStats
+    {
+        uint32 Meshes[4] = {};
+        uint64 Triangles[4] = {};
+    };
+    FLODStats GetLastLODStats() const { return LastLODStats; }
+
     // world 생성시 batch용
 private:
     TArray<TArray<UStaticMeshComponent*>> AggregateMeshComponents(FOctreeNode* Octree, uint32 MaxAggregateNum);
 
 private:
-    struct FMeshData // 렌더러 내부에서만 사용하므로 여기에서 선언
+    /** 컴포넌트 하나의 그리기 정보. 같은 컴포넌트의 서브메시들이 공유함 */
+    struct FDrawInstance // 렌더러 내부에서만 사용하므로 여기에서 선언
     {
-        uint32 IndexStart;
-        uint32 IndexCount;
         FMatrix WorldMatrix;
         bool bIsSelected;
     };
 
     /**
-     * Key: 머티리얼
-     * Value: 해당 머티리얼을 사용하는 서브메시의 배열
+     * 드로우 하나를 나타내는 64비트 정렬 키. 상위 비트부터
+     * Material(10) | Mesh(14) | LOD(2) | SubMesh(8) | Depth(6) | Instance(24)
+     * 머티리얼 → 메시 → LOD → 서브메시 순으로 묶여서 같은 인덱스 구간을 그리는 드로우가 이어지고, 그 안에서는 가까운 것부터 그림
+     */
+    struct FDrawKey
+    {
+        static constexpr uint32 InstanceBits = 24;
+        static constexpr uint32 DepthBits = 6;
+        static constexpr uint32 SubMeshBits = 8;
+        static constexpr uint32 LODBits = 2;
+        static constexpr uint32 MeshBits = 14;
+        static constexpr uint32 MaterialBits = 10;
+
+        static constexpr uint32 DepthShift = InstanceBits;
+        static constexpr uint32 SubMeshShift = DepthShift + DepthBits;
+        static constexpr uint32 LODShift = SubMeshShift + SubMeshBits;
+        static constexpr uint32 MeshShift = LODShift + LODBits;
+        static constexpr uint32 MaterialShift = MeshShift + MeshBits;
+
+        static uint64 Make(uint32 MaterialId, uint32 MeshId, uint32 LOD, uint32 SubMesh, uint32 Depth, uint32 Instance)
+        {
+            return (static_cast<uint64>(MaterialId) << MaterialShift)
+                | (static_cast<uint64>(MeshId) << MeshShift)
+                | (static_cast<uint64>(LOD) << LODShift)
+                | (static_cast<uint64>(SubMesh) << SubMeshShift)
+                | (static_cast<uint64>(Depth) << DepthShift)
+                | Instance;
+        }
+
+        static uint32 GetMaterialId(uint64 Key) { return static_cast<uint32>(Key >> MaterialShift) & ((1u << MaterialBits) - 1); }
+        static uint32 GetMeshId(uint64 Key) { return static_cast<uint32>(Key >> MeshShift) & ((1u << MeshBits) - 1); }
+        static uint32 GetLOD(uint64 Key) { return static_cast<uint32>(Key >> LODShift) & ((1u << LODBits) - 1); }
+        static uint32 GetSubMesh(uint64 Key) { return static_cast<uint32>(Key >> SubMeshShift) & ((1u << SubMeshBits) - 1); }
+        static uint32 GetInstance(uint64 Key) { return static_cast<uint32>(Key) & ((1u << InstanceBits) - 1); }
+    };
+
+    /** 키에 담을 수 있는 LOD 수. 메시에 LOD가 더 있어도 여기까지만 씀 */
+    static constexpr uint32 MaxDrawLODs = 1u << FDrawKey::LODBits;
+
+    /** 한 프레임 동안 모든 컴포넌트가 같이 쓰는 카메라 정보 */
+    struct FDrawView
+    {
+        FVector CameraLocation;
+
+        /** 투영 행렬의 max(P[0][0], P[1][1]) / 2. 반지름 r인 구가 거리 d에서 화면 높이의 r * ScreenMultiple / d만큼 차지함 */
+        float ScreenMultiple;
+        bool bPerspective;
+    };
+
+    /**
+     * LOD i(i >= 1)로 내려가는 화면 크기. 화면 크기는 바운딩 구의 지름을 화면 높이로 나눈 값으로,
+     * LOD마다 삼각형이 절반이므로 화면 크기도 절반씩 줄임
      */
-    std::unordered_map<UMaterial*, std::unordered_map<UStaticMesh*, std::vector<FMeshData>>> MaterialMeshMap; 
-    void SortByMaterial(TArray<UPrimitiveComponent*> PrimComps);
-    std::unordered_map<UMaterial*, std::unordered_map<UStaticMesh*, std::vector<FRenderer::FMeshData>>>
-        SortByMaterialThread(TArray<UPrimitiveComponent*>& PrimComps,
-        uint32 start, uint32 end);
+    static constexpr float LODScreenSizes[MaxDrawLODs] = { 1.f, 0.4f, 0.2f, 0.1f };
+
+    /** 경계 근처에서 LOD가 매 프레임 바뀌지 않도록, 직전 LOD에서 벗어나려면 경계를 이 비율만큼 더 넘어야 함 */
+    static constexpr float LODHysteresis = 0.1f;
+
+    /** ScreenSize에 맞는 LOD를 고릅니다. 직전 LOD와 다르면 LODHysteresis만큼 경계를 넘었을 때만 바꿈 */
+    static uint32 SelectLOD(float ScreenSize, uint32 NumLODs, uint32 PreviousLOD);
+
+    FLODStats LastLODStats;
+
+    /** 머티리얼 ID → 머티리얼. 한 번 등록하면 지우지 않음 */
+    TArray<UMaterial*> DrawMaterials;
+
+    /** 메시 ID → 메시. ID는 UStaticMesh::DrawMeshId에도 저장되어 컬링 중에는 해시 없이 찾음 */
+    TArray<UStaticMesh*> DrawMeshes;
+
+    /** 이번 프레임의 정렬된 드로우 키와, 키가 가리키는 인스턴스 배열 */
+    TArray<uint64> DrawKeys;
+    TArray<FDrawInstance> DrawInstances;
+
+    /** 기수 정렬용 임시 버퍼 */
+    TArray<uint64> DrawKeysScratch;
+
+    /**
+     * [스레드] 병렬 컬링 중 스레드마다 따로 쌓는 버퍼. 매 프레임 비우기만 하고 메모리는 재사용.
+     * 키의 Instance는 스레드 안의 인덱스이고, 합칠 때 전체 배열 기준으로 옮김
+     */
+    TArray<TArray<uint64>> ThreadDrawKeys;
+    TArray<TArray<FDrawInstance>> ThreadDrawInstances;
+
+    /** [스레드] ID가 아직 없는 메시를 쓰는 컴포넌트. 컬링이 끝난 뒤 메인 스레드에서 등록하고 추가 */
+    TArray<TArray<UStaticMeshComponent*>> ThreadPendingComponents;
+    TArray<FLODStats> ThreadLODStats;
+
+    /** StaticMesh와 서브메시들의 머티리얼에 ID를 부여합니다. 키의 비트 수를 넘으면 등록하지 않음 */
+    void RegisterDrawMesh(UStaticMesh* StaticMesh);
+
+    /**
+     * StaticMeshComp의 LOD를 고르고 인스턴스 하나와 그 LOD의 서브메시마다 키 하나를 추가. 메시가 등록되어 있어야 함.
+     * 고른 LOD는 컴포넌트에 남겨서 다음 프레임의 히스테리시스에 씀
+     */
+    static void AddDrawCommands(UStaticMeshComponent* StaticMeshComp, const AActor* SelectedActor, const FDrawView& View,
+        TArray<uint64>& OutKeys, TArray<FDrawInstance>& OutInstances, FLODStats& OutStats);
+
+    /** deferred context 하나에 맡길 최소 드로우 수 */
+    static constexpr uint32 MinDrawsPerContext = 512;
 
     TArray<UGizmoBaseComponent*> GizmoObjs;
     TArray<UBillboardComponent*> BillboardObjs;
@@ -205,11 +311,8 @@ public:
 
 // thread
 private:
-    void RenderStaticMeshesThread(
-        std::vector<FMeshData> DataArray, 
-        size_t i, size_t end, size_t tid, 
-        UMaterial* Material, const UStaticMesh* StaticMesh,
-         ID3D11CommandList* &CommandList);
+    /** 정렬된 DrawKeys[Begin, End)를 tid번 deferred context에 기록합니다. */
+    void RenderStaticMeshesThread(uint32 Begin, uint32 End, uint32 tid);
 
 #pragma region quad
 private:
@@ -3,10 +3,24 @@
 
 #include "Container/String.h"
 
+/**
+ * 메모리 블록을 복사하지 않고 std::istream으로 읽기 위한 스트림 버퍼.
+ * 매핑된 파일 안의 가변 길이 데이터를 Serializer로 읽을 때 사용합니다.
+ */
+class FMemoryReadBuffer : public std::streambuf
+{
+public:
+    FMemoryReadBuffer(const void* Data, size_t Size)
+    {
+        char* Begin = const_cast<char*>(static_cast<const char*>(Data));
+        setg(Begin, Begin, Begin + Size);
+    }
+};
+
 struct Serializer
 {
     /* Write FString */
-    static void WriteFString(std::ofstream& Stream, const FString& InString)
+    static void WriteFString(std::ostream& Stream, const FString& InString)
     {
         uint32 Length = InString.Len();
         Stream.write(reinterpret_cast<const char*>(&Length), sizeof(Length));
@@ -14,7 +28,7 @@ struct Serializer
     }
 
     /* Read FString */
-    static void ReadFString(std::ifstream& Stream, FString& InString)
+    static void ReadFString(std::istream& Stream, FString& InString)
     {
         uint32 Length = 0;
         Stream.read(reinterpret_cast<char*>(&Length), sizeof(Length));
@@ -26,7 +40,7 @@ struct Serializer
     }
 
     /* Write FWString */
-    static void WriteFWString(std::ofstream& Stream, const FWString& InString)
+    static void WriteFWString(std::ostream& Stream, const FWString& InString)
     {
         uint32 Length = static_cast<uint32>(InString.length());
         Stream.write(reinterpret_cast<const char*>(&Length), sizeof(Length));
@@ -34,7 +48,7 @@ struct Serializer
     }
 
     /* Read FWString */
-    static void ReadFWString(std::ifstream& Stream, FWString& InString)
+    static void ReadFWString(std::istream& Stream, FWString& InString)
     {
         uint32 Length = 0;
         Stream.read(reinterpret_cast<char*>(&Length), sizeof(Length));
@@ -28,4 +28,27 @@ PS_INPUT mainVS(VS_INPUT input)
     output.texcoord = input.texcoord;
     
     return output;
-}
\ No newline at end of file
+}
+
+// FVertexCompact: 바운딩 박스 안의 16비트 정수 위치(w는 팔면체 법선)와 half UV
+struct VS_INPUT_COMPACT
+{
+    uint4 position : POSITION;
+    float2 texcoord : TEXCOORD;
+};
+
+PS_INPUT mainVSCompact(VS_INPUT_COMPACT input)
+{
+    PS_INPUT output;
+
+    // 역양자화(스케일, 바운딩 박스 최소점)는 C++에서 WorldMatrix 앞에 곱해 둠
+    output.position = mul(float4(input.position.xyz, 1.0f), WorldMatrix);
+    output.position = mul(output.position, ViewMatrix);
+    output.position = mul(output.position, ProjectionMatrix);
+
+    output.color = float4(0.0f, 0.0f, 0.0f, 1.0f);
+
+    output.texcoord = input.texcoord;
+
+    return output;
+}